@@ -0,0 +1,139 @@
+// Measures BASP connections on the loopback interface with and without the
+// shared memory transport. Runs a server node and a client node in this process
+// and compares the round-trip time for small messages as well as the
+// throughput for large messages.
+
+#include "caf/io/middleman.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/caf_main.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using namespace caf;
+
+using clock_type = std::chrono::steady_clock;
+
+// -- constants ----------------------------------------------------------------
+
+static constexpr size_t default_messages = 10'000;
+
+static constexpr size_t default_size = 64 * 1024;
+
+// -- configuration setup ------------------------------------------------------
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"} //
+      .add<size_t>("messages,m", "number of messages per run")
+      .add<size_t>("size,s", "payload size in bytes for the throughput runs");
+  }
+
+  settings dump_content() const override {
+    auto result = actor_system_config::dump_content();
+    put_missing(result, "messages", default_messages);
+    put_missing(result, "size", default_size);
+    return result;
+  }
+};
+
+// -- utility ------------------------------------------------------------------
+
+// Bundles an actor system with its configuration.
+struct node {
+  explicit node(bool enable_shared_memory) {
+    cfg.load<io::middleman>();
+    put(cfg.content, "caf.middleman.enable-shared-memory",
+        enable_shared_memory);
+    sys = std::make_unique<actor_system>(cfg);
+  }
+
+  actor_system_config cfg;
+  std::unique_ptr<actor_system> sys;
+};
+
+behavior bench_server() {
+  return {
+    [](int32_t x) { return x; },
+    [](const std::string&) {
+      // Drops the payload. The client only measures the throughput.
+    },
+    [](ok_atom) { return ok_atom_v; },
+  };
+}
+
+template <class Duration>
+void print_rate(actor_system& sys, const std::string& name, size_t total,
+                size_t bytes, Duration elapsed) {
+  using std::chrono::microseconds;
+  auto us = std::chrono::duration_cast<microseconds>(elapsed).count();
+  auto rate = us > 0 ? total * 1'000'000 / static_cast<size_t>(us) : 0;
+  auto mbps = us > 0 ? bytes / static_cast<size_t>(us) : 0;
+  sys.println("{}: {} ms, {} msgs/s, {} MB/s", name, us / 1000, rate, mbps);
+}
+
+// -- benchmarks ---------------------------------------------------------------
+
+void bench(actor_system& sys, const char* name, bool enable_shared_memory,
+           size_t messages, size_t size) {
+  node server{enable_shared_memory};
+  node client{enable_shared_memory};
+  auto port = server.sys->middleman().publish(
+    server.sys->spawn(bench_server), 0, "127.0.0.1");
+  if (!port) {
+    sys.println("*** {}: failed to publish: {}", name, port.error());
+    return;
+  }
+  auto hdl = client.sys->middleman().remote_actor("127.0.0.1", *port);
+  if (!hdl) {
+    sys.println("*** {}: failed to connect: {}", name, hdl.error());
+    return;
+  }
+  scoped_actor self{*client.sys};
+  auto on_error = [&sys, name](const error& err) {
+    sys.println("*** {}: {}", name, err);
+  };
+  // Let both nodes settle on the transport before measuring.
+  self->mail(ok_atom_v)
+    .request(*hdl, infinite)
+    .receive([](ok_atom) {}, on_error);
+  // Small messages: one request at a time.
+  auto start = clock_type::now();
+  for (size_t i = 0; i < messages; ++i)
+    self->mail(static_cast<int32_t>(i))
+      .request(*hdl, infinite)
+      .receive([](int32_t) {}, on_error);
+  print_rate(sys, std::string{name} + " (round trips)", messages,
+             messages * sizeof(int32_t), clock_type::now() - start);
+  // Large messages: send all messages and wait for the server to catch up.
+  auto payload = std::string(size, 'x');
+  start = clock_type::now();
+  for (size_t i = 0; i < messages; ++i)
+    self->mail(payload).send(*hdl);
+  self->mail(ok_atom_v)
+    .request(*hdl, infinite)
+    .receive([](ok_atom) {}, on_error);
+  print_rate(sys, std::string{name} + " (throughput)", messages,
+             messages * size, clock_type::now() - start);
+  self->send_exit(*hdl, exit_reason::user_shutdown);
+}
+
+int caf_main(actor_system& sys, const config& cfg) {
+  auto messages = get_or(cfg, "messages", default_messages);
+  auto size = get_or(cfg, "size", default_size);
+  if (messages == 0 || size == 0) {
+    sys.println("*** messages and size must be greater than 0");
+    return EXIT_FAILURE;
+  }
+  bench(sys, "tcp", false, messages, size);
+  bench(sys, "shared memory", true, messages, size);
+  return EXIT_SUCCESS;
+}
+
+CAF_MAIN(io::middleman)
@@ -0,0 +1,98 @@
+// Measures how fast multiple threads can enqueue messages to the same mailbox.
+// Compares the default mailbox with and without the size hint, which requires
+// senders to update a shared counter for each message.
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/caf_main.hpp"
+#include "caf/detail/default_mailbox.hpp"
+#include "caf/error.hpp"
+#include "caf/mailbox_element.hpp"
+#include "caf/message_id.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using clock_type = std::chrono::steady_clock;
+
+// -- constants ----------------------------------------------------------------
+
+static constexpr size_t default_threads = 4;
+
+static constexpr size_t default_iterations = 1'000'000;
+
+// -- configuration setup ------------------------------------------------------
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"} //
+      .add<size_t>("threads,t", "number of threads that send messages")
+      .add<size_t>("iterations,i", "number of messages per thread");
+  }
+
+  settings dump_content() const override {
+    auto result = actor_system_config::dump_content();
+    put_missing(result, "threads", default_threads);
+    put_missing(result, "iterations", default_iterations);
+    return result;
+  }
+};
+
+// -- utility ------------------------------------------------------------------
+
+template <class Duration>
+void print_rate(actor_system& sys, const char* name, size_t total,
+                Duration elapsed) {
+  using std::chrono::microseconds;
+  auto us = std::chrono::duration_cast<microseconds>(elapsed).count();
+  auto rate = us > 0 ? total * 1'000'000 / static_cast<size_t>(us) : 0;
+  sys.println("{}: {} ms, {} ops/s", name, us / 1000, rate);
+}
+
+// -- benchmarks ---------------------------------------------------------------
+
+void bench_enqueue(actor_system& sys, const char* name, bool size_hint,
+                   size_t threads, size_t iterations) {
+  detail::default_mailbox mbox;
+  if (size_hint)
+    mbox.enable_size_hint();
+  // Allocate all messages upfront to only measure the enqueue operation.
+  std::vector<std::vector<mailbox_element_ptr>> inputs(threads);
+  for (auto& input : inputs) {
+    input.reserve(iterations);
+    for (size_t i = 0; i < iterations; ++i)
+      input.emplace_back(make_mailbox_element(nullptr, make_message_id(),
+                                              make_message(int32_t{1})));
+  }
+  std::vector<std::thread> workers;
+  auto start = clock_type::now();
+  for (auto& input : inputs)
+    workers.emplace_back([&mbox, &input] {
+      for (auto& ptr : input)
+        mbox.push_back(std::move(ptr));
+    });
+  for (auto& hdl : workers)
+    hdl.join();
+  auto elapsed = clock_type::now() - start;
+  print_rate(sys, name, threads * iterations, elapsed);
+  mbox.close(error{});
+}
+
+int caf_main(actor_system& sys, const config& cfg) {
+  auto threads = get_or(cfg, "threads", default_threads);
+  auto iterations = get_or(cfg, "iterations", default_iterations);
+  if (threads == 0 || iterations == 0) {
+    sys.println("*** threads and iterations must be greater than 0");
+    return EXIT_FAILURE;
+  }
+  bench_enqueue(sys, "enqueue (without size hint)", false, threads,
+                iterations);
+  bench_enqueue(sys, "enqueue (with size hint)", true, threads, iterations);
+  return EXIT_SUCCESS;
+}
+
+CAF_MAIN()
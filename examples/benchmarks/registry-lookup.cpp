@@ -0,0 +1,184 @@
+// Measures the throughput of actor name lookups with several reader threads
+// while a writer keeps updating the registry. Compares the registry of the
+// actor system with a map that readers access under a shared mutex, i.e., how
+// the registry used to synchronize lookups.
+
+#include "caf/actor.hpp"
+#include "caf/actor_registry.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/caf_main.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/send.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace caf;
+
+using clock_type = std::chrono::steady_clock;
+
+// -- constants ----------------------------------------------------------------
+
+static constexpr size_t default_readers = 4;
+
+static constexpr size_t default_lookups = 1'000'000;
+
+static constexpr size_t default_names = 16;
+
+// Pause between two updates of the writer.
+static constexpr auto write_interval = std::chrono::microseconds{100};
+
+// -- configuration setup ------------------------------------------------------
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"} //
+      .add<size_t>("readers,r", "number of reader threads")
+      .add<size_t>("lookups,l", "number of lookups per reader")
+      .add<size_t>("names,n", "number of registered names");
+  }
+
+  settings dump_content() const override {
+    auto result = actor_system_config::dump_content();
+    put_missing(result, "readers", default_readers);
+    put_missing(result, "lookups", default_lookups);
+    put_missing(result, "names", default_names);
+    return result;
+  }
+};
+
+// -- baseline -----------------------------------------------------------------
+
+// Mimics the previous implementation of the registry.
+class locked_registry {
+public:
+  void put(const std::string& key, strong_actor_ptr value) {
+    std::unique_lock guard{mtx_};
+    entries_[key] = std::move(value);
+  }
+
+  void erase(const std::string& key) {
+    std::unique_lock guard{mtx_};
+    entries_.erase(key);
+  }
+
+  strong_actor_ptr get(const std::string& key) const {
+    std::shared_lock guard{mtx_};
+    if (auto i = entries_.find(key); i != entries_.end())
+      return i->second;
+    return nullptr;
+  }
+
+private:
+  mutable std::shared_mutex mtx_;
+  std::unordered_map<std::string, strong_actor_ptr> entries_;
+};
+
+// Adapts the registry of the actor system to the interface of the baseline.
+class system_registry {
+public:
+  explicit system_registry(actor_registry& reg) : reg_(&reg) {
+    // nop
+  }
+
+  void put(const std::string& key, strong_actor_ptr value) {
+    reg_->put(key, std::move(value));
+  }
+
+  void erase(const std::string& key) {
+    reg_->erase(key);
+  }
+
+  strong_actor_ptr get(const std::string& key) const {
+    return reg_->get(key);
+  }
+
+private:
+  actor_registry* reg_;
+};
+
+// -- benchmark ----------------------------------------------------------------
+
+struct workload {
+  size_t readers;
+  size_t lookups;
+  std::vector<std::string> names;
+};
+
+template <class Registry>
+void run(actor_system& sys, const char* name, Registry& reg,
+         const workload& wl, const actor& hdl) {
+  for (auto& key : wl.names)
+    reg.put(key, actor_cast<strong_actor_ptr>(hdl));
+  std::atomic<bool> done = false;
+  std::atomic<size_t> misses = 0;
+  // The writer keeps replacing an unrelated entry until all readers are done.
+  size_t updates = 0;
+  std::thread writer{[&] {
+    while (!done.load()) {
+      reg.put("benchmark-writer", actor_cast<strong_actor_ptr>(hdl));
+      reg.erase("benchmark-writer");
+      ++updates;
+      std::this_thread::sleep_for(write_interval);
+    }
+  }};
+  std::vector<std::thread> readers;
+  auto start = clock_type::now();
+  for (size_t i = 0; i < wl.readers; ++i)
+    readers.emplace_back([&reg, &wl, &misses, i] {
+      size_t local_misses = 0;
+      for (size_t j = 0; j < wl.lookups; ++j)
+        if (reg.get(wl.names[(i + j) % wl.names.size()]) == nullptr)
+          ++local_misses;
+      misses += local_misses;
+    });
+  for (auto& reader : readers)
+    reader.join();
+  auto elapsed = clock_type::now() - start;
+  done = true;
+  writer.join();
+  for (auto& key : wl.names)
+    reg.erase(key);
+  using std::chrono::microseconds;
+  auto us = std::chrono::duration_cast<microseconds>(elapsed).count();
+  auto total = wl.readers * wl.lookups;
+  auto rate = us > 0 ? total * 1'000'000 / static_cast<size_t>(us) : 0;
+  sys.println("{}: {} ms, {} lookups/s, {} updates, {} misses", name,
+              us / 1000, rate, updates, misses.load());
+}
+
+int caf_main(actor_system& sys, const config& cfg) {
+  workload wl;
+  wl.readers = get_or(cfg, "readers", default_readers);
+  wl.lookups = get_or(cfg, "lookups", default_lookups);
+  auto names = get_or(cfg, "names", default_names);
+  if (wl.readers == 0 || wl.lookups == 0 || names == 0) {
+    sys.println("*** readers, lookups and names must be greater than 0");
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < names; ++i)
+    wl.names.emplace_back("benchmark-" + std::to_string(i));
+  auto hdl = sys.spawn([]() -> behavior {
+    return {
+      [](int) {
+        // nop
+      },
+    };
+  });
+  locked_registry baseline;
+  run(sys, "shared mutex", baseline, wl, hdl);
+  system_registry reg{sys.registry()};
+  run(sys, "actor registry", reg, wl, hdl);
+  anon_send_exit(hdl, exit_reason::user_shutdown);
+  return EXIT_SUCCESS;
+}
+
+CAF_MAIN()
@@ -0,0 +1,122 @@
+// Measures how fast multiple threads can spawn and terminate actors. The first
+// part compares the storage pool for actors with and without thread caches,
+// i.e., with a single free list that every allocation locks. The second part
+// measures the spawn rate of the actor system as a whole.
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/caf_main.hpp"
+#include "caf/detail/actor_storage_pool.hpp"
+#include "caf/event_based_actor.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using clock_type = std::chrono::steady_clock;
+
+using pool_type = detail::actor_storage_pool;
+
+// -- constants ----------------------------------------------------------------
+
+static constexpr size_t default_threads = 4;
+
+static constexpr size_t default_iterations = 100'000;
+
+// Number of blocks each thread allocates before releasing them again. This
+// mimics a burst of spawned actors that terminate shortly after.
+static constexpr size_t burst_size = 32;
+
+// Roughly the size of a small event-based actor.
+static constexpr size_t block_size = 512;
+
+// -- configuration setup ------------------------------------------------------
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"} //
+      .add<size_t>("threads,t", "number of threads that spawn actors")
+      .add<size_t>("iterations,i", "number of actors per thread");
+  }
+
+  settings dump_content() const override {
+    auto result = actor_system_config::dump_content();
+    put_missing(result, "threads", default_threads);
+    put_missing(result, "iterations", default_iterations);
+    return result;
+  }
+};
+
+// -- utility ------------------------------------------------------------------
+
+// Runs `fn` on `threads` threads in parallel and returns the elapsed time.
+template <class F>
+auto run_parallel(size_t threads, F fn) {
+  std::vector<std::thread> workers;
+  auto start = clock_type::now();
+  for (size_t i = 0; i < threads; ++i)
+    workers.emplace_back(fn);
+  for (auto& hdl : workers)
+    hdl.join();
+  return clock_type::now() - start;
+}
+
+template <class Duration>
+void print_rate(actor_system& sys, const char* name, size_t total,
+                Duration elapsed) {
+  using std::chrono::microseconds;
+  auto us = std::chrono::duration_cast<microseconds>(elapsed).count();
+  auto rate = us > 0 ? total * 1'000'000 / static_cast<size_t>(us) : 0;
+  sys.println("{}: {} ms, {} ops/s", name, us / 1000, rate);
+}
+
+// -- benchmarks ---------------------------------------------------------------
+
+void bench_pool(actor_system& sys, const char* name, size_t thread_cache_size,
+                size_t threads, size_t iterations) {
+  pool_type pool{block_size, alignof(std::max_align_t),
+                 pool_type::default_max_cached, thread_cache_size};
+  auto elapsed = run_parallel(threads, [&pool, iterations] {
+    std::vector<void*> blocks;
+    blocks.reserve(burst_size);
+    for (size_t i = 0; i < iterations; i += burst_size) {
+      for (size_t j = 0; j < burst_size; ++j)
+        blocks.push_back(pool.allocate());
+      for (auto* ptr : blocks)
+        pool.deallocate(ptr);
+      blocks.clear();
+    }
+  });
+  print_rate(sys, name, threads * iterations, elapsed);
+}
+
+void bench_spawn(actor_system& sys, size_t threads, size_t iterations) {
+  auto elapsed = run_parallel(threads, [&sys, iterations] {
+    for (size_t i = 0; i < iterations; ++i)
+      sys.spawn([](event_based_actor*) {
+        // Terminates immediately, because it has no behavior.
+      });
+  });
+  sys.await_all_actors_done();
+  print_rate(sys, "spawn", threads * iterations, elapsed);
+}
+
+int caf_main(actor_system& sys, const config& cfg) {
+  auto threads = get_or(cfg, "threads", default_threads);
+  auto iterations = get_or(cfg, "iterations", default_iterations);
+  if (threads == 0 || iterations == 0) {
+    sys.println("*** threads and iterations must be greater than 0");
+    return EXIT_FAILURE;
+  }
+  bench_pool(sys, "pool (shared free list only)", 0, threads, iterations);
+  bench_pool(sys, "pool (with thread caches)",
+             pool_type::default_thread_cache_size, threads, iterations);
+  bench_spawn(sys, threads, iterations);
+  return EXIT_SUCCESS;
+}
+
+CAF_MAIN()
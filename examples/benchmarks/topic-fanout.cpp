@@ -0,0 +1,116 @@
+// Measures how fast a single publisher can deliver updates to many local
+// subscribers. Compares one send per subscriber with publishing to a topic,
+// which allocates the message content only once for all subscribers.
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/anon_mail.hpp"
+#include "caf/caf_main.hpp"
+#include "caf/detail/latch.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/local_topic.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace caf;
+
+using clock_type = std::chrono::steady_clock;
+
+// -- constants ----------------------------------------------------------------
+
+static constexpr size_t default_subscribers = 5'000;
+
+static constexpr size_t default_updates = 100;
+
+// -- configuration setup ------------------------------------------------------
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"} //
+      .add<size_t>("subscribers,s", "number of subscribers")
+      .add<size_t>("updates,u", "number of updates to each subscriber");
+  }
+
+  settings dump_content() const override {
+    auto result = actor_system_config::dump_content();
+    put_missing(result, "subscribers", default_subscribers);
+    put_missing(result, "updates", default_updates);
+    return result;
+  }
+};
+
+// -- utility ------------------------------------------------------------------
+
+template <class Duration>
+void print_rate(actor_system& sys, const char* name, size_t total,
+                Duration elapsed) {
+  using std::chrono::microseconds;
+  auto us = std::chrono::duration_cast<microseconds>(elapsed).count();
+  auto rate = us > 0 ? total * 1'000'000 / static_cast<size_t>(us) : 0;
+  sys.println("{}: {} ms, {} msgs/s", name, us / 1000, rate);
+}
+
+// Spawns subscribers that count down `done` for each update.
+std::vector<actor> spawn_subscribers(actor_system& sys, size_t n,
+                                     std::shared_ptr<detail::latch> done) {
+  std::vector<actor> result;
+  result.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    result.push_back(sys.spawn([done]() -> behavior {
+      return {
+        [done](const std::string&, double) { done->count_down(); },
+      };
+    }));
+  return result;
+}
+
+// -- benchmarks ---------------------------------------------------------------
+
+// Runs `updates` rounds, each delivering a single update to all subscribers.
+// The factory receives the subscribers and returns a function object that
+// delivers a single update.
+template <class Factory>
+void bench_fanout(actor_system& sys, const char* name, size_t subscribers,
+                  size_t updates, Factory make_publisher) {
+  auto total = subscribers * updates;
+  auto done = std::make_shared<detail::latch>(static_cast<ptrdiff_t>(total));
+  auto publish = make_publisher(spawn_subscribers(sys, subscribers, done));
+  auto start = clock_type::now();
+  for (size_t i = 0; i < updates; ++i)
+    publish(std::string{"ACME"}, static_cast<double>(i));
+  done->wait();
+  print_rate(sys, name, total, clock_type::now() - start);
+}
+
+int caf_main(actor_system& sys, const config& cfg) {
+  auto subscribers = get_or(cfg, "subscribers", default_subscribers);
+  auto updates = get_or(cfg, "updates", default_updates);
+  if (subscribers == 0 || updates == 0) {
+    sys.println("*** subscribers and updates must be greater than 0");
+    return EXIT_FAILURE;
+  }
+  bench_fanout(sys, "one send per subscriber", subscribers, updates,
+               [](std::vector<actor> subs) {
+                 return [subs](const std::string& symbol, double price) {
+                   for (auto& sub : subs)
+                     anon_mail(symbol, price).send(sub);
+                 };
+               });
+  bench_fanout(sys, "publish to topic", subscribers, updates,
+               [](std::vector<actor> subs) {
+                 auto topic = make_local_topic();
+                 for (auto& sub : subs)
+                   topic->subscribe(sub);
+                 // The topic only holds weak references to its subscribers.
+                 return [topic, subs](std::string symbol, double price) {
+                   topic->publish(make_message(std::move(symbol), price));
+                 };
+               });
+  return EXIT_SUCCESS;
+}
+
+CAF_MAIN()
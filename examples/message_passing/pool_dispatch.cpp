@@ -0,0 +1,155 @@
+// Compares the dispatching policies of actor pools on a skewed workload. Most
+// tasks are cheap, but every n-th task takes much longer. Load-aware policies
+// avoid workers that are busy with an expensive task, which shows in the tail
+// latency.
+
+#include "caf/actor_pool.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/caf_main.hpp"
+#include "caf/config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace caf;
+
+using clock_type = std::chrono::steady_clock;
+
+// -- constants ----------------------------------------------------------------
+
+static constexpr size_t default_tasks = 10'000;
+
+static constexpr size_t default_workers = 4;
+
+static constexpr size_t default_heavy_every = 20;
+
+static constexpr int64_t default_light_cost = 10;
+
+static constexpr int64_t default_heavy_cost = 1'000;
+
+// -- configuration setup ------------------------------------------------------
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"} //
+      .add<size_t>("tasks,t", "number of tasks per policy")
+      .add<size_t>("workers,w", "number of workers per pool")
+      .add<size_t>("heavy-every,e", "makes every n-th task expensive")
+      .add<int64_t>("light-cost", "cost of regular tasks in microseconds")
+      .add<int64_t>("heavy-cost", "cost of expensive tasks in microseconds");
+  }
+
+  settings dump_content() const override {
+    auto result = actor_system_config::dump_content();
+    put_missing(result, "tasks", default_tasks);
+    put_missing(result, "workers", default_workers);
+    put_missing(result, "heavy-every", default_heavy_every);
+    put_missing(result, "light-cost", default_light_cost);
+    put_missing(result, "heavy-cost", default_heavy_cost);
+    return result;
+  }
+};
+
+struct workload {
+  size_t tasks;
+  size_t workers;
+  size_t heavy_every;
+  int64_t light_cost;
+  int64_t heavy_cost;
+
+  int64_t cost_of(size_t task) const {
+    if (heavy_every > 0 && (task + 1) % heavy_every == 0)
+      return heavy_cost;
+    return light_cost;
+  }
+};
+
+// -- actors -------------------------------------------------------------------
+
+// Spins for `cost` microseconds to simulate CPU-bound work.
+behavior worker() {
+  return {
+    [](int64_t cost, int64_t task) {
+      auto until = clock_type::now() + std::chrono::microseconds{cost};
+      while (clock_type::now() < until) {
+        // nop
+      }
+      return task;
+    },
+  };
+}
+
+// -- benchmark ----------------------------------------------------------------
+
+CAF_PUSH_DEPRECATED_WARNING
+
+// Keeps two tasks per worker in flight and measures the time between sending
+// a task to the pool and receiving the result.
+void run(actor_system& sys, const char* name, actor_pool::policy pol,
+         const workload& wl) {
+  scoped_actor self{sys};
+  auto pool = actor_pool::make(
+    sys, wl.workers, [&sys] { return sys.spawn(worker); }, std::move(pol));
+  std::vector<clock_type::time_point> sent(wl.tasks);
+  std::vector<int64_t> latencies;
+  latencies.reserve(wl.tasks);
+  size_t next = 0;
+  auto send_next = [&] {
+    sent[next] = clock_type::now();
+    self->mail(wl.cost_of(next), static_cast<int64_t>(next)).send(pool);
+    ++next;
+  };
+  auto start = clock_type::now();
+  auto window = std::min(wl.tasks, 2 * wl.workers);
+  for (size_t i = 0; i < window; ++i)
+    send_next();
+  size_t received = 0;
+  self->receive_for(received, wl.tasks)([&](int64_t task) {
+    auto elapsed = clock_type::now() - sent[static_cast<size_t>(task)];
+    using std::chrono::microseconds;
+    latencies.push_back(
+      std::chrono::duration_cast<microseconds>(elapsed).count());
+    if (next < wl.tasks)
+      send_next();
+  });
+  auto total = clock_type::now() - start;
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    auto index = static_cast<size_t>(p * (latencies.size() - 1));
+    return latencies[index];
+  };
+  using std::chrono::milliseconds;
+  sys.println("{}: total = {} ms, p50 = {} us, p99 = {} us", name,
+              std::chrono::duration_cast<milliseconds>(total).count(),
+              percentile(0.5), percentile(0.99));
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
+CAF_POP_WARNINGS
+
+int caf_main(actor_system& sys, const config& cfg) {
+  workload wl;
+  wl.tasks = get_or(cfg, "tasks", default_tasks);
+  wl.workers = get_or(cfg, "workers", default_workers);
+  wl.heavy_every = get_or(cfg, "heavy-every", default_heavy_every);
+  wl.light_cost = get_or(cfg, "light-cost", default_light_cost);
+  wl.heavy_cost = get_or(cfg, "heavy-cost", default_heavy_cost);
+  if (wl.tasks == 0 || wl.workers == 0) {
+    sys.println("*** tasks and workers must be greater than 0");
+    return EXIT_FAILURE;
+  }
+  run(sys, "round-robin", actor_pool::round_robin(), wl);
+  run(sys, "random", actor_pool::random(), wl);
+  run(sys, "least-loaded", actor_pool::least_loaded(), wl);
+  run(sys, "power-of-two-choices", actor_pool::power_of_two_choices(), wl);
+  return EXIT_SUCCESS;
+}
+
+CAF_MAIN()
@@ -0,0 +1,223 @@
+// Measures the throughput of the SSL transport by sending data over a loopback
+// connection. Passing `--tls.ktls` enables kernel TLS offloading (on Linux with
+// OpenSSL 3 and the `tls` kernel module), which allows comparing both paths.
+
+#include "caf/net/middleman.hpp"
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/octet_stream/lower_layer.hpp"
+#include "caf/net/octet_stream/upper_layer.hpp"
+#include "caf/net/receive_policy.hpp"
+#include "caf/net/socket_manager.hpp"
+#include "caf/net/ssl/context.hpp"
+#include "caf/net/ssl/transport.hpp"
+#include "caf/net/tcp_accept_socket.hpp"
+#include "caf/net/tcp_stream_socket.hpp"
+
+#include "caf/caf_main.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <string>
+
+namespace ssl = caf::net::ssl;
+
+// -- constants ----------------------------------------------------------------
+
+static constexpr size_t default_megabytes = 1024;
+
+static constexpr size_t chunk_size = 64 * 1024;
+
+// -- configuration setup ------------------------------------------------------
+
+struct config : caf::actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"} //
+      .add<size_t>("megabytes,m", "number of MiB to transfer");
+    opt_group{custom_options_, "tls"} //
+      .add<std::string>("key-file,k", "path to the private key file")
+      .add<std::string>("cert-file,c", "path to the certificate file")
+      .add<bool>("ktls", "enables kernel TLS offloading");
+  }
+
+  caf::settings dump_content() const override {
+    auto result = actor_system_config::dump_content();
+    caf::put_missing(result, "megabytes", default_megabytes);
+    return result;
+  }
+};
+
+// -- protocol layers ----------------------------------------------------------
+
+// Writes `total` bytes to the connection.
+class source : public caf::net::octet_stream::upper_layer {
+public:
+  explicit source(size_t total) : total_(total) {
+    // nop
+  }
+
+  caf::error start(caf::net::octet_stream::lower_layer* down) override {
+    down_ = down;
+    down_->configure_read(caf::net::receive_policy::stop());
+    down_->write_later();
+    return caf::none;
+  }
+
+  void abort(const caf::error&) override {
+    // nop
+  }
+
+  ptrdiff_t consume(caf::byte_span buffer, caf::byte_span) override {
+    return static_cast<ptrdiff_t>(buffer.size());
+  }
+
+  void prepare_send() override {
+    while (sent_ < total_ && down_->can_send_more()) {
+      auto n = std::min(chunk_size, total_ - sent_);
+      down_->begin_output();
+      auto& buf = down_->output_buffer();
+      buf.resize(buf.size() + n, std::byte{'x'});
+      down_->end_output();
+      sent_ += n;
+    }
+  }
+
+  bool done_sending() override {
+    return sent_ == total_;
+  }
+
+private:
+  caf::net::octet_stream::lower_layer* down_ = nullptr;
+  size_t total_;
+  size_t sent_ = 0;
+};
+
+// Reads `total` bytes from the connection and then fulfills the promise with
+// `true`. Fulfills the promise with `false` if the connection breaks early.
+class sink : public caf::net::octet_stream::upper_layer {
+public:
+  sink(size_t total, std::promise<bool> done)
+    : total_(total), done_(std::move(done)) {
+    // nop
+  }
+
+  caf::error start(caf::net::octet_stream::lower_layer* down) override {
+    down->configure_read(caf::net::receive_policy::up_to(chunk_size));
+    return caf::none;
+  }
+
+  void abort(const caf::error&) override {
+    if (received_ < total_) {
+      received_ = total_;
+      done_.set_value(false);
+    }
+  }
+
+  ptrdiff_t consume(caf::byte_span buffer, caf::byte_span) override {
+    if (received_ < total_) {
+      received_ += buffer.size();
+      if (received_ >= total_)
+        done_.set_value(true);
+    }
+    return static_cast<ptrdiff_t>(buffer.size());
+  }
+
+  void prepare_send() override {
+    // nop
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+private:
+  size_t total_;
+  size_t received_ = 0;
+  std::promise<bool> done_;
+};
+
+// -- main ---------------------------------------------------------------------
+
+int caf_main(caf::actor_system& sys, const config& cfg) {
+  using namespace caf::net;
+  // Read the configuration.
+  auto pem = ssl::format::pem;
+  auto key_file = caf::get_as<std::string>(cfg, "tls.key-file");
+  auto cert_file = caf::get_as<std::string>(cfg, "tls.cert-file");
+  auto use_ktls = caf::get_or(cfg, "tls.ktls", false);
+  auto total = caf::get_or(cfg, "megabytes", default_megabytes) * 1024 * 1024;
+  if (!key_file || !cert_file) {
+    sys.println("*** mandatory arguments missing: key-file and cert-file");
+    return EXIT_FAILURE;
+  }
+  auto with_ktls = [&sys, use_ktls](ssl::context ctx)
+    -> caf::expected<ssl::context> {
+    if (use_ktls && !ctx.enable_ktls())
+      sys.println("*** OpenSSL does not support kTLS on this platform");
+    return ctx;
+  };
+  // Create the SSL contexts.
+  auto server_ctx = ssl::emplace_server(ssl::tls::v1_2)()
+                      .and_then(ssl::use_private_key_file(key_file, pem))
+                      .and_then(ssl::use_certificate_file(cert_file, pem))
+                      .and_then(with_ktls);
+  auto client_ctx = ssl::emplace_client(ssl::tls::v1_2)().and_then(with_ktls);
+  if (!server_ctx || !client_ctx) {
+    sys.println("*** failed to create the SSL contexts: {}",
+                server_ctx ? client_ctx.error() : server_ctx.error());
+    return EXIT_FAILURE;
+  }
+  // Connect over loopback.
+  auto acceptor = make_tcp_accept_socket(0, "127.0.0.1");
+  if (!acceptor) {
+    sys.println("*** failed to open an accept socket: {}", acceptor.error());
+    return EXIT_FAILURE;
+  }
+  auto port = local_port(*acceptor);
+  auto client_fd = make_connected_tcp_stream_socket("127.0.0.1", *port);
+  auto server_fd = accept(*acceptor);
+  close(*acceptor);
+  if (!client_fd || !server_fd) {
+    sys.println("*** failed to connect over loopback");
+    return EXIT_FAILURE;
+  }
+  if (nonblocking(*client_fd, true) || nonblocking(*server_fd, true)) {
+    sys.println("*** failed to set the sockets to nonblocking mode");
+    return EXIT_FAILURE;
+  }
+  auto server_conn = server_ctx->new_connection(*server_fd,
+                                                ssl::close_on_shutdown);
+  auto client_conn = client_ctx->new_connection(*client_fd,
+                                                ssl::close_on_shutdown);
+  if (!server_conn || !client_conn) {
+    sys.println("*** failed to create the SSL connections");
+    return EXIT_FAILURE;
+  }
+  // Transfer the data and measure the time it takes to receive everything.
+  auto done = std::promise<bool>{};
+  auto done_future = done.get_future();
+  auto* mpx = &sys.network_manager().mpx();
+  auto start = std::chrono::steady_clock::now();
+  mpx->start(socket_manager::make(
+    mpx, ssl::transport::make_server(std::move(*server_conn),
+                                     std::make_unique<sink>(total,
+                                                            std::move(done)))));
+  mpx->start(socket_manager::make(
+    mpx, ssl::transport::make_client(std::move(*client_conn),
+                                     std::make_unique<source>(total))));
+  if (!done_future.get()) {
+    sys.println("*** connection closed before receiving all data");
+    return EXIT_FAILURE;
+  }
+  auto stop = std::chrono::steady_clock::now();
+  auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+  auto mib = total / (1024 * 1024);
+  auto rate = static_cast<double>(mib) * 1000.0
+              / static_cast<double>(std::max(ms.count(), int64_t{1}));
+  sys.println("*** transferred {} MiB in {} ms ({} MiB/s, kTLS requested: {})",
+              mib, ms.count(), rate, use_ktls);
+  return EXIT_SUCCESS;
+}
+
+CAF_MAIN(caf::net::middleman)
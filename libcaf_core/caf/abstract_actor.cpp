@@ -186,6 +186,14 @@ mailbox_element* abstract_actor::peek_at_next_mailbox_element() {
   return nullptr;
 }
 
+size_t abstract_actor::mailbox_size_hint() const noexcept {
+  return 0;
+}
+
+void abstract_actor::enable_mailbox_size_hint() noexcept {
+  // nop
+}
+
 void abstract_actor::register_at_system() {
   if (getf(is_registered_flag))
     return;
@@ -154,6 +154,17 @@ public:
   ///          mailbox is empty or the actor does not have a mailbox.
   virtual mailbox_element* peek_at_next_mailbox_element();
 
+  /// Returns the approximate number of messages in the mailbox of this actor.
+  /// Any thread may call this function. Returns 0 unless
+  /// `enable_mailbox_size_hint` has been called before. The default
+  /// implementation always returns 0.
+  virtual size_t mailbox_size_hint() const noexcept;
+
+  /// Enables `mailbox_size_hint`. Senders only count their messages after
+  /// calling this function. Any thread may call this function. The default
+  /// implementation does nothing.
+  virtual void enable_mailbox_size_hint() noexcept;
+
   /// Called by the runtime system to perform cleanup actions for this actor.
   /// Subtypes should always call this member function when overriding it.
   /// This member function is thread-safe, and if the actor has already exited
@@ -199,6 +210,12 @@ public:
   /// Indicates that the actor is currently inactive.
   static constexpr int is_inactive_flag = 0b0010'0000'0000;
 
+  /// Indicates that the actor belongs to `scheduling_class::latency`.
+  static constexpr int is_latency_sensitive_flag = 0b0100'0000'0000;
+
+  /// Indicates that the actor belongs to `scheduling_class::batch`.
+  static constexpr int is_batch_flag = 0b1000'0000'0000;
+
   void setf(int flag) {
     auto x = flags();
     flags(x | flag);
@@ -10,4 +10,12 @@ abstract_mailbox::~abstract_mailbox() {
   // nop
 }
 
+size_t abstract_mailbox::size_hint() const noexcept {
+  return 0;
+}
+
+void abstract_mailbox::enable_size_hint() noexcept {
+  // nop
+}
+
 } // namespace caf
@@ -60,6 +60,17 @@ public:
   /// @note Only the owning actor is allowed to call this function.
   virtual size_t size() = 0;
 
+  /// Returns the approximate number of pending messages. Unlike `size`, any
+  /// thread may call this function. Returns 0 unless `enable_size_hint` has
+  /// been called before. The default implementation always returns 0.
+  virtual size_t size_hint() const noexcept;
+
+  /// Enables `size_hint`. Mailboxes may only count incoming messages after
+  /// calling this function, because counting adds overhead to each enqueue
+  /// operation. Any thread may call this function. The default implementation
+  /// does nothing.
+  virtual void enable_size_hint() noexcept;
+
   /// Increases the reference count by one.
   virtual void ref_mailbox() noexcept = 0;
 
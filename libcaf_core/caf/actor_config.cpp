@@ -25,6 +25,8 @@ std::string to_string(const actor_config& x) {
   add(abstract_actor::is_detached_flag, "detached_flag");
   add(abstract_actor::is_blocking_flag, "blocking_flag");
   add(abstract_actor::is_hidden_flag, "hidden_flag");
+  add(abstract_actor::is_latency_sensitive_flag, "latency_sensitive_flag");
+  add(abstract_actor::is_batch_flag, "batch_flag");
   result += ')';
   return result;
 }
@@ -8,8 +8,10 @@
 #include "caf/default_attachable.hpp"
 #include "caf/detail/assert.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
+#include "caf/log/core.hpp"
 #include "caf/mailbox_element.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <random>
 
@@ -75,6 +77,73 @@ actor_pool::policy actor_pool::random() {
   return impl{};
 }
 
+actor_pool::policy actor_pool::least_loaded() {
+  struct impl {
+    impl() : pos_(0) {
+      // nop
+    }
+    impl(const impl&) : pos_(0) {
+      // nop
+    }
+    void operator()(actor_system&, guard_type& guard, const actor_vec& vec,
+                    mailbox_element_ptr& ptr, scheduler* sched) {
+      CAF_ASSERT(!vec.empty());
+      // Start at a rotating offset to break ties in round robin order.
+      auto offset = pos_++;
+      auto best = offset % vec.size();
+      auto best_load = vec[best]->mailbox_size_hint();
+      for (size_t i = 1; i < vec.size() && best_load > 0; ++i) {
+        auto index = (offset + i) % vec.size();
+        auto load = vec[index]->mailbox_size_hint();
+        if (load < best_load) {
+          best = index;
+          best_load = load;
+        }
+      }
+      actor selected = vec[best];
+      guard.unlock();
+      selected->enqueue(std::move(ptr), sched);
+    }
+    std::atomic<size_t> pos_;
+  };
+  return impl{};
+}
+
+actor_pool::policy actor_pool::power_of_two_choices() {
+  struct impl {
+    impl() : gen_(std::random_device{}()) {
+      // nop
+    }
+    impl(const impl&) : impl() {
+      // nop
+    }
+    void operator()(actor_system&, guard_type& guard, const actor_vec& vec,
+                    mailbox_element_ptr& ptr, scheduler* sched) {
+      CAF_ASSERT(!vec.empty());
+      // Note: the pool calls this function with its mutex locked, i.e., we
+      //       can safely access the random number generator.
+      using param_type = std::uniform_int_distribution<size_t>::param_type;
+      auto selected = vec[0];
+      if (vec.size() > 1) {
+        // Pick two distinct workers.
+        auto i = dis_(gen_, param_type(0, vec.size() - 1));
+        auto j = dis_(gen_, param_type(0, vec.size() - 2));
+        if (j >= i)
+          ++j;
+        if (vec[j]->mailbox_size_hint() < vec[i]->mailbox_size_hint())
+          selected = vec[j];
+        else
+          selected = vec[i];
+      }
+      guard.unlock();
+      selected->enqueue(std::move(ptr), sched);
+    }
+    std::minstd_rand gen_;
+    std::uniform_int_distribution<size_t> dis_;
+  };
+  return impl{};
+}
+
 actor_pool::~actor_pool() {
   // nop
 }
@@ -92,13 +161,18 @@ actor actor_pool::make(actor_system& sys, size_t num_workers,
                        const factory& fac, policy pol) {
   auto res = make(sys, std::move(pol));
   auto ptr = static_cast<actor_pool*>(actor_cast<abstract_actor*>(res));
-  auto res_addr = ptr->address();
-  for (size_t i = 0; i < num_workers; ++i) {
-    auto worker = fac();
-    worker->attach(
-      default_attachable::make_monitor(worker.address(), res_addr));
-    ptr->workers_.push_back(std::move(worker));
-  }
+  for (size_t i = 0; i < num_workers; ++i)
+    ptr->add_worker(fac());
+  return res;
+}
+
+actor actor_pool::make(actor_system& sys, size_t num_workers,
+                       const factory& fac, policy pol, autoscaling scaling) {
+  auto res = make(sys, num_workers, fac, std::move(pol));
+  auto ptr = static_cast<actor_pool*>(actor_cast<abstract_actor*>(res));
+  scaling.check_interval = std::max(scaling.check_interval, size_t{1});
+  ptr->factory_ = fac;
+  ptr->scaling_ = scaling;
   return res;
 }
 
@@ -106,6 +180,8 @@ bool actor_pool::enqueue(mailbox_element_ptr what, scheduler* sched) {
   guard_type guard{workers_mtx_};
   if (filter(guard, what->sender, what->mid, what->payload, sched))
     return false;
+  if (scaling_ && ++dispatched_ % scaling_->check_interval == 0)
+    autoscale();
   policy_(home_system(), guard, workers_, what, sched);
   return true;
 }
@@ -159,10 +235,7 @@ bool actor_pool::filter(guard_type& guard, const strong_actor_ptr& sender,
   }
   if (auto view
       = make_const_typed_message_view<sys_atom, put_atom, actor>(content)) {
-    const auto& worker = get<2>(view);
-    worker->attach(
-      default_attachable::make_monitor(worker.address(), address()));
-    workers_.push_back(worker);
+    add_worker(get<2>(view));
     return true;
   }
   if (auto view
@@ -214,6 +287,43 @@ void actor_pool::quit(scheduler* sched) {
     unregister_from_system();
 }
 
+void actor_pool::autoscale() {
+  auto lg = log::core::trace("workers = {}", workers_.size());
+  auto num_workers = workers_.size();
+  auto load = size_t{0};
+  for (auto& worker : workers_)
+    load += worker->mailbox_size_hint();
+  if (load > scaling_->grow_threshold * num_workers
+      && num_workers < scaling_->max_workers) {
+    log::core::debug("add worker: load = {}", load);
+    add_worker(factory_());
+    return;
+  }
+  if (load < scaling_->shrink_threshold * num_workers
+      && num_workers > scaling_->min_workers) {
+    log::core::debug("remove worker: load = {}", load);
+    auto i = std::min_element(workers_.begin(), workers_.end(),
+                              [](const actor& x, const actor& y) {
+                                return x->mailbox_size_hint()
+                                       < y->mailbox_size_hint();
+                              });
+    auto worker = std::move(*i);
+    workers_.erase(i);
+    default_attachable::observe_token tk{address(),
+                                         default_attachable::monitor};
+    worker->detach(tk);
+    // The worker still processes all messages that are already in its mailbox
+    // before handling the exit message.
+    anon_mail(exit_msg{address(), exit_reason::user_shutdown}).send(worker);
+  }
+}
+
+void actor_pool::add_worker(actor worker) {
+  worker->attach(default_attachable::make_monitor(worker.address(), address()));
+  worker->enable_mailbox_size_hint();
+  workers_.push_back(std::move(worker));
+}
+
 void actor_pool::force_close_mailbox() {
   // nop
 }
@@ -11,6 +11,7 @@
 
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 namespace caf {
@@ -36,6 +37,12 @@ namespace caf {
 /// during the enqueue operation. Any user-defined policy thus has to dispatch
 /// messages with as little overhead as possible, because the dispatching
 /// runs in the context of the sender.
+///
+/// The policies `least_loaded` and `power_of_two_choices` as well as
+/// autoscaling measure the load of a worker by the number of messages in its
+/// mailbox. For this purpose, the pool enables the mailbox size hint of each
+/// worker. Workers without a local mailbox, e.g., remote actors, always
+/// appear idle.
 /// @experimental
 class CAF_CORE_EXPORT actor_pool : public abstract_actor {
 public:
@@ -46,6 +53,26 @@ public:
     = std::function<void(actor_system&, guard_type&, const actor_vec&,
                          mailbox_element_ptr&, scheduler*)>;
 
+  /// Configures how a pool adapts its number of workers to the load.
+  struct autoscaling {
+    /// The pool never removes workers below this limit.
+    size_t min_workers = 1;
+
+    /// The pool never adds workers above this limit.
+    size_t max_workers = 16;
+
+    /// The pool adds a worker when the average number of messages per mailbox
+    /// exceeds this threshold.
+    size_t grow_threshold = 8;
+
+    /// The pool removes the least loaded worker when the average number of
+    /// messages per mailbox drops below this threshold.
+    size_t shrink_threshold = 1;
+
+    /// Number of dispatched messages between two load checks.
+    size_t check_interval = 64;
+  };
+
   /// Returns a simple round robin dispatching policy.
   static policy round_robin();
 
@@ -55,6 +82,16 @@ public:
   /// Returns a random dispatching policy.
   static policy random();
 
+  /// Returns a dispatching policy that selects the worker with the fewest
+  /// messages in its mailbox. Breaks ties in round robin order.
+  static policy least_loaded();
+
+  /// Returns a dispatching policy that picks two workers at random and selects
+  /// the one with fewer messages in its mailbox. Scales better than
+  /// `least_loaded` for large pools, since it only inspects two mailboxes per
+  /// message.
+  static policy power_of_two_choices();
+
   /// Returns a split/join dispatching policy. The function object `sf`
   /// distributes a work item to all workers (split step) and the function
   /// object `jf` joins individual results into a single one with `init`
@@ -85,6 +122,13 @@ public:
   static actor
   make(actor_system& sys, size_t num_workers, const factory& fac, policy pol);
 
+  /// Returns an actor pool with `num_workers` initial workers created by the
+  /// factory function `fac` using the dispatch policy `pol`. The pool adds
+  /// workers with `fac` or removes workers depending on the load.
+  [[deprecated("actor pools will be removed in the next major release")]]
+  static actor make(actor_system& sys, size_t num_workers, const factory& fac,
+                    policy pol, autoscaling scaling);
+
   bool enqueue(mailbox_element_ptr what, scheduler* sched) override;
 
   actor_pool(actor_config& cfg);
@@ -105,12 +149,21 @@ private:
   // call without workers_mtx_ held
   void quit(scheduler* sched);
 
+  // call with workers_mtx_ held
+  void autoscale();
+
+  // call with workers_mtx_ held
+  void add_worker(actor worker);
+
   void force_close_mailbox() override;
 
   std::mutex workers_mtx_;
   std::vector<actor> workers_;
   policy policy_;
   exit_reason planned_reason_;
+  factory factory_;
+  std::optional<autoscaling> scaling_;
+  size_t dispatched_ = 0;
 };
 
 } // namespace caf
@@ -8,9 +8,12 @@
 
 #include "caf/actor_registry.hpp"
 #include "caf/actor_system_config.hpp"
+#include "caf/anon_mail.hpp"
 #include "caf/log/test.hpp"
 #include "caf/scoped_actor.hpp"
 
+#include <future>
+
 using namespace caf;
 using namespace std::literals;
 
@@ -59,6 +62,55 @@ struct fixture {
     spawn_worker = [&] { return sys.spawn<worker>(); };
   }
 
+  // Spawns workers that respond with their index to integer pairs and block
+  // on `ok_atom` messages until the test completes `release`.
+  std::function<actor()> indexed_workers(std::shared_future<void> released) {
+    auto next_index = std::make_shared<int32_t>(0);
+    return [this, next_index, released] {
+      return sys.spawn([index = (*next_index)++, released]() -> behavior {
+        return {
+          [index](int32_t, int32_t) { return index; },
+          [released](ok_atom) { released.wait(); },
+        };
+      });
+    };
+  }
+
+  // Returns the current workers of `pool`.
+  std::vector<actor> workers_of(scoped_actor& self, const actor& pool) {
+    std::vector<actor> result;
+    self->mail(sys_atom_v, get_atom_v)
+      .request(pool, infinite)
+      .receive([&](std::vector<actor>& ws) { result = std::move(ws); },
+               HANDLE_ERROR);
+    return result;
+  }
+
+  // Blocks the first worker of a pool with three workers and fills its
+  // mailbox. Load-aware policies then must skip this worker.
+  void check_skips_busy_worker(actor_pool::policy pol) {
+    auto& rt = test::runnable::current();
+    scoped_actor self{sys};
+    std::promise<void> release;
+    auto pool = actor_pool::make(sys, 3,
+                                 indexed_workers(release.get_future().share()),
+                                 std::move(pol));
+    auto workers = workers_of(self, pool);
+    rt.require_eq(workers.size(), 3u);
+    anon_mail(ok_atom_v).send(workers[0]);
+    for (int32_t i = 0; i < 3; ++i)
+      anon_mail(i, i).send(workers[0]);
+    for (int32_t i = 0; i < 10; ++i) {
+      self->mail(i, i)
+        .request(pool, 1s)
+        .receive([&rt](int32_t index) { rt.check_ne(index, 0); },
+                 HANDLE_ERROR);
+    }
+    release.set_value();
+    self->send_exit(pool, exit_reason::user_shutdown);
+    self->wait_for(workers);
+  }
+
   ~fixture() {
     sys.await_all_actors_done();
     sys.~actor_system();
@@ -161,6 +213,52 @@ TEST("random_actor_pool") {
   self->send_exit(pool, exit_reason::user_shutdown);
 }
 
+TEST("least_loaded_actor_pool") {
+  check_skips_busy_worker(actor_pool::least_loaded());
+}
+
+TEST("power_of_two_choices_actor_pool") {
+  check_skips_busy_worker(actor_pool::power_of_two_choices());
+}
+
+TEST("autoscaling_actor_pool") {
+  scoped_actor self{sys};
+  std::promise<void> release;
+  auto scaling = actor_pool::autoscaling{};
+  scaling.min_workers = 1;
+  scaling.max_workers = 2;
+  scaling.grow_threshold = 2;
+  scaling.shrink_threshold = 1;
+  scaling.check_interval = 1;
+  auto pool = actor_pool::make(sys, 1,
+                               indexed_workers(release.get_future().share()),
+                               actor_pool::least_loaded(), scaling);
+  auto first = workers_of(self, pool);
+  require_eq(first.size(), 1u);
+  log::test::debug("block the first worker to grow the pool");
+  anon_mail(ok_atom_v).send(first[0]);
+  for (int32_t i = 0; i < 3; ++i)
+    anon_mail(i, i).send(first[0]);
+  self->mail(1, 2)
+    .request(pool, 1s)
+    .receive([this](int32_t index) { check_eq(index, 1); }, HANDLE_ERROR);
+  auto all = workers_of(self, pool);
+  check_eq(all.size(), 2u);
+  log::test::debug("release the first worker to shrink the pool again");
+  release.set_value();
+  // poll actor pool up to 100 times or until it removes a worker
+  auto success = false;
+  for (size_t i = 0; !success && i < 100; ++i) {
+    self->mail(1, 2).request(pool, 1s).receive([](int32_t) {}, HANDLE_ERROR);
+    success = workers_of(self, pool).size() == 1;
+    if (!success)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  check(success);
+  self->send_exit(pool, exit_reason::user_shutdown);
+  self->wait_for(all);
+}
+
 } // WITH_FIXTURE(fixture)
 
 } // namespace
@@ -0,0 +1,13 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/actor_profiler.hpp"
+
+namespace caf {
+
+actor_profiler::~actor_profiler() {
+  // nop
+}
+
+} // namespace caf
@@ -0,0 +1,83 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/build_config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+namespace caf {
+
+/// Interface for observing the message flow of all local actors in an actor
+/// system. CAF only calls the hooks when building with
+/// `CAF_ENABLE_ACTOR_PROFILER`. Otherwise, the hooks compile to no-ops.
+/// @warning all member functions must be thread-safe.
+class CAF_CORE_EXPORT actor_profiler {
+public:
+  virtual ~actor_profiler();
+
+  /// Called whenever the actor system spawns a new local actor. CAF calls this
+  /// member function from the constructor of `local_actor`, i.e., before the
+  /// constructors of derived types have run.
+  /// @param self The new actor.
+  /// @param parent Points to the spawning actor or is `nullptr` if the actor
+  ///               was spawned from outside of an actor.
+  virtual void add_actor(const local_actor& self, const local_actor* parent)
+    = 0;
+
+  /// Called before `self` terminates.
+  virtual void remove_actor(const local_actor& self) = 0;
+
+  /// Called before `element` enters the mailbox of `self`. Runs on the thread
+  /// of the sender. The profiler may modify the trace context of `element`,
+  /// e.g., for assigning a new span ID.
+  virtual void enqueued(const local_actor& self, mailbox_element& element)
+    = 0;
+
+  /// Called whenever `self` takes `element` out of its mailbox. An actor may
+  /// dequeue the same element multiple times if it skips the message at first.
+  virtual void dequeued(const local_actor& self, const mailbox_element& element)
+    = 0;
+
+  /// Called before `self` invokes its behavior for `element`.
+  virtual void before_processing(const local_actor& self,
+                                 const mailbox_element& element)
+    = 0;
+
+  /// Called after `self` has invoked its behavior for the current element.
+  virtual void after_processing(const local_actor& self,
+                                invoke_message_result result)
+    = 0;
+};
+
+} // namespace caf
+
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+#  define CAF_ACTOR_PROFILER_HOOK(self, hook, ...)                             \
+    do {                                                                       \
+      if (auto caf_profiler_ptr = (self)->home_system().profiler())            \
+        caf_profiler_ptr->hook(__VA_ARGS__);                                   \
+    } while (false)
+#else
+#  define CAF_ACTOR_PROFILER_HOOK(self, hook, ...) static_cast<void>(0)
+#endif
+
+#define CAF_ADD_ACTOR(self, parent)                                            \
+  CAF_ACTOR_PROFILER_HOOK(self, add_actor, *(self), parent)
+
+#define CAF_REMOVE_ACTOR(self)                                                 \
+  CAF_ACTOR_PROFILER_HOOK(self, remove_actor, *(self))
+
+#define CAF_ENQUEUED(self, element)                                            \
+  CAF_ACTOR_PROFILER_HOOK(self, enqueued, *(self), element)
+
+#define CAF_DEQUEUED(self, element)                                            \
+  CAF_ACTOR_PROFILER_HOOK(self, dequeued, *(self), element)
+
+#define CAF_BEFORE_PROCESSING(self, element)                                   \
+  CAF_ACTOR_PROFILER_HOOK(self, before_processing, *(self), element)
+
+#define CAF_AFTER_PROCESSING(self, result)                                     \
+  CAF_ACTOR_PROFILER_HOOK(self, after_processing, *(self), result)
@@ -0,0 +1,170 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/actor_profiler.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/invoke_message_result.hpp"
+#include "caf/mailbox_element.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/trace_context.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+
+struct event {
+  std::string what;
+  trace_context trace;
+};
+
+class recording_profiler : public actor_profiler {
+public:
+  void add_actor(const local_actor& self, const local_actor*) override {
+    record(self, "add_actor");
+  }
+
+  void remove_actor(const local_actor& self) override {
+    record(self, "remove_actor");
+  }
+
+  void enqueued(const local_actor& self, mailbox_element& element) override {
+    // Start a new trace for each message without context.
+    if (!element.trace)
+      element.trace.trace_id = next_id_++;
+    element.trace.span_id = next_id_++;
+    record(self, "enqueued", element.trace);
+  }
+
+  void dequeued(const local_actor& self,
+                const mailbox_element& element) override {
+    record(self, "dequeued", element.trace);
+  }
+
+  void before_processing(const local_actor& self,
+                         const mailbox_element& element) override {
+    record(self, "before_processing", element.trace);
+  }
+
+  void after_processing(const local_actor& self,
+                        invoke_message_result result) override {
+    if (result == invoke_message_result::consumed)
+      record(self, "after_processing", trace_context::current());
+  }
+
+  std::vector<event> events_of(actor_id id) {
+    std::vector<event> result;
+    std::unique_lock guard{mtx_};
+    for (auto& [aid, ev] : events_)
+      if (aid == id)
+        result.push_back(ev);
+    return result;
+  }
+
+private:
+  void record(const local_actor& self, std::string what,
+              trace_context trace = {}) {
+    std::unique_lock guard{mtx_};
+    events_.emplace_back(self.id(), event{std::move(what), trace});
+  }
+
+  std::atomic<uint64_t> next_id_ = 1;
+  std::mutex mtx_;
+  std::vector<std::pair<actor_id, event>> events_;
+};
+
+struct config : actor_system_config {
+  config() {
+    set_actor_profiler<recording_profiler>();
+  }
+};
+
+struct fixture {
+  config cfg;
+  actor_system sys;
+
+  fixture() : sys(cfg) {
+    // nop
+  }
+
+  recording_profiler& profiler() {
+    return static_cast<recording_profiler&>(*sys.profiler());
+  }
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("the profiler observes each message of an actor") {
+  auto worker = sys.spawn([]() -> behavior {
+    return {
+      [](int x) { return x * 2; },
+    };
+  });
+  auto worker_id = worker.id();
+  scoped_actor self{sys};
+  auto result = 0;
+  self->mail(21).request(worker, 1s).receive([&result](int x) { result = x; },
+                                             [this](error& err) {
+                                               fail("unexpected error: {}",
+                                                    err);
+                                             });
+  check_eq(result, 42);
+  auto events = profiler().events_of(worker_id);
+  require_ge(events.size(), 5u);
+  check_eq(events[0].what, "add_actor");
+  check_eq(events[1].what, "enqueued");
+  check_eq(events[2].what, "dequeued");
+  check_eq(events[3].what, "before_processing");
+  check_eq(events[4].what, "after_processing");
+  SECTION("actors process messages in the trace context of the message") {
+    auto trace = events[1].trace;
+    check(static_cast<bool>(trace));
+    check_eq(events[2].trace, trace);
+    check_eq(events[3].trace, trace);
+    check_eq(events[4].trace, trace);
+  }
+  SECTION("messages inherit the trace context of their cause") {
+    auto self_events = profiler().events_of(self->id());
+    auto response = std::find_if(self_events.begin(), self_events.end(),
+                                 [](const event& ev) {
+                                   return ev.what == "enqueued";
+                                 });
+    require(response != self_events.end());
+    check_eq(response->trace.trace_id, events[1].trace.trace_id);
+    check_ne(response->trace.span_id, events[1].trace.span_id);
+  }
+}
+
+} // WITH_FIXTURE(fixture)
+
+#endif // CAF_ENABLE_ACTOR_PROFILER
+
+TEST("trace context guards restore the previous context") {
+  check(!trace_context::current());
+  {
+    trace_context::guard outer{trace_context{1, 2}};
+    check_eq(trace_context::current(), trace_context{1, 2});
+    {
+      trace_context::guard inner{trace_context{1, 3}};
+      check_eq(trace_context::current(), trace_context{1, 3});
+    }
+    check_eq(trace_context::current(), trace_context{1, 2});
+  }
+  check(!trace_context::current());
+}
+
+} // namespace
@@ -7,6 +7,7 @@
 #include "caf/actor_system.hpp"
 #include "caf/attachable.hpp"
 #include "caf/detail/assert.hpp"
+#include "caf/detail/epoch_domain.hpp"
 #include "caf/event_based_actor.hpp"
 #include "caf/exit_reason.hpp"
 #include "caf/log/core.hpp"
@@ -30,10 +31,11 @@ using shared_guard = std::shared_lock<std::shared_mutex>;
 } // namespace
 
 actor_registry::~actor_registry() {
-  // nop
+  delete named_entries_.load();
 }
 
-actor_registry::actor_registry(actor_system& sys) : system_(sys) {
+actor_registry::actor_registry(actor_system& sys)
+  : named_entries_(new name_map), system_(sys) {
   // nop
 }
 
@@ -87,7 +89,7 @@ size_t actor_registry::running() const {
 
 size_t actor_registry::dec_running() {
   size_t new_val = --*system_.base_metrics().running_actors;
-  if (new_val <= 1) {
+  if (new_val <= 1 && running_waiters_.load() > 0) {
     std::unique_lock<std::mutex> guard(running_mtx_);
     running_cv_.notify_all();
   }
@@ -98,16 +100,19 @@ void actor_registry::await_running_count_equal(size_t expected) const {
   CAF_ASSERT(expected == 0 || expected == 1);
   auto lg = log::core::trace("expected = {}", expected);
   std::unique_lock<std::mutex> guard{running_mtx_};
+  ++running_waiters_;
   while (running() != expected) {
     log::core::debug("running = {}", running());
     running_cv_.wait(guard);
   }
+  --running_waiters_;
 }
 
 strong_actor_ptr actor_registry::get_impl(const std::string& key) const {
-  shared_guard guard{named_entries_mtx_};
-  auto i = named_entries_.find(key);
-  if (i == named_entries_.end())
+  detail::epoch_domain::read_guard guard{detail::epoch_domain::global()};
+  auto* entries = named_entries_.load();
+  auto i = entries->find(key);
+  if (i == entries->end())
     return nullptr;
   return i->second;
 }
@@ -117,27 +122,43 @@ void actor_registry::put_impl(const std::string& key, strong_actor_ptr value) {
     erase(key);
     return;
   }
-  exclusive_guard guard{named_entries_mtx_};
-  named_entries_.emplace(std::move(key), std::move(value));
+  std::unique_ptr<const name_map> old;
+  { // Lifetime scope of guard.
+    std::unique_lock guard{named_entries_mtx_};
+    auto* entries = named_entries_.load();
+    if (entries->count(key) != 0)
+      return;
+    auto new_entries = std::make_unique<name_map>(*entries);
+    new_entries->emplace(key, std::move(value));
+    old = publish(std::move(new_entries));
+  }
 }
 
 void actor_registry::erase(const std::string& key) {
-  // Stores a reference to the actor we're going to remove for the same
-  // reasoning as in erase(actor_id).
-  strong_actor_ptr ref;
+  // Destroys the previous snapshot outside of the critical section for the
+  // same reasoning as in erase(actor_id).
+  std::unique_ptr<const name_map> old;
   { // Lifetime scope of guard.
-    exclusive_guard guard{named_entries_mtx_};
-    auto i = named_entries_.find(key);
-    if (i != named_entries_.end()) {
-      ref.swap(i->second);
-      named_entries_.erase(i);
-    }
+    std::unique_lock guard{named_entries_mtx_};
+    auto* entries = named_entries_.load();
+    if (entries->count(key) == 0)
+      return;
+    auto new_entries = std::make_unique<name_map>(*entries);
+    new_entries->erase(key);
+    old = publish(std::move(new_entries));
   }
 }
 
 auto actor_registry::named_actors() const -> name_map {
-  shared_guard guard{named_entries_mtx_};
-  return named_entries_;
+  detail::epoch_domain::read_guard guard{detail::epoch_domain::global()};
+  return *named_entries_.load();
+}
+
+std::unique_ptr<const actor_registry::name_map>
+actor_registry::publish(std::unique_ptr<const name_map> ptr) {
+  std::unique_ptr<const name_map> old{named_entries_.exchange(ptr.release())};
+  detail::epoch_domain::global().synchronize();
+  return old;
 }
 
 void actor_registry::start() {
@@ -149,9 +170,10 @@ void actor_registry::stop() {
     exclusive_guard guard{instances_mtx_};
     entries_.clear();
   }
+  std::unique_ptr<const name_map> old;
   {
-    exclusive_guard guard{named_entries_mtx_};
-    named_entries_.clear();
+    std::unique_lock guard{named_entries_mtx_};
+    old = publish(std::make_unique<name_map>());
   }
 }
 
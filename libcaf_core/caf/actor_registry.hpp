@@ -15,6 +15,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
@@ -29,6 +30,11 @@ namespace caf {
 /// independent from their ID at runtime. Note that the registry does *not*
 /// contain all actors of an actor system. The middleman registers actors as
 /// needed.
+///
+/// Name lookups use read-copy-update (RCU): readers access an immutable
+/// snapshot of the name map without acquiring any lock, while writers replace
+/// the snapshot with an updated copy. Hence, modifying the name map is
+/// relatively expensive, but lookups scale with the number of threads.
 class CAF_CORE_EXPORT actor_registry {
 public:
   friend class actor_system;
@@ -106,6 +112,11 @@ private:
   /// Associates given actor to `key`.
   void put_impl(const std::string& key, strong_actor_ptr value);
 
+  /// Replaces the current snapshot of the name map with `ptr` and returns
+  /// the previous snapshot after all readers have left it.
+  /// @pre `named_entries_mtx_` is locked by the caller
+  std::unique_ptr<const name_map> publish(std::unique_ptr<const name_map> ptr);
+
   using entries = std::unordered_map<actor_id, strong_actor_ptr>;
 
   actor_registry(actor_system& sys);
@@ -113,11 +124,19 @@ private:
   mutable std::mutex running_mtx_;
   mutable std::condition_variable running_cv_;
 
+  /// Number of threads that currently wait in `await_running_count_equal`.
+  /// Allows `dec_running` to skip the mutex if nobody is waiting.
+  mutable std::atomic<size_t> running_waiters_ = 0;
+
   mutable std::shared_mutex instances_mtx_;
   entries entries_;
 
-  name_map named_entries_;
-  mutable std::shared_mutex named_entries_mtx_;
+  /// Points to the current snapshot of the name map. Readers may only access
+  /// the snapshot in a read-side critical section of the global epoch domain.
+  std::atomic<const name_map*> named_entries_;
+
+  /// Serializes writers of the name map.
+  std::mutex named_entries_mtx_;
 
   actor_system& system_;
 };
@@ -13,6 +13,10 @@
 #include "caf/log/test.hpp"
 #include "caf/scoped_actor.hpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace caf;
 
 namespace {
@@ -41,6 +45,34 @@ TEST("erase") {
   check_eq(sys.registry().named_actors().size(), baseline);
 }
 
+TEST("name lookups may run concurrently to updates") {
+  auto& reg = sys.registry();
+  auto hdl = sys.spawn(dummy);
+  reg.put("foo", hdl);
+  std::atomic<bool> done = false;
+  std::atomic<size_t> failed_lookups = 0;
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      while (!done.load())
+        if (reg.get<actor>("foo") != hdl)
+          ++failed_lookups;
+    });
+  }
+  for (int i = 0; i < 100; ++i) {
+    auto key = "bar-" + std::to_string(i);
+    reg.put(key, hdl);
+    reg.erase(key);
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+  check_eq(failed_lookups.load(), 0u);
+  check_eq(reg.get<actor>("bar-0"), nullptr);
+  reg.erase("foo");
+  check_eq(reg.get<actor>("foo"), nullptr);
+}
+
 TEST("serialization roundtrips go through the registry") {
   auto hdl = sys.spawn(dummy);
   log::test::debug("hdl.id: {}", hdl->id());
@@ -7,6 +7,7 @@
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_control_block.hpp"
 #include "caf/config.hpp"
+#include "caf/detail/actor_storage_pool.hpp"
 
 #include <atomic>
 #include <cstddef>
@@ -58,6 +59,30 @@ public:
   actor_storage(const actor_storage&) = delete;
   actor_storage& operator=(const actor_storage&) = delete;
 
+  // Recycle the memory of terminated actors via a per-type free list. Spawning
+  // and terminating many short-lived actors of the same type then mostly
+  // bypasses the global allocator.
+
+  static void* operator new(size_t) {
+    return pool().allocate();
+  }
+
+  static void* operator new(size_t, std::align_val_t) {
+    return pool().allocate();
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    pool().deallocate(ptr);
+  }
+
+  static void operator delete(void* ptr, std::align_val_t) noexcept {
+    pool().deallocate(ptr);
+  }
+
+  static detail::actor_storage_pool& pool() {
+    return detail::actor_storage_pool::instance<actor_storage>();
+  }
+
   static_assert(sizeof(actor_control_block) < CAF_CACHE_LINE_SIZE,
                 "actor_control_block exceeds 64 bytes");
 
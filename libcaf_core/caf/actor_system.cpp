@@ -258,6 +258,9 @@ auto make_base_metrics(telemetry::metric_registry& reg) {
                         "Number of currently running actors."),
     reg.gauge_singleton("caf.system", "queued-messages",
                         "Number of messages in all mailboxes.", "1", true),
+    reg.counter_singleton("caf.system", "dropped-messages",
+                          "Number of messages dropped by bounded mailboxes.",
+                          "1", true),
   };
 }
 
@@ -394,6 +397,7 @@ public:
       registry(*parent),
       await_actors_before_shutdown(true),
       cfg(&cfg),
+      profiler(cfg.profiler()),
       private_threads(parent) {
     print_state = std::make_unique<print_state_impl>(cfg);
     meta_objects_guard = detail::global_meta_objects_guard();
@@ -569,6 +573,9 @@ public:
   /// The system-wide, user-provided configuration.
   actor_system_config* cfg;
 
+  /// Caches the user-defined profiler for faster lookups at runtime.
+  actor_profiler* profiler;
+
   /// Caches the configuration parameter `caf.metrics-filters.actors.includes`
   /// for faster lookups at runtime.
   std::vector<std::string> metrics_actors_includes;
@@ -849,6 +856,10 @@ detail::actor_local_printer_ptr actor_system::printer_for(local_actor* self) {
   return make_counted<impl_t>(self, actor_cast<actor>(impl_->printer));
 }
 
+actor_profiler* actor_system::profiler() const noexcept {
+  return impl_->profiler;
+}
+
 detail::mailbox_factory* actor_system::mailbox_factory() {
   return impl_->cfg->mailbox_factory();
 }
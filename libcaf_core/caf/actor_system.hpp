@@ -168,6 +168,10 @@ public:
 
     /// Counts the total number of messages that wait in a mailbox.
     telemetry::int_gauge* queued_messages;
+
+    /// Counts the number of messages that a bounded mailbox discarded or
+    /// rejected because it has reached its capacity.
+    telemetry::int_counter* dropped_messages;
   };
 
   /// Metrics that some actors may collect in addition to the base metrics. All
@@ -509,10 +513,16 @@ public:
   infer_handle_from_class_t<C> spawn_impl(actor_config& cfg, Ts&&... xs) {
     static_assert(is_unbound(Os),
                   "top-level spawns cannot have monitor or link flag");
+    static_assert(!has_latency_flag(Os) || !has_batch_flag(Os),
+                  "actors cannot belong to multiple scheduling classes");
     if constexpr (has_detach_flag(Os) || std::is_base_of_v<blocking_actor, C>)
       cfg.flags |= abstract_actor::is_detached_flag;
     if constexpr (has_hide_flag(Os))
       cfg.flags |= abstract_actor::is_hidden_flag;
+    if constexpr (has_latency_flag(Os))
+      cfg.flags |= abstract_actor::is_latency_sensitive_flag;
+    if constexpr (has_batch_flag(Os))
+      cfg.flags |= abstract_actor::is_batch_flag;
     if (cfg.sched == nullptr)
       cfg.sched = &scheduler();
     CAF_SET_LOGGER_SYS(this);
@@ -600,6 +610,8 @@ public:
       std::bool_constant<std::is_same_v<Impl, event_based_actor>>{});
     static_assert(std::is_base_of_v<scheduled_actor, Impl>,
                   "only scheduled actors may get spawned inactively");
+    static_assert(!has_latency_flag(Os) || !has_batch_flag(Os),
+                  "actors cannot belong to multiple scheduling classes");
     CAF_SET_LOGGER_SYS(this);
     actor_config cfg{&scheduler(), nullptr};
     cfg.flags = abstract_actor::is_inactive_flag;
@@ -607,6 +619,10 @@ public:
       cfg.flags |= abstract_actor::is_detached_flag;
     if constexpr (has_hide_flag(Os))
       cfg.flags |= abstract_actor::is_hidden_flag;
+    if constexpr (has_latency_flag(Os))
+      cfg.flags |= abstract_actor::is_latency_sensitive_flag;
+    if constexpr (has_batch_flag(Os))
+      cfg.flags |= abstract_actor::is_batch_flag;
     cfg.mbox_factory = mailbox_factory();
     auto res = make_actor<Impl>(next_actor_id(), node(), this, cfg,
                                 std::forward<Ts>(xs)...);
@@ -627,6 +643,9 @@ public:
 
   virtual detail::actor_local_printer_ptr printer_for(local_actor* self);
 
+  /// Returns the profiler for local actors or `nullptr` if none is set.
+  actor_profiler* profiler() const noexcept;
+
   using custom_setup_fn = void (*)(actor_system&, actor_system_config&, void*);
 
   actor_system(actor_system_config& cfg, custom_setup_fn custom_setup,
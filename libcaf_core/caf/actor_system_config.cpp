@@ -87,6 +87,7 @@ struct actor_system_config::fields {
   actor_factory_dictionary actor_factories;
   thread_hook_list thread_hooks;
   std::unique_ptr<detail::mailbox_factory> mailbox_factory;
+  std::unique_ptr<actor_profiler> profiler;
   bool helptext_printed = false;
   std::string program_name;
   std::vector<std::string> args_remainder;
@@ -113,7 +114,11 @@ actor_system_config::actor_system_config() {
     .add<std::string>("policy", "'stealing' (default) or 'sharing'")
     .add<size_t>("max-threads", "maximum number of worker threads")
     .add<size_t>("max-throughput",
-                 "nr. of messages actors can consume per run");
+                 "nr. of messages actors can consume per run")
+    .add<size_t>("latency-weight",
+                 "relative share of latency-sensitive actors")
+    .add<size_t>("normal-weight", "relative share of regular actors")
+    .add<size_t>("batch-weight", "relative share of batch-processing actors");
   opt_group(custom_options_, "caf.work-stealing")
     .add<size_t>("aggressive-poll-attempts", "nr. of aggressive steal attempts")
     .add<size_t>("aggressive-steal-interval",
@@ -126,7 +131,14 @@ actor_system_config::actor_system_config() {
     .add<size_t>("relaxed-steal-interval",
                  "frequency of relaxed steal attempts")
     .add<timespan>("relaxed-sleep-duration",
-                   "sleep duration between relaxed steal attempts");
+                   "sleep duration between relaxed steal attempts")
+    .add<bool>("topology-aware",
+               "prefer stealing from workers on nearby CPUs")
+    .add<bool>("pin-workers",
+               "pin workers to CPUs when running topology-aware")
+    .add<size_t>("remote-steal-threshold",
+                 "nr. of failed steal attempts before stealing from other "
+                 "NUMA nodes");
   opt_group{custom_options_, "caf.logger.file"}
     .add<std::string>("path", "filesystem path for the log file")
     .add<std::string>("format", "format for individual log file entries")
@@ -166,6 +178,12 @@ settings actor_system_config::dump_content() const {
   put_missing(scheduler_group, "policy", defaults::scheduler::policy);
   put_missing(scheduler_group, "max-throughput",
               defaults::scheduler::max_throughput);
+  put_missing(scheduler_group, "latency-weight",
+              defaults::scheduler::latency_weight);
+  put_missing(scheduler_group, "normal-weight",
+              defaults::scheduler::normal_weight);
+  put_missing(scheduler_group, "batch-weight",
+              defaults::scheduler::batch_weight);
   // -- work-stealing parameters
   auto& work_stealing_group = caf_group["work-stealing"].as_dictionary();
   put_missing(work_stealing_group, "aggressive-poll-attempts",
@@ -182,6 +200,12 @@ settings actor_system_config::dump_content() const {
               defaults::work_stealing::relaxed_steal_interval);
   put_missing(work_stealing_group, "relaxed-sleep-duration",
               defaults::work_stealing::relaxed_sleep_duration);
+  put_missing(work_stealing_group, "topology-aware",
+              defaults::work_stealing::topology_aware);
+  put_missing(work_stealing_group, "pin-workers",
+              defaults::work_stealing::pin_workers);
+  put_missing(work_stealing_group, "remote-steal-threshold",
+              defaults::work_stealing::remote_steal_threshold);
   // -- logger parameters
   auto& logger_group = caf_group["logger"].as_dictionary();
   auto& file_group = logger_group["file"].as_dictionary();
@@ -637,6 +661,17 @@ span<std::unique_ptr<thread_hook>> actor_system_config::thread_hooks() {
   return fields_->thread_hooks;
 }
 
+// -- actor profiler -----------------------------------------------------------
+
+void actor_system_config::set_actor_profiler(
+  std::unique_ptr<actor_profiler> ptr) {
+  fields_->profiler = std::move(ptr);
+}
+
+actor_profiler* actor_system_config::profiler() {
+  return fields_->profiler.get();
+}
+
 // -- mailbox factory ----------------------------------------------------------
 
 void actor_system_config::mailbox_factory(
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "caf/actor_factory.hpp"
+#include "caf/actor_profiler.hpp"
 #include "caf/callback.hpp"
 #include "caf/config_option.hpp"
 #include "caf/config_option_adder.hpp"
@@ -140,6 +141,14 @@ public:
     return *this;
   }
 
+  /// Sets the profiler for all local actors. Only has an effect when building
+  /// CAF with `CAF_ENABLE_ACTOR_PROFILER`.
+  template <class Profiler, class... Ts>
+  actor_system_config& set_actor_profiler(Ts&&... ts) {
+    set_actor_profiler(std::make_unique<Profiler>(std::forward<Ts>(ts)...));
+    return *this;
+  }
+
   // -- parser and CLI state ---------------------------------------------------
 
   /// Returns whether the help text was printed. If this function return `true`,
@@ -257,6 +266,12 @@ private:
 
   span<std::unique_ptr<thread_hook>> thread_hooks();
 
+  // -- actor profiler ---------------------------------------------------------
+
+  void set_actor_profiler(std::unique_ptr<actor_profiler> ptr);
+
+  actor_profiler* profiler();
+
   // -- mailbox factory --------------------------------------------------------
 
   void mailbox_factory(std::unique_ptr<detail::mailbox_factory> factory);
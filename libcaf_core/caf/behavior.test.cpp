@@ -290,6 +290,78 @@ TEST("behaviors may be assigned after construction") {
   }
 }
 
+TEST("behaviors with many handlers select handlers via a dispatch table") {
+  auto m4 = make_message("hello"s);
+  auto m5 = make_message(1.0);
+  SECTION("each message goes to the handler with matching types") {
+    auto f = behavior{
+      [](int x) { return x + 1; },
+      [](int x, int y) { return x + y; },
+      [](int x, int y, int z) { return x + y + z; },
+      [](const std::string&) { return 10; },
+      [](double) { return 20; },
+      [](float) { return 30; },
+      [](bool) { return 40; },
+      [](int8_t) { return 50; },
+      [](int16_t) { return 60; },
+      [](int64_t) { return 70; },
+    };
+    check_eq(res_of(f, m1), 2);
+    check_eq(res_of(f, m2), 3);
+    check_eq(res_of(f, m3), 6);
+    check_eq(res_of(f, m4), 10);
+    check_eq(res_of(f, m5), 20);
+    auto m6 = make_message(int64_t{1});
+    check_eq(res_of(f, m6), 70);
+    auto m7 = make_message(uint64_t{1});
+    check_eq(res_of(f, m7), std::nullopt);
+  }
+  SECTION("the first matching handler wins") {
+    auto f = behavior{
+      [](double) { return 1; },
+      [](float) { return 2; },
+      [](bool) { return 3; },
+      [](int8_t) { return 4; },
+      [](int16_t) { return 5; },
+      [](int64_t) { return 6; },
+      [](int x) { return x + 1; },
+      [](int x) { return x + 2; },
+    };
+    check_eq(res_of(f, m1), 2);
+  }
+  SECTION("catch-all handlers take precedence over later handlers") {
+    auto f = behavior{
+      [](double) { return 1; },
+      [](float) { return 2; },
+      [](bool) { return 3; },
+      [](int8_t) { return 4; },
+      [](message&) { return 5; },
+      [](int16_t) { return 6; },
+      [](int64_t) { return 7; },
+      [](int x) { return x + 1; },
+    };
+    check_eq(res_of(f, m1), 5);
+    check_eq(res_of(f, m5), 1);
+  }
+  SECTION("catch-all handlers receive all unmatched messages") {
+    auto f = behavior{
+      [](double) { return 1; },
+      [](float) { return 2; },
+      [](bool) { return 3; },
+      [](int8_t) { return 4; },
+      [](int16_t) { return 5; },
+      [](int64_t) { return 6; },
+      [](int x) { return x + 1; },
+      [](message&) { return 7; },
+    };
+    check_eq(res_of(f, m1), 2);
+    check_eq(res_of(f, m2), 7);
+    check_eq(res_of(f, m4), 7);
+    auto msg = make_message(exit_msg{actor_addr{}, exit_reason::user_shutdown});
+    check_eq(res_of(f, msg), std::nullopt);
+  }
+}
+
 } // WITH_FIXTURE(fixture)
 
 } // namespace
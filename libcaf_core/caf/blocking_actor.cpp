@@ -4,12 +4,14 @@
 
 #include "caf/blocking_actor.hpp"
 
+#include "caf/actor_profiler.hpp"
 #include "caf/actor_registry.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/anon_mail.hpp"
 #include "caf/detail/assert.hpp"
 #include "caf/detail/default_invoke_result_visitor.hpp"
 #include "caf/detail/invoke_result_visitor.hpp"
+#include "caf/detail/mailbox_factory.hpp"
 #include "caf/detail/private_thread.hpp"
 #include "caf/detail/set_thread_name.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
@@ -45,11 +47,18 @@ bool blocking_actor::accept_one_cond::post() {
 
 blocking_actor::blocking_actor(actor_config& cfg)
   : super(cfg.add_flag(local_actor::is_blocking_flag)) {
-  // nop
+  mailbox_ = cfg.mbox_factory != nullptr ? cfg.mbox_factory->make(this)
+                                          : nullptr;
+  // Factories may return null for blocking actors to select the default.
+  if (mailbox_ == nullptr)
+    mailbox_ = new (&default_mailbox_) detail::default_mailbox();
 }
 
 blocking_actor::~blocking_actor() {
-  // avoid weak-vtables warning
+  if (mailbox_ == &default_mailbox_)
+    default_mailbox_.~default_mailbox();
+  else
+    mailbox_->deref_mailbox();
 }
 
 bool blocking_actor::enqueue(mailbox_element_ptr ptr, scheduler*) {
@@ -64,6 +73,7 @@ bool blocking_actor::enqueue(mailbox_element_ptr ptr, scheduler*) {
     ptr->set_enqueue_time();
     metrics_.mailbox_size->inc();
   }
+  CAF_ENQUEUED(this, *ptr);
   // returns false if mailbox has been closed
   switch (mailbox().push_back(std::move(ptr))) {
     case intrusive::inbox_result::queue_closed: {
@@ -90,7 +100,15 @@ bool blocking_actor::enqueue(mailbox_element_ptr ptr, scheduler*) {
 }
 
 mailbox_element* blocking_actor::peek_at_next_mailbox_element() {
-  return mailbox_.peek(make_message_id());
+  return mailbox().peek(make_message_id());
+}
+
+size_t blocking_actor::mailbox_size_hint() const noexcept {
+  return mailbox_->size_hint();
+}
+
+void blocking_actor::enable_mailbox_size_hint() noexcept {
+  mailbox_->enable_size_hint();
 }
 
 const char* blocking_actor::name() const {
@@ -258,6 +276,7 @@ void blocking_actor::receive_impl(receive_cond& rcc, message_id mid,
     }
     // Fetch next message from our mailbox.
     auto ptr = mailbox().pop_front();
+    CAF_DEQUEUED(this, *ptr);
     auto t0 = std::chrono::steady_clock::now();
     auto mbox_time = ptr->seconds_until(t0);
     // Skip messages that don't match our message ID.
@@ -279,7 +298,14 @@ void blocking_actor::receive_impl(receive_cond& rcc, message_id mid,
     auto g = detail::scope_guard{
       [&]() noexcept { current_element_ = prev_element; }};
     // Dispatch on the current mailbox element.
-    if (consume()) {
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+    trace_context::guard trace_guard{ptr->trace};
+#endif
+    CAF_BEFORE_PROCESSING(this, *ptr);
+    auto consumed = consume();
+    CAF_AFTER_PROCESSING(this, consumed ? invoke_message_result::consumed
+                                        : invoke_message_result::skipped);
+    if (consumed) {
       unstash();
       CAF_LOG_FINALIZE_EVENT();
       if (getf(abstract_actor::collects_metrics_flag)) {
@@ -372,9 +398,9 @@ void blocking_actor::unstash() {
 }
 
 void blocking_actor::close_mailbox(const error& reason) {
-  if (!mailbox_.closed()) {
+  if (!mailbox().closed()) {
     unstash();
-    auto dropped = mailbox_.close(reason);
+    auto dropped = mailbox().close(reason);
     if (dropped > 0 && metrics_.mailbox_size)
       metrics_.mailbox_size->dec(static_cast<int64_t>(dropped));
   }
@@ -168,6 +168,10 @@ public:
 
   mailbox_element* peek_at_next_mailbox_element() override;
 
+  size_t mailbox_size_hint() const noexcept override;
+
+  void enable_mailbox_size_hint() noexcept override;
+
   // -- overridden functions of local_actor ------------------------------------
 
   const char* name() const override;
@@ -317,7 +321,7 @@ public:
 
   /// Returns the queue for storing incoming messages.
   abstract_mailbox& mailbox() {
-    return mailbox_;
+    return *mailbox_;
   }
   /// @cond PRIVATE
 
@@ -363,7 +367,7 @@ public:
   }
 
   bool has_next_message() {
-    return !mailbox_.empty();
+    return !mailbox().empty();
   }
 
   /// @endcond
@@ -401,10 +405,16 @@ private:
   // -- member variables -------------------------------------------------------
 
   /// Stores incoming messages.
-  detail::default_mailbox mailbox_;
+  abstract_mailbox* mailbox_;
 
   /// Stashes skipped messages until the actor processes the next message.
   intrusive::stack<mailbox_element> stash_;
+
+  union {
+    /// The default mailbox instance that we use if the user does not configure
+    /// a mailbox via the ::actor_config.
+    detail::default_mailbox default_mailbox_;
+  };
 };
 
 } // namespace caf
@@ -95,6 +95,9 @@ namespace caf::defaults::scheduler {
 
 constexpr auto policy = std::string_view{"stealing"};
 constexpr auto max_throughput = std::numeric_limits<size_t>::max();
+constexpr auto latency_weight = size_t{4};
+constexpr auto normal_weight = size_t{2};
+constexpr auto batch_weight = size_t{1};
 
 } // namespace caf::defaults::scheduler
 
@@ -107,6 +110,9 @@ constexpr auto moderate_steal_interval = size_t{5};
 constexpr auto moderate_sleep_duration = timespan{50'000};
 constexpr auto relaxed_steal_interval = size_t{1};
 constexpr auto relaxed_sleep_duration = timespan{10'000'000};
+constexpr auto topology_aware = false;
+constexpr auto pin_workers = true;
+constexpr auto remote_steal_threshold = size_t{4};
 
 } // namespace caf::defaults::work_stealing
 
@@ -130,10 +136,12 @@ namespace caf::defaults::middleman {
 constexpr auto app_identifier = std::string_view{"generic-caf-app"};
 constexpr auto cached_udp_buffers = size_t{10};
 constexpr auto connection_timeout = timespan{30'000'000'000};
+constexpr auto enable_shared_memory = true;
 constexpr auto heartbeat_interval = timespan{10'000'000'000};
 constexpr auto max_consecutive_reads = size_t{50};
 constexpr auto max_pending_msgs = size_t{10};
 constexpr auto network_backend = std::string_view{"default"};
+constexpr auto shared_memory_ring_size = size_t{1024 * 1024};
 
 } // namespace caf::defaults::middleman
 
@@ -174,4 +182,43 @@ constexpr auto https_default_port = uint16_t{443};
 /// The default buffer size for reading and writing octet streams.
 constexpr auto octet_stream_buffer_size = uint32_t{1024};
 
+/// Configures how many requests an HTTP client may send over a pooled
+/// connection before receiving a response. The default disables pipelining.
+constexpr auto http_client_max_pipelined_requests = size_t{1};
+
+/// Configures how long pooled HTTP client connections may remain idle before
+/// the pool closes them.
+constexpr auto http_client_max_idle_time = timespan{30'000'000'000};
+
+/// Configures how many idle connections the HTTP client connection pool keeps
+/// open per endpoint.
+constexpr auto http_client_max_idle_connections = size_t{8};
+
+/// Configures how many client sessions an SSL context keeps for resuming
+/// connections to previously visited peers.
+constexpr auto ssl_session_cache_size = size_t{1024};
+
+/// Configures how long SSL sessions remain valid for resumption.
+constexpr auto ssl_session_timeout = timespan{7'200'000'000'000};
+
+/// Configures how much memory zlib may allocate per WebSocket connection for
+/// the permessage-deflate extension. The default is large enough for using the
+/// maximum window size in both directions.
+constexpr auto web_socket_deflate_max_memory = size_t{320 * 1024};
+
+/// Configures the minimum size for compressing outgoing WebSocket messages.
+/// Smaller messages usually grow when compressing them.
+constexpr auto web_socket_deflate_min_message_size = size_t{64};
+
+/// Configures the maximum size of a WebSocket message after decompressing it.
+constexpr auto web_socket_deflate_max_message_size = size_t{64 * 1024 * 1024};
+
+/// Configures how many bytes the length-prefix framing coalesces at most
+/// before writing them to the transport.
+constexpr auto lp_write_coalescing_max_bytes = size_t{16 * 1024};
+
+/// Configures the minimum size for passing length-prefixed messages to the
+/// transport without copying them into the output buffer.
+constexpr auto lp_zero_copy_threshold = size_t{64 * 1024};
+
 } // namespace caf::defaults::net
@@ -0,0 +1,246 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/actor_storage_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace caf::detail {
+
+namespace {
+
+struct node {
+  node* next;
+};
+
+/// Generates unique IDs for all pools.
+std::atomic<size_t> next_pool_id;
+
+} // namespace
+
+// -- shared state -------------------------------------------------------------
+
+struct actor_storage_pool::shared_state {
+  shared_state(size_t block_size, size_t alignment, size_t max_cached)
+    : block_size(std::max(block_size, sizeof(node))),
+      alignment(std::max(alignment, alignof(node))),
+      max_cached(max_cached) {
+    // nop
+  }
+
+  ~shared_state() {
+    while (head != nullptr) {
+      auto next = head->next;
+      deallocate_block(head);
+      head = next;
+    }
+  }
+
+  void* allocate_block() {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      return ::operator new(block_size, std::align_val_t{alignment});
+    return ::operator new(block_size);
+  }
+
+  void deallocate_block(void* ptr) noexcept {
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+      ::operator delete(ptr, std::align_val_t{alignment});
+    else
+      ::operator delete(ptr);
+  }
+
+  /// Moves up to `n` blocks from the list starting at `first` to the shared
+  /// free list and deallocates blocks that exceed its capacity. Returns the
+  /// remainder of the list.
+  node* put(node* first, size_t n) noexcept {
+    std::unique_lock guard{mtx};
+    while (first != nullptr && n-- > 0) {
+      auto next = first->next;
+      if (size < max_cached) {
+        first->next = head;
+        head = first;
+        ++size;
+      } else {
+        deallocate_block(first);
+      }
+      first = next;
+    }
+    return first;
+  }
+
+  size_t block_size;
+
+  size_t alignment;
+
+  size_t max_cached;
+
+  std::mutex mtx;
+
+  node* head = nullptr;
+
+  size_t size = 0;
+};
+
+// -- thread caches ------------------------------------------------------------
+
+struct actor_storage_pool::thread_cache {
+  /// Returns all cached blocks to the shared free list.
+  void flush() noexcept {
+    if (head != nullptr) {
+      state->put(head, size);
+      head = nullptr;
+      size = 0;
+    }
+  }
+
+  std::shared_ptr<shared_state> state;
+
+  node* head = nullptr;
+
+  size_t size = 0;
+};
+
+namespace {
+
+enum class cache_status { uninitialized, alive, destroyed };
+
+// Note: trivially destructible, i.e., remains valid while the thread destroys
+//       its thread-local objects.
+thread_local cache_status tl_status = cache_status::uninitialized;
+
+struct thread_caches {
+  thread_caches() {
+    tl_status = cache_status::alive;
+  }
+
+  ~thread_caches() {
+    for (auto& entry : entries)
+      if (entry.state != nullptr)
+        entry.flush();
+    tl_status = cache_status::destroyed;
+  }
+
+  static thread_caches* get() {
+    // Actors may get destroyed after the thread-local storage of their thread,
+    // e.g., during static destruction. Those fall back to the shared list.
+    if (tl_status == cache_status::destroyed)
+      return nullptr;
+    thread_local thread_caches instance;
+    return &instance;
+  }
+
+  std::vector<actor_storage_pool::thread_cache> entries;
+};
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+actor_storage_pool::actor_storage_pool(size_t block_size, size_t alignment,
+                                       size_t max_cached,
+                                       size_t thread_cache_size)
+  : id_(next_pool_id++),
+    thread_cache_size_(thread_cache_size),
+    shared_(std::make_shared<shared_state>(block_size, alignment,
+                                           max_cached)) {
+  // nop
+}
+
+actor_storage_pool::~actor_storage_pool() {
+  // Other threads release their cache when terminating.
+  if (auto* cache = local_cache()) {
+    cache->flush();
+    cache->state = nullptr;
+  }
+}
+
+// -- allocation ---------------------------------------------------------------
+
+void* actor_storage_pool::allocate() {
+  auto* cache = local_cache();
+  if (cache == nullptr) {
+    std::unique_lock guard{shared_->mtx};
+    if (auto* result = shared_->head) {
+      shared_->head = result->next;
+      --shared_->size;
+      return result;
+    }
+    guard.unlock();
+    return shared_->allocate_block();
+  }
+  if (cache->head == nullptr) {
+    // Refill half of the thread cache in a single critical section.
+    auto n = std::max(thread_cache_size_ / 2, size_t{1});
+    std::unique_lock guard{shared_->mtx};
+    while (shared_->head != nullptr && n-- > 0) {
+      auto* ptr = shared_->head;
+      shared_->head = ptr->next;
+      --shared_->size;
+      ptr->next = cache->head;
+      cache->head = ptr;
+      ++cache->size;
+    }
+  }
+  if (auto* result = cache->head) {
+    cache->head = result->next;
+    --cache->size;
+    return result;
+  }
+  return shared_->allocate_block();
+}
+
+void actor_storage_pool::deallocate(void* ptr) noexcept {
+  if (ptr == nullptr)
+    return;
+  auto* cache = local_cache();
+  if (cache == nullptr) {
+    shared_->put(new (ptr) node{nullptr}, 1);
+    return;
+  }
+  if (cache->size >= thread_cache_size_) {
+    // Move half of the thread cache to the shared list in a single critical
+    // section.
+    auto n = std::max(thread_cache_size_ / 2, size_t{1});
+    cache->head = shared_->put(cache->head, n);
+    cache->size -= n;
+  }
+  cache->head = new (ptr) node{cache->head};
+  ++cache->size;
+}
+
+// -- properties ---------------------------------------------------------------
+
+size_t actor_storage_pool::cached() const noexcept {
+  size_t result = 0;
+  if (thread_cache_size_ > 0 && tl_status == cache_status::alive) {
+    auto& entries = thread_caches::get()->entries;
+    if (id_ < entries.size())
+      result += entries[id_].size;
+  }
+  std::unique_lock guard{shared_->mtx};
+  return result + shared_->size;
+}
+
+// -- implementation details ---------------------------------------------------
+
+actor_storage_pool::thread_cache* actor_storage_pool::local_cache() noexcept {
+  if (thread_cache_size_ == 0)
+    return nullptr;
+  auto* caches = thread_caches::get();
+  if (caches == nullptr)
+    return nullptr;
+  auto& entries = caches->entries;
+  if (id_ >= entries.size())
+    entries.resize(id_ + 1);
+  auto& result = entries[id_];
+  if (result.state == nullptr)
+    result.state = shared_;
+  return &result;
+}
+
+} // namespace caf::detail
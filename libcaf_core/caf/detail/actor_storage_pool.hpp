@@ -0,0 +1,93 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace caf::detail {
+
+/// A free list for memory blocks of fixed size and alignment. Each thread
+/// caches up to `thread_cache_size` released blocks without any
+/// synchronization. Threads exchange blocks in batches with a shared free list
+/// that holds up to `max_cached` blocks and only takes a lock when a thread
+/// cache runs empty or overflows.
+class CAF_CORE_EXPORT actor_storage_pool {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// The default number of blocks that the shared free list caches at most.
+  static constexpr size_t default_max_cached = 64;
+
+  /// The default number of blocks that each thread caches at most.
+  static constexpr size_t default_thread_cache_size = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// @param block_size The size of each memory block.
+  /// @param alignment The alignment of each memory block.
+  /// @param max_cached The capacity of the shared free list.
+  /// @param thread_cache_size The capacity of each thread cache. Passing 0
+  ///                          disables thread caches.
+  actor_storage_pool(size_t block_size, size_t alignment,
+                     size_t max_cached = default_max_cached,
+                     size_t thread_cache_size = default_thread_cache_size);
+
+  actor_storage_pool(const actor_storage_pool&) = delete;
+
+  actor_storage_pool& operator=(const actor_storage_pool&) = delete;
+
+  ~actor_storage_pool();
+
+  // -- allocation -------------------------------------------------------------
+
+  /// Returns a memory block from the free lists or allocates a new one.
+  void* allocate();
+
+  /// Puts `ptr` back to the free lists or deallocates it if the free lists
+  /// have reached their maximum size.
+  void deallocate(void* ptr) noexcept;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of blocks in the shared free list plus the number of
+  /// blocks in the cache of the calling thread.
+  size_t cached() const noexcept;
+
+  // -- factory functions ------------------------------------------------------
+
+  /// Returns the pool for `T`. The pool is never destroyed to make sure that
+  /// actors released during static destruction still find a valid pool.
+  template <class T>
+  static actor_storage_pool& instance() {
+    static auto* ptr = new actor_storage_pool(sizeof(T), alignof(T));
+    return *ptr;
+  }
+
+  // -- implementation details -------------------------------------------------
+
+  struct shared_state;
+
+  struct thread_cache;
+
+private:
+  /// Returns the cache of the calling thread or `nullptr` if thread caches
+  /// are disabled or the calling thread has already destroyed its caches.
+  thread_cache* local_cache() noexcept;
+
+  /// Identifies the cache of this pool in the thread-local storage.
+  size_t id_;
+
+  /// Configures the capacity of each thread cache.
+  size_t thread_cache_size_;
+
+  /// Stores the shared free list. Thread caches keep the state alive until
+  /// their thread terminates, since they may outlive the pool.
+  std::shared_ptr<shared_state> shared_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,134 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/actor_storage_pool.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/actor_storage.hpp"
+#include "caf/event_based_actor.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+struct alignas(64) aligned_block {
+  char data[100];
+};
+
+TEST("released blocks are re-used by the next allocation") {
+  detail::actor_storage_pool uut{100, alignof(std::max_align_t)};
+  auto* ptr1 = uut.allocate();
+  check_eq(uut.cached(), 0u);
+  uut.deallocate(ptr1);
+  check_eq(uut.cached(), 1u);
+  auto* ptr2 = uut.allocate();
+  check_eq(ptr1, ptr2);
+  check_eq(uut.cached(), 0u);
+  uut.deallocate(ptr2);
+}
+
+TEST("the pool caches no more than max_cached blocks") {
+  // Disable the thread cache to only use the shared free list.
+  detail::actor_storage_pool uut{100, alignof(std::max_align_t), 2, 0};
+  std::vector<void*> blocks;
+  for (int i = 0; i < 4; ++i)
+    blocks.push_back(uut.allocate());
+  for (auto* ptr : blocks)
+    uut.deallocate(ptr);
+  check_eq(uut.cached(), 2u);
+}
+
+TEST("thread caches spill over to the shared free list") {
+  detail::actor_storage_pool uut{100, alignof(std::max_align_t), 2, 4};
+  std::vector<void*> blocks;
+  for (int i = 0; i < 10; ++i)
+    blocks.push_back(uut.allocate());
+  for (auto* ptr : blocks)
+    uut.deallocate(ptr);
+  // At most 4 blocks in the thread cache plus 2 blocks in the shared list.
+  check_le(uut.cached(), 6u);
+  check_ge(uut.cached(), 4u);
+  // Draining the thread cache refills it from the shared list.
+  blocks.clear();
+  for (int i = 0; i < 10; ++i)
+    blocks.push_back(uut.allocate());
+  check_eq(uut.cached(), 0u);
+  for (auto* ptr : blocks)
+    uut.deallocate(ptr);
+}
+
+TEST("threads may release blocks allocated by other threads") {
+  detail::actor_storage_pool uut{100, alignof(std::max_align_t), 8, 4};
+  constexpr size_t num_threads = 4;
+  constexpr size_t num_blocks = 1000;
+  std::vector<std::vector<void*>> blocks(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i)
+    threads.emplace_back([&uut, &blocks, i] {
+      for (size_t j = 0; j < num_blocks; ++j)
+        blocks[i].push_back(uut.allocate());
+    });
+  for (auto& hdl : threads)
+    hdl.join();
+  threads.clear();
+  // Each thread releases the blocks of its neighbor.
+  for (size_t i = 0; i < num_threads; ++i)
+    threads.emplace_back([&uut, &blocks, i] {
+      for (auto* ptr : blocks[(i + 1) % num_threads])
+        uut.deallocate(ptr);
+    });
+  for (auto& hdl : threads)
+    hdl.join();
+  // Terminated threads have flushed their caches to the shared list.
+  check_eq(uut.cached(), 8u);
+}
+
+TEST("the pool respects the alignment of its blocks") {
+  detail::actor_storage_pool uut{sizeof(aligned_block), alignof(aligned_block)};
+  std::vector<void*> blocks;
+  for (int i = 0; i < 4; ++i) {
+    auto* ptr = uut.allocate();
+    check_eq(reinterpret_cast<uintptr_t>(ptr) % alignof(aligned_block), 0u);
+    blocks.push_back(ptr);
+  }
+  for (auto* ptr : blocks)
+    uut.deallocate(ptr);
+}
+
+class dummy_actor : public event_based_actor {
+public:
+  using event_based_actor::event_based_actor;
+
+  behavior make_behavior() override {
+    return {
+      [this](int) { quit(); },
+    };
+  }
+};
+
+WITH_FIXTURE(test::fixture::deterministic) {
+
+TEST("terminated actors return their storage to the pool of their type") {
+  using storage_type = actor_storage<dummy_actor>;
+  auto& pool = detail::actor_storage_pool::instance<storage_type>();
+  auto before = pool.cached();
+  {
+    auto hdl = sys.spawn<dummy_actor>();
+    inject().with(42).to(hdl);
+  }
+  check_eq(pool.cached(), before + 1);
+  auto hdl = sys.spawn<dummy_actor>();
+  check_eq(pool.cached(), before);
+  inject().with(42).to(hdl);
+}
+
+} // WITH_FIXTURE(test::fixture::deterministic)
+
+} // namespace
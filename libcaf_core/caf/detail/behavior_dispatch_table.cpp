@@ -0,0 +1,59 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/behavior_dispatch_table.hpp"
+
+#include <cstdint>
+
+namespace caf::detail {
+
+behavior_dispatch_table::behavior_dispatch_table(
+  span<const type_id_list> handlers) {
+  // Keep the load factor at or below 50% to keep probe sequences short.
+  size_t capacity = 8;
+  while (capacity < handlers.size() * 2)
+    capacity *= 2;
+  keys_.resize(capacity, type_id_list{nullptr});
+  values_.resize(capacity, npos);
+  mask_ = capacity - 1;
+  for (size_t pos = 0; pos < handlers.size(); ++pos) {
+    auto types = handlers[pos];
+    if (!types) {
+      catch_all_.push_back(pos);
+      continue;
+    }
+    for (auto slot = hash(types) & mask_;; slot = (slot + 1) & mask_) {
+      if (!keys_[slot]) {
+        keys_[slot] = types;
+        values_[slot] = pos;
+        break;
+      }
+      // The first handler for a set of input types shadows all others.
+      if (keys_[slot] == types)
+        break;
+    }
+  }
+}
+
+size_t behavior_dispatch_table::find(type_id_list types) const noexcept {
+  for (auto slot = hash(types) & mask_;; slot = (slot + 1) & mask_) {
+    auto key = keys_[slot];
+    if (!key)
+      return npos;
+    if (key.data() == types.data() || key == types)
+      return values_[slot];
+  }
+}
+
+size_t behavior_dispatch_table::hash(type_id_list types) noexcept {
+  // FNV-1a over the size and all type IDs.
+  constexpr uint64_t prime = 0x100000001b3ull;
+  uint64_t result = 0xcbf29ce484222325ull;
+  result = (result ^ types.size()) * prime;
+  for (auto id : types)
+    result = (result ^ id) * prime;
+  return static_cast<size_t>(result);
+}
+
+} // namespace caf::detail
@@ -0,0 +1,65 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/span.hpp"
+#include "caf/type_id_list.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace caf::detail {
+
+/// Maps the input types of message handlers to their position in a behavior.
+/// Allows behaviors with many handlers to select the matching handler with a
+/// single hash table lookup instead of trying each handler in sequence.
+class CAF_CORE_EXPORT behavior_dispatch_table {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Signals that no handler matches the input types.
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Constructs a table from the input types of all handlers in declaration
+  /// order. Catch-all handlers have a `nullptr` type ID list.
+  explicit behavior_dispatch_table(span<const type_id_list> handlers);
+
+  behavior_dispatch_table(const behavior_dispatch_table&) = delete;
+
+  behavior_dispatch_table& operator=(const behavior_dispatch_table&) = delete;
+
+  // -- lookups ----------------------------------------------------------------
+
+  /// Returns the position of the first handler that accepts `types` or `npos`
+  /// if no handler except catch-all handlers accepts `types`.
+  size_t find(type_id_list types) const noexcept;
+
+  /// Returns the positions of all catch-all handlers in ascending order.
+  span<const size_t> catch_all_handlers() const noexcept {
+    return {catch_all_.data(), catch_all_.size()};
+  }
+
+private:
+  static size_t hash(type_id_list types) noexcept;
+
+  /// Stores the keys of the open-addressing hash table. Empty slots contain a
+  /// `nullptr` type ID list.
+  std::vector<type_id_list> keys_;
+
+  /// Stores the handler position for each key.
+  std::vector<size_t> values_;
+
+  /// Bitmask for mapping a hash value to a slot in `keys_`.
+  size_t mask_ = 0;
+
+  /// Stores the positions of all catch-all handlers.
+  std::vector<size_t> catch_all_;
+};
+
+} // namespace caf::detail
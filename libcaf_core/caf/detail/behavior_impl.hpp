@@ -6,6 +6,7 @@
 
 #include "caf/const_typed_message_view.hpp"
 #include "caf/detail/apply_args.hpp"
+#include "caf/detail/behavior_dispatch_table.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/int_list.hpp"
 #include "caf/detail/invoke_result_visitor.hpp"
@@ -17,6 +18,7 @@
 #include "caf/ref_counted.hpp"
 #include "caf/response_promise.hpp"
 #include "caf/skip.hpp"
+#include "caf/span.hpp"
 #include "caf/timeout_definition.hpp"
 #include "caf/timespan.hpp"
 #include "caf/type_id.hpp"
@@ -105,69 +107,114 @@ public:
     // nop
   }
 
+  /// Behaviors with at least this many handlers select the matching handler
+  /// via a ::behavior_dispatch_table instead of trying each handler in order.
+  static constexpr size_t dispatch_table_threshold = 8;
+
   virtual bool invoke(detail::invoke_result_visitor& f, message& xs) override {
-    return invoke_impl(f, xs, std::make_index_sequence<sizeof...(Ts)>{});
+    std::make_index_sequence<sizeof...(Ts)> token;
+    if constexpr (sizeof...(Ts) >= dispatch_table_threshold)
+      return invoke_indexed(f, xs, token);
+    else
+      return invoke_impl(f, xs, token);
   }
 
   template <size_t... Is>
   bool invoke_impl(detail::invoke_result_visitor& f, message& msg,
                    std::index_sequence<Is...>) {
-    [[maybe_unused]] auto dispatch = [&](auto& fun) {
-      using fun_type = std::decay_t<decltype(fun)>;
-      using trait = get_callable_trait_t<fun_type>;
-      using fn_args = typename trait::arg_types;
-      using decayed_args = typename trait::decayed_arg_types;
-      if constexpr (std::is_same_v<decayed_args, type_list<message>>) {
-        using fun_result = decltype(fun(msg));
-        if (auto types = msg.types();
-            types.size() == 1 && is_system_message(types[0])) {
-          // The fallback handler must not consume system messages such as
-          // exit_msg. They must be handled explicitly by the actor or else use
-          // the hard-coded default.
-          return false;
-        }
+    return (dispatch(std::get<Is>(cases_), f, msg) || ...);
+  }
+
+  template <size_t... Is>
+  bool invoke_indexed(detail::invoke_result_visitor& f, message& msg,
+                      std::index_sequence<Is...>) {
+    using fn_type = bool (*)(default_behavior_impl*,
+                             detail::invoke_result_visitor&, message&);
+    static constexpr fn_type fns[] = {&invoke_at<Is>...};
+    static const type_id_list types[] = {input_types<Ts>()...};
+    static const behavior_dispatch_table tbl{make_span(types)};
+    // Catch-all handlers that appear before the matching handler take
+    // precedence. A typed handler always accepts a message with matching
+    // types, so we never need to look at catch-all handlers that come after.
+    auto pos = tbl.find(msg.types());
+    for (auto index : tbl.catch_all_handlers()) {
+      if (index > pos)
+        break;
+      if (fns[index](this, f, msg))
+        return true;
+    }
+    return pos != behavior_dispatch_table::npos && fns[pos](this, f, msg);
+  }
+
+  template <size_t I>
+  static bool invoke_at(default_behavior_impl* self,
+                        detail::invoke_result_visitor& f, message& msg) {
+    return self->dispatch(std::get<I>(self->cases_), f, msg);
+  }
+
+  template <class Fun>
+  static type_id_list input_types() {
+    using trait = get_callable_trait_t<Fun>;
+    using decayed_args = typename trait::decayed_arg_types;
+    if constexpr (std::is_same_v<decayed_args, type_list<message>>)
+      return type_id_list{nullptr};
+    else
+      return to_type_id_list<decayed_args>();
+  }
+
+  template <class Fun>
+  bool dispatch(Fun& fun, detail::invoke_result_visitor& f, message& msg) {
+    using trait = get_callable_trait_t<Fun>;
+    using fn_args = typename trait::arg_types;
+    using decayed_args = typename trait::decayed_arg_types;
+    if constexpr (std::is_same_v<decayed_args, type_list<message>>) {
+      using fun_result = decltype(fun(msg));
+      if (auto types = msg.types();
+          types.size() == 1 && is_system_message(types[0])) {
+        // The fallback handler must not consume system messages such as
+        // exit_msg. They must be handled explicitly by the actor or else use
+        // the hard-coded default.
+        return false;
+      }
+      if constexpr (std::is_same_v<void, fun_result>) {
+        fun(msg);
+        f(unit);
+      } else {
+        auto invoke_res = fun(msg);
+        f(invoke_res);
+      }
+      return true;
+    } else {
+      using detail::apply_args_auto_move;
+      auto arg_types = to_type_id_list<decayed_args>();
+      if (arg_types != msg.types())
+        return false;
+      auto do_invoke = [&](auto& xs) {
+        using fun_result = decltype(detail::apply_args(fun, xs));
+        auto token = detail::get_indices(xs);
         if constexpr (std::is_same_v<void, fun_result>) {
-          fun(msg);
+          apply_args_auto_move(fun, fn_args{}, token, xs);
           f(unit);
         } else {
-          auto invoke_res = fun(msg);
+          auto invoke_res = apply_args_auto_move(fun, fn_args{}, token, xs);
           f(invoke_res);
         }
-        return true;
-      } else {
-        using detail::apply_args_auto_move;
-        auto arg_types = to_type_id_list<decayed_args>();
-        if (arg_types != msg.types())
-          return false;
-        auto do_invoke = [&](auto& xs) {
-          using fun_result = decltype(detail::apply_args(fun, xs));
-          auto token = detail::get_indices(xs);
-          if constexpr (std::is_same_v<void, fun_result>) {
-            apply_args_auto_move(fun, fn_args{}, token, xs);
-            f(unit);
-          } else {
-            auto invoke_res = apply_args_auto_move(fun, fn_args{}, token, xs);
-            f(invoke_res);
-          }
-        };
-        using view_type = typename trait::message_view_type;
-        // If we have the only reference to a message, we can safely modify it
-        // in place, i.e., use the mutable view type and move values from the
-        // message to the function arguments.
-        if constexpr (view_type::is_const) {
-          if (msg.unique()) {
-            typename trait::mutable_message_view_type xs{msg};
-            do_invoke(xs);
-            return true;
-          }
+      };
+      using view_type = typename trait::message_view_type;
+      // If we have the only reference to a message, we can safely modify it
+      // in place, i.e., use the mutable view type and move values from the
+      // message to the function arguments.
+      if constexpr (view_type::is_const) {
+        if (msg.unique()) {
+          typename trait::mutable_message_view_type xs{msg};
+          do_invoke(xs);
+          return true;
         }
-        view_type xs{msg};
-        do_invoke(xs);
-        return true;
       }
-      return false;
-    };
-    return (dispatch(std::get<Is>(cases_)) || ...);
+      view_type xs{msg};
+      do_invoke(xs);
+      return true;
+    }
   }
 
   void handle_timeout() override {
@@ -0,0 +1,242 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/bounded_mailbox.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/detail/sync_request_bouncer.hpp"
+#include "caf/error.hpp"
+#include "caf/local_actor.hpp"
+#include "caf/message_id.hpp"
+#include "caf/sec.hpp"
+
+namespace caf::detail {
+
+bounded_mailbox::bounded_mailbox(local_actor* owner, size_t capacity,
+                                 mailbox_overflow_policy policy) noexcept
+  : owner_(owner),
+    dropped_messages_(nullptr),
+    capacity_(capacity > 0 ? capacity : 1),
+    policy_(policy),
+    size_(0),
+    dropped_(0),
+    closed_(false),
+    waiting_(0),
+    ref_count_(1) {
+  if (owner_ != nullptr)
+    dropped_messages_ = owner_->home_system().base_metrics().dropped_messages;
+}
+
+mailbox_element* bounded_mailbox::peek(message_id id) {
+  if (auto* result = impl_.peek(id))
+    return result;
+  if (policy_ != mailbox_overflow_policy::drop_oldest || !id.is_async())
+    return nullptr;
+  std::unique_lock guard{mtx_};
+  return queue_.empty() ? nullptr : queue_.front();
+}
+
+intrusive::inbox_result bounded_mailbox::push_back(mailbox_element_ptr ptr) {
+  if (!is_bounded(*ptr))
+    return impl_.push_back(std::move(ptr));
+  switch (policy_) {
+    case mailbox_overflow_policy::drop_oldest:
+      return push_back_evicting(std::move(ptr));
+    case mailbox_overflow_policy::block:
+      if (may_block(*ptr)) {
+        if (!reserve_blocking())
+          return impl_.push_back(std::move(ptr)); // Reports queue_closed.
+        break;
+      }
+      [[fallthrough]];
+    default: // drop_newest or reject
+      if (!try_reserve()) {
+        drop(std::move(ptr), policy_ != mailbox_overflow_policy::drop_newest);
+        return intrusive::inbox_result::success;
+      }
+  }
+  return impl_.push_back(std::move(ptr));
+}
+
+void bounded_mailbox::push_front(mailbox_element_ptr ptr) {
+  if (!is_bounded(*ptr)) {
+    impl_.push_front(std::move(ptr));
+    return;
+  }
+  ++size_;
+  if (policy_ == mailbox_overflow_policy::drop_oldest) {
+    std::unique_lock guard{mtx_};
+    queue_.push_front(ptr.release());
+    return;
+  }
+  impl_.push_front(std::move(ptr));
+}
+
+mailbox_element_ptr bounded_mailbox::pop_front() {
+  auto ptr = impl_.pop_front();
+  if (policy_ == mailbox_overflow_policy::drop_oldest) {
+    if (ptr != nullptr)
+      return ptr;
+    std::unique_lock guard{mtx_};
+    ptr = queue_.pop_front();
+    if (ptr != nullptr)
+      --size_;
+    return ptr;
+  }
+  if (ptr != nullptr && is_bounded(*ptr))
+    release();
+  return ptr;
+}
+
+bool bounded_mailbox::closed() const noexcept {
+  return impl_.closed();
+}
+
+bool bounded_mailbox::blocked() const noexcept {
+  return impl_.blocked();
+}
+
+bool bounded_mailbox::try_block() {
+  if (policy_ != mailbox_overflow_policy::drop_oldest)
+    return impl_.try_block();
+  // Senders call try_unblock while holding the lock. Hence, checking `queue_`
+  // and blocking must happen atomically to avoid missing a wakeup.
+  std::unique_lock guard{mtx_};
+  return queue_.empty() && impl_.try_block();
+}
+
+bool bounded_mailbox::try_unblock() {
+  return impl_.try_unblock();
+}
+
+size_t bounded_mailbox::close(const error& reason) {
+  size_t result = 0;
+  {
+    std::unique_lock guard{mtx_};
+    closed_ = true;
+    cv_.notify_all();
+    detail::sync_request_bouncer bounce{reason};
+    queue_.drain([&bounce, &result](mailbox_element* ptr) {
+      bounce(*ptr);
+      delete ptr;
+      ++result;
+    });
+  }
+  result += impl_.close(reason);
+  size_ = 0;
+  return result;
+}
+
+size_t bounded_mailbox::size() {
+  auto result = impl_.size();
+  if (policy_ == mailbox_overflow_policy::drop_oldest) {
+    std::unique_lock guard{mtx_};
+    result += queue_.size();
+  }
+  return result;
+}
+
+size_t bounded_mailbox::size_hint() const noexcept {
+  if (!impl_.size_hint_enabled())
+    return 0;
+  if (policy_ == mailbox_overflow_policy::drop_oldest)
+    return impl_.size_hint() + size_.load();
+  return impl_.size_hint();
+}
+
+void bounded_mailbox::enable_size_hint() noexcept {
+  impl_.enable_size_hint();
+}
+
+void bounded_mailbox::ref_mailbox() noexcept {
+  ++ref_count_;
+}
+
+void bounded_mailbox::deref_mailbox() noexcept {
+  if (--ref_count_ == 0)
+    delete this;
+}
+
+bool bounded_mailbox::is_bounded(const mailbox_element& x) noexcept {
+  return !x.mid.is_urgent_message() && !x.mid.is_response();
+}
+
+bool bounded_mailbox::may_block(const mailbox_element& x) noexcept {
+  if (!x.sender)
+    return false;
+  auto* src = x.sender->get();
+  return src->getf(abstract_actor::is_blocking_flag)
+         || src->getf(abstract_actor::is_detached_flag);
+}
+
+bool bounded_mailbox::try_reserve() noexcept {
+  auto n = size_.load();
+  while (n < capacity_)
+    if (size_.compare_exchange_weak(n, n + 1))
+      return true;
+  return false;
+}
+
+void bounded_mailbox::release() noexcept {
+  --size_;
+  if (waiting_.load() > 0) {
+    std::unique_lock guard{mtx_};
+    cv_.notify_one();
+  }
+}
+
+bool bounded_mailbox::reserve_blocking() {
+  if (try_reserve())
+    return true;
+  std::unique_lock guard{mtx_};
+  ++waiting_;
+  for (;;) {
+    if (try_reserve()) {
+      --waiting_;
+      return true;
+    }
+    if (closed_.load()) {
+      --waiting_;
+      return false;
+    }
+    cv_.wait(guard);
+  }
+}
+
+intrusive::inbox_result
+bounded_mailbox::push_back_evicting(mailbox_element_ptr ptr) {
+  mailbox_element_ptr evicted;
+  auto result = intrusive::inbox_result::success;
+  {
+    std::unique_lock guard{mtx_};
+    if (closed_.load())
+      return intrusive::inbox_result::queue_closed;
+    if (queue_.size() >= capacity_)
+      evicted = queue_.pop_front();
+    else
+      ++size_;
+    queue_.push_back(ptr.release());
+    if (impl_.try_unblock())
+      result = intrusive::inbox_result::unblocked_reader;
+  }
+  if (evicted != nullptr)
+    drop(std::move(evicted), false);
+  return result;
+}
+
+void bounded_mailbox::drop(mailbox_element_ptr ptr, bool reject) {
+  ++dropped_;
+  if (dropped_messages_ != nullptr)
+    dropped_messages_->inc();
+  if (owner_ != nullptr) {
+    if (auto* gauge = owner_->builtin_metrics().mailbox_size)
+      gauge->dec();
+  }
+  if (reject) {
+    sync_request_bouncer bounce{make_error(sec::mailbox_full)};
+    bounce(*ptr);
+  }
+}
+
+} // namespace caf::detail
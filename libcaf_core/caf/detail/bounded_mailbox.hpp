@@ -0,0 +1,158 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/abstract_mailbox.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/default_mailbox.hpp"
+#include "caf/intrusive/linked_list.hpp"
+#include "caf/mailbox_overflow_policy.hpp"
+#include "caf/telemetry/counter.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace caf::detail {
+
+/// A mailbox with a fixed capacity for asynchronous messages and requests.
+/// Urgent messages and responses bypass the limit, because dropping them would
+/// break system messages or leave pending requests unanswered.
+///
+/// Uses a ::default_mailbox for storing the messages and tracks the number of
+/// bounded messages separately in an atomic counter, i.e., senders never touch
+/// the queues of the owner. The only exception is the `drop_oldest` policy:
+/// senders must evict the oldest message when enqueueing into a full mailbox,
+/// so this policy stores bounded messages in a separate queue that senders and
+/// owner access under a mutex.
+class CAF_CORE_EXPORT bounded_mailbox : public abstract_mailbox {
+public:
+  /// @param owner The actor that owns this mailbox. May be `nullptr`.
+  /// @param capacity The maximum number of bounded messages in the mailbox.
+  /// @param policy Selects what happens to messages when the mailbox is full.
+  bounded_mailbox(local_actor* owner, size_t capacity,
+                  mailbox_overflow_policy policy) noexcept;
+
+  bounded_mailbox(const bounded_mailbox&) = delete;
+
+  bounded_mailbox& operator=(const bounded_mailbox&) = delete;
+
+  mailbox_element* peek(message_id id) override;
+
+  intrusive::inbox_result push_back(mailbox_element_ptr ptr) override;
+
+  void push_front(mailbox_element_ptr ptr) override;
+
+  mailbox_element_ptr pop_front() override;
+
+  bool closed() const noexcept override;
+
+  bool blocked() const noexcept override;
+
+  bool try_block() override;
+
+  bool try_unblock() override;
+
+  size_t close(const error& reason) override;
+
+  size_t size() override;
+
+  size_t size_hint() const noexcept override;
+
+  void enable_size_hint() noexcept override;
+
+  void ref_mailbox() noexcept override;
+
+  void deref_mailbox() noexcept override;
+
+  /// Returns the maximum number of bounded messages in the mailbox.
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  /// Returns the configured overflow policy.
+  mailbox_overflow_policy policy() const noexcept {
+    return policy_;
+  }
+
+  /// Returns the number of messages that this mailbox has dropped so far.
+  size_t dropped() const noexcept {
+    return dropped_.load();
+  }
+
+  /// Returns the number of senders that currently wait for free capacity.
+  size_t waiting_senders() const noexcept {
+    return waiting_.load();
+  }
+
+private:
+  /// Checks whether `x` counts towards the capacity of the mailbox.
+  static bool is_bounded(const mailbox_element& x) noexcept;
+
+  /// Checks whether the sender of `x` may block until the mailbox has free
+  /// capacity.
+  static bool may_block(const mailbox_element& x) noexcept;
+
+  /// Tries to reserve a slot for a new message.
+  bool try_reserve() noexcept;
+
+  /// Releases a previously reserved slot and wakes up blocked senders.
+  void release() noexcept;
+
+  /// Waits until the mailbox has free capacity or the owner closes it.
+  /// @returns `true` if a slot has been reserved, `false` if the mailbox has
+  ///          been closed.
+  bool reserve_blocking();
+
+  /// Discards `ptr` and bounces it to the sender if `reject` is true.
+  void drop(mailbox_element_ptr ptr, bool reject);
+
+  /// Enqueues `ptr` to `queue_` and evicts the oldest message if the mailbox
+  /// is full. Implements `push_back` for the `drop_oldest` policy.
+  intrusive::inbox_result push_back_evicting(mailbox_element_ptr ptr);
+
+  /// Stores the messages.
+  default_mailbox impl_;
+
+  /// Points to the owning actor for updating its metrics.
+  local_actor* owner_;
+
+  /// Counts dropped messages system-wide.
+  telemetry::int_counter* dropped_messages_;
+
+  /// The maximum number of bounded messages.
+  size_t capacity_;
+
+  /// Selects what happens to messages when the mailbox is full.
+  mailbox_overflow_policy policy_;
+
+  /// Number of bounded messages currently stored in the mailbox.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> size_;
+
+  /// Counts how many messages this mailbox has dropped.
+  std::atomic<size_t> dropped_;
+
+  /// Signals whether the owner has closed the mailbox.
+  std::atomic<bool> closed_;
+
+  /// Number of senders that currently wait for free capacity.
+  std::atomic<size_t> waiting_;
+
+  /// Protects `cv_` for senders with the `block` policy and `queue_` for the
+  /// `drop_oldest` policy.
+  std::mutex mtx_;
+
+  /// Wakes up senders with the `block` policy.
+  std::condition_variable cv_;
+
+  /// Stores bounded messages in FIFO order for the `drop_oldest` policy.
+  intrusive::linked_list<mailbox_element> queue_;
+
+  /// The intrusive reference count.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> ref_count_;
+};
+
+} // namespace caf::detail
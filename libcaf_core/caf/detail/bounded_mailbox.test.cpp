@@ -0,0 +1,146 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/bounded_mailbox.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/sec.hpp"
+
+#include <thread>
+
+using namespace caf;
+
+namespace {
+
+using ires = intrusive::inbox_result;
+
+using policy = mailbox_overflow_policy;
+
+template <message_priority P = message_priority::normal>
+auto make_int_msg(int value) {
+  return make_mailbox_element(nullptr, make_message_id(P), make_message(value));
+}
+
+std::vector<int> drain(detail::bounded_mailbox& uut) {
+  std::vector<int> result;
+  for (auto ptr = uut.pop_front(); ptr != nullptr; ptr = uut.pop_front())
+    result.push_back(ptr->content().get_as<int>(0));
+  return result;
+}
+
+TEST("drop_newest discards messages once the mailbox is full") {
+  detail::bounded_mailbox uut{nullptr, 2, policy::drop_newest};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.push_back(make_int_msg(2)), ires::success);
+  check_eq(uut.push_back(make_int_msg(3)), ires::success);
+  check_eq(uut.dropped(), 1u);
+  check_eq(drain(uut), std::vector<int>{1, 2});
+  check_eq(uut.push_back(make_int_msg(4)), ires::success);
+  check_eq(drain(uut), std::vector<int>{4});
+}
+
+TEST("drop_oldest discards messages from the front of the mailbox") {
+  detail::bounded_mailbox uut{nullptr, 2, policy::drop_oldest};
+  for (int i = 1; i <= 5; ++i)
+    check_eq(uut.push_back(make_int_msg(i)), ires::success);
+  // Evicts at enqueue time, i.e., the mailbox never exceeds its capacity.
+  check_eq(uut.dropped(), 3u);
+  check_eq(uut.size(), 2u);
+  check_eq(drain(uut), std::vector<int>{4, 5});
+}
+
+TEST("drop_oldest keeps urgent messages and delivers them first") {
+  detail::bounded_mailbox uut{nullptr, 1, policy::drop_oldest};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.push_back(make_int_msg<message_priority::high>(2)),
+           ires::success);
+  check_eq(uut.push_back(make_int_msg(3)), ires::success);
+  check_eq(uut.dropped(), 1u);
+  check_eq(drain(uut), std::vector<int>{2, 3});
+}
+
+TEST("drop_oldest wakes up a blocked owner") {
+  detail::bounded_mailbox uut{nullptr, 1, policy::drop_oldest};
+  require(uut.try_block());
+  check_eq(uut.push_back(make_int_msg(1)), ires::unblocked_reader);
+  check(!uut.try_block());
+  check_eq(drain(uut), std::vector<int>{1});
+  check(uut.try_block());
+  uut.close(error{});
+}
+
+TEST("urgent messages do not count towards the capacity") {
+  detail::bounded_mailbox uut{nullptr, 1, policy::drop_newest};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.push_back(make_int_msg<message_priority::high>(2)),
+           ires::success);
+  check_eq(uut.push_back(make_int_msg<message_priority::high>(3)),
+           ires::success);
+  check_eq(uut.dropped(), 0u);
+  check_eq(drain(uut), std::vector<int>{2, 3, 1});
+}
+
+TEST("a closed bounded mailbox no longer accepts new messages") {
+  for (auto pol : {policy::drop_newest, policy::drop_oldest, policy::reject,
+                   policy::block}) {
+    detail::bounded_mailbox uut{nullptr, 1, pol};
+    uut.close(error{});
+    check_eq(uut.push_back(make_int_msg(1)), ires::queue_closed);
+  }
+}
+
+TEST("reject responds to requests with sec::mailbox_full") {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  scoped_actor self{sys};
+  detail::bounded_mailbox uut{nullptr, 1, policy::reject};
+  auto sender = actor_cast<strong_actor_ptr>(self);
+  auto mid = make_message_id(42);
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.push_back(make_mailbox_element(sender, mid, make_message(2))),
+           ires::success);
+  check_eq(uut.dropped(), 1u);
+  auto response = self->mailbox().pop_front();
+  if (check_ne(response, nullptr)) {
+    check_eq(response->mid, mid.response_id());
+    if (check(response->content().match_elements<error>()))
+      check_eq(response->content().get_as<error>(0), sec::mailbox_full);
+  }
+  uut.close(error{});
+}
+
+TEST("block suspends blocking senders until the mailbox has free capacity") {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  scoped_actor self{sys};
+  detail::bounded_mailbox uut{nullptr, 1, policy::block};
+  auto sender = actor_cast<strong_actor_ptr>(self);
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  std::atomic<bool> done = false;
+  std::thread producer{[&] {
+    uut.push_back(make_mailbox_element(sender, make_message_id(),
+                                       make_message(2)));
+    done = true;
+  }};
+  // Wait until the producer blocks on the full mailbox.
+  while (uut.waiting_senders() == 0)
+    std::this_thread::yield();
+  check(!done.load());
+  check_eq(uut.size(), 1u);
+  // Taking a message out of the mailbox resumes the producer.
+  auto ptr = uut.pop_front();
+  producer.join();
+  check(done.load());
+  check_eq(uut.waiting_senders(), 0u);
+  if (check_ne(ptr, nullptr))
+    check_eq(ptr->content().get_as<int>(0), 1);
+  check_eq(drain(uut), std::vector<int>{2});
+  check_eq(uut.dropped(), 0u);
+}
+
+} // namespace
@@ -0,0 +1,21 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/bounded_mailbox_factory.hpp"
+
+#include "caf/blocking_actor.hpp"
+#include "caf/detail/bounded_mailbox.hpp"
+#include "caf/scheduled_actor.hpp"
+
+namespace caf::detail {
+
+abstract_mailbox* bounded_mailbox_factory::make(scheduled_actor* owner) {
+  return new bounded_mailbox(owner, capacity_, policy_);
+}
+
+abstract_mailbox* bounded_mailbox_factory::make(blocking_actor* owner) {
+  return new bounded_mailbox(owner, capacity_, policy_);
+}
+
+} // namespace caf::detail
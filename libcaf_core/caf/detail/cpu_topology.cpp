@@ -0,0 +1,154 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/config.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <tuple>
+
+#ifdef CAF_LINUX
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+namespace caf::detail {
+
+namespace {
+
+[[maybe_unused]] std::string read_first_line(const std::string& path) {
+  std::string result;
+  std::ifstream in{path};
+  std::getline(in, result);
+  return result;
+}
+
+std::vector<cpu_info> flat_cpu_topology() {
+  auto num_cpus = std::max(std::thread::hardware_concurrency(), 1u);
+  std::vector<cpu_info> result;
+  result.reserve(num_cpus);
+  for (size_t id = 0; id < num_cpus; ++id)
+    result.push_back(cpu_info{id, 0, 0});
+  return result;
+}
+
+} // namespace
+
+std::vector<cpu_info> read_cpu_topology() {
+#ifdef CAF_LINUX
+  const std::string sysfs = "/sys/devices/system/";
+  auto ids = parse_cpu_list(read_first_line(sysfs + "cpu/online"));
+  // Skip CPUs that this process may not run on, e.g., in a container.
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    auto is_disallowed = [&allowed](size_t id) {
+      return id >= CPU_SETSIZE || !CPU_ISSET(id, &allowed);
+    };
+    ids.erase(std::remove_if(ids.begin(), ids.end(), is_disallowed),
+              ids.end());
+  }
+  if (ids.empty())
+    return flat_cpu_topology();
+  std::vector<cpu_info> result;
+  result.reserve(ids.size());
+  for (auto id : ids) {
+    // The cache with the highest level is the last-level cache. Without any
+    // information on caches, we assume that each CPU has its own cache.
+    cpu_info cpu{id, id, 0};
+    auto prefix = sysfs + "cpu/cpu" + std::to_string(id) + "/cache/index";
+    size_t max_level = 0;
+    for (size_t index = 0;; ++index) {
+      auto dir = prefix + std::to_string(index) + '/';
+      // Note: a single number is a valid CPU list.
+      auto level = parse_cpu_list(read_first_line(dir + "level"));
+      if (level.size() != 1)
+        break;
+      if (level[0] < max_level)
+        continue;
+      auto shared = parse_cpu_list(read_first_line(dir + "shared_cpu_list"));
+      if (!shared.empty()) {
+        max_level = level[0];
+        cpu.cache_id = shared.front();
+      }
+    }
+    result.push_back(cpu);
+  }
+  auto nodes = parse_cpu_list(read_first_line(sysfs + "node/online"));
+  for (auto node : nodes) {
+    auto path = sysfs + "node/node" + std::to_string(node) + "/cpulist";
+    auto cpus = parse_cpu_list(read_first_line(path));
+    for (auto& cpu : result)
+      if (std::binary_search(cpus.begin(), cpus.end(), cpu.id))
+        cpu.node_id = node;
+  }
+  std::sort(result.begin(), result.end(),
+            [](const cpu_info& x, const cpu_info& y) {
+              return std::tie(x.node_id, x.cache_id, x.id)
+                     < std::tie(y.node_id, y.cache_id, y.id);
+            });
+  return result;
+#else
+  return flat_cpu_topology();
+#endif
+}
+
+std::vector<size_t> parse_cpu_list(std::string_view str) {
+  auto is_digit = [](char c) {
+    return std::isdigit(static_cast<unsigned char>(c)) != 0;
+  };
+  auto read_id = [&str, &is_digit](size_t& result) {
+    if (str.empty() || !is_digit(str.front()))
+      return false;
+    result = 0;
+    while (!str.empty() && is_digit(str.front())) {
+      result = result * 10 + static_cast<size_t>(str.front() - '0');
+      str.remove_prefix(1);
+    }
+    return true;
+  };
+  while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back())))
+    str.remove_suffix(1);
+  std::vector<size_t> result;
+  if (str.empty())
+    return result;
+  for (;;) {
+    size_t first = 0;
+    if (!read_id(first))
+      return {};
+    auto last = first;
+    if (!str.empty() && str.front() == '-') {
+      str.remove_prefix(1);
+      if (!read_id(last) || last < first)
+        return {};
+    }
+    for (auto id = first; id <= last; ++id)
+      result.push_back(id);
+    if (str.empty())
+      return result;
+    if (str.front() != ',')
+      return {};
+    str.remove_prefix(1);
+  }
+}
+
+bool pin_current_thread([[maybe_unused]] size_t cpu_id) {
+#ifdef CAF_LINUX
+  if (cpu_id >= CPU_SETSIZE)
+    return false;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu_id, &cpus);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+  return false;
+#endif
+}
+
+} // namespace caf::detail
@@ -0,0 +1,44 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace caf::detail {
+
+/// Describes a single logical CPU of the host.
+struct cpu_info {
+  /// The index of the CPU as used by the operating system.
+  size_t id;
+
+  /// Identifies the group of CPUs that share the last-level cache with this
+  /// CPU. We use the lowest CPU ID in the group as identifier.
+  size_t cache_id;
+
+  /// Identifies the NUMA node of this CPU.
+  size_t node_id;
+};
+
+/// Returns all logical CPUs that this process may run on, sorted by NUMA node,
+/// cache group and ID. Reads the topology from sysfs on Linux. On other
+/// platforms or if sysfs is unavailable, returns
+/// `std::thread::hardware_concurrency()` CPUs that share a single cache and
+/// NUMA node.
+CAF_CORE_EXPORT std::vector<cpu_info> read_cpu_topology();
+
+/// Parses a list of CPU IDs in the format of the Linux kernel, e.g., "0-3,8".
+/// @returns the parsed IDs or an empty list on a parser error.
+CAF_CORE_EXPORT std::vector<size_t> parse_cpu_list(std::string_view str);
+
+/// Binds the calling thread to the CPU with given ID. Not supported on all
+/// platforms (no-op on platforms other than Linux).
+/// @returns `true` on success, `false` otherwise.
+CAF_CORE_EXPORT bool pin_current_thread(size_t cpu_id);
+
+} // namespace caf::detail
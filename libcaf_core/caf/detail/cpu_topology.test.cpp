@@ -0,0 +1,51 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using id_list = std::vector<size_t>;
+
+TEST("parse_cpu_list accepts single IDs and ranges") {
+  check_eq(detail::parse_cpu_list("0"), id_list{0});
+  check_eq(detail::parse_cpu_list("0-3"), id_list{0, 1, 2, 3});
+  check_eq(detail::parse_cpu_list("0-1,8,10-11\n"), id_list{0, 1, 8, 10, 11});
+  check_eq(detail::parse_cpu_list(""), id_list{});
+}
+
+TEST("parse_cpu_list rejects malformed input") {
+  check_eq(detail::parse_cpu_list("a"), id_list{});
+  check_eq(detail::parse_cpu_list("1-"), id_list{});
+  check_eq(detail::parse_cpu_list("3-1"), id_list{});
+  check_eq(detail::parse_cpu_list("1,,2"), id_list{});
+  check_eq(detail::parse_cpu_list("1;2"), id_list{});
+}
+
+TEST("read_cpu_topology groups CPUs by NUMA node and cache") {
+  auto cpus = detail::read_cpu_topology();
+  require(!cpus.empty());
+  auto less = [](const detail::cpu_info& x, const detail::cpu_info& y) {
+    if (x.node_id != y.node_id)
+      return x.node_id < y.node_id;
+    if (x.cache_id != y.cache_id)
+      return x.cache_id < y.cache_id;
+    return x.id < y.id;
+  };
+  check(std::is_sorted(cpus.begin(), cpus.end(), less));
+  auto ids = id_list{};
+  for (auto& cpu : cpus)
+    ids.push_back(cpu.id);
+  std::sort(ids.begin(), ids.end());
+  check(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+}
+
+} // namespace
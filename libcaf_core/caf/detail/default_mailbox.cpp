@@ -11,10 +11,20 @@
 namespace caf::detail {
 
 intrusive::inbox_result default_mailbox::push_back(mailbox_element_ptr ptr) {
-  return inbox_.push_front(ptr.release());
+  if (!size_hint_enabled())
+    return inbox_.push_front(ptr.release());
+  // Note: we increment the counter first, because the owner may take the new
+  //       element out of the mailbox right after pushing it.
+  pushed_.fetch_add(1, std::memory_order_relaxed);
+  auto result = inbox_.push_front(ptr.release());
+  if (result == intrusive::inbox_result::queue_closed)
+    pushed_.fetch_sub(1, std::memory_order_relaxed);
+  return result;
 }
 
 void default_mailbox::push_front(mailbox_element_ptr ptr) {
+  popped_.store(popped_.load(std::memory_order_relaxed) - 1,
+                std::memory_order_relaxed);
   if (ptr->mid.is_urgent_message())
     urgent_queue_.push_front(ptr.release());
   else
@@ -41,10 +51,13 @@ mailbox_element* default_mailbox::peek(message_id id) {
 
 mailbox_element_ptr default_mailbox::pop_front() {
   for (;;) {
-    if (auto result = urgent_queue_.pop_front())
-      return result;
-    if (auto result = normal_queue_.pop_front())
+    auto result = urgent_queue_.pop_front();
+    if (!result)
+      result = normal_queue_.pop_front();
+    if (result) {
+      add_popped(1);
       return result;
+    }
     if (!fetch_more())
       return nullptr;
   }
@@ -59,7 +72,14 @@ bool default_mailbox::blocked() const noexcept {
 }
 
 bool default_mailbox::try_block() {
-  return cached() == 0 && inbox_.try_block();
+  if (cached() != 0 || !inbox_.try_block())
+    return false;
+  // Messages that arrived before `enable_size_hint` count as popped but not as
+  // pushed. Since the mailbox is empty now, we can discard any drift between
+  // the two counters.
+  popped_.store(pushed_.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+  return true;
 }
 
 bool default_mailbox::try_unblock() {
@@ -77,6 +97,7 @@ size_t default_mailbox::close(const error& reason) {
   urgent_queue_.drain(bounce_and_count);
   normal_queue_.drain(bounce_and_count);
   inbox_.close(bounce_and_count);
+  add_popped(result);
   return result;
 }
 
@@ -85,6 +106,21 @@ size_t default_mailbox::size() {
   return cached();
 }
 
+size_t default_mailbox::size_hint() const noexcept {
+  if (!size_hint_enabled())
+    return 0;
+  // Note: the counters may wrap around and `push_front` may re-insert
+  //       elements, so we compute the difference first.
+  auto popped = popped_.load(std::memory_order_relaxed);
+  auto pushed = pushed_.load(std::memory_order_relaxed);
+  auto result = static_cast<ptrdiff_t>(pushed - popped);
+  return result > 0 ? static_cast<size_t>(result) : 0;
+}
+
+void default_mailbox::enable_size_hint() noexcept {
+  count_pushed_.store(true, std::memory_order_relaxed);
+}
+
 bool default_mailbox::fetch_more() {
   using node_type = intrusive::singly_linked<mailbox_element>;
   auto promote = [](node_type* ptr) {
@@ -47,6 +47,10 @@ public:
 
   size_t size() override;
 
+  size_t size_hint() const noexcept override;
+
+  void enable_size_hint() noexcept override;
+
   void ref_mailbox() noexcept override;
 
   void deref_mailbox() noexcept override;
@@ -55,6 +59,11 @@ public:
     return ref_count_.load();
   }
 
+  /// Checks whether senders count their messages for `size_hint`.
+  bool size_hint_enabled() const noexcept {
+    return count_pushed_.load(std::memory_order_relaxed);
+  }
+
 private:
   /// Returns the total number of elements stored in the queues.
   size_t cached() const noexcept {
@@ -64,15 +73,33 @@ private:
   /// Tries to fetch more messages from the LIFO inbox.
   bool fetch_more();
 
+  /// Adds `n` to the number of messages that the owner took out of the
+  /// mailbox.
+  void add_popped(size_t n) noexcept {
+    popped_.store(popped_.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+  }
+
   /// Stores urgent messages in FIFO order.
   intrusive::linked_list<mailbox_element> urgent_queue_;
 
   /// Stores normal messages in FIFO order.
   intrusive::linked_list<mailbox_element> normal_queue_;
 
+  /// Counts the messages that the owner took out of the mailbox. Only the
+  /// owner writes to this counter.
+  std::atomic<size_t> popped_ = 0;
+
   /// Stores incoming messages in LIFO order.
   alignas(CAF_CACHE_LINE_SIZE) intrusive::lifo_inbox<mailbox_element> inbox_;
 
+  /// Counts the messages that senders put into the mailbox. Senders only
+  /// update this counter if `count_pushed_` is set.
+  std::atomic<size_t> pushed_ = 0;
+
+  /// Signals senders to update `pushed_`.
+  std::atomic<bool> count_pushed_ = false;
+
   /// The intrusive reference count.
   alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> ref_count_;
 };
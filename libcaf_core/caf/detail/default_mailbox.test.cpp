@@ -76,4 +76,45 @@ TEST("calling push_front inserts messages at the beginning") {
   }
 }
 
+TEST("size_hint approximates the number of messages from any thread") {
+  detail::default_mailbox uut;
+  uut.enable_size_hint();
+  check_eq(uut.size_hint(), 0u);
+  uut.push_back(make_int_msg(1));
+  uut.push_back(make_int_msg(2));
+  uut.push_front(make_int_msg(3));
+  check_eq(uut.size_hint(), 3u);
+  check_eq(uut.size_hint(), uut.size());
+  auto ptr = uut.pop_front();
+  check_eq(uut.size_hint(), 2u);
+  uut.push_front(std::move(ptr));
+  check_eq(uut.size_hint(), 3u);
+  uut.close(error{});
+  check_eq(uut.size_hint(), 0u);
+  SECTION("closed mailboxes do not count rejected messages") {
+    uut.push_back(make_int_msg(4));
+    check_eq(uut.size_hint(), 0u);
+  }
+}
+
+TEST("size_hint is 0 unless enabled") {
+  detail::default_mailbox uut;
+  uut.push_back(make_int_msg(1));
+  uut.push_back(make_int_msg(2));
+  check_eq(uut.size_hint(), 0u);
+  SECTION("enabling the size hint counts new messages") {
+    uut.enable_size_hint();
+    uut.push_back(make_int_msg(3));
+    check_eq(uut.size_hint(), 1u);
+    SECTION("the hint becomes accurate once the mailbox runs empty") {
+      while (uut.pop_front() != nullptr)
+        ; // nop
+      check_eq(uut.size_hint(), 0u);
+      check(uut.try_block());
+      uut.push_back(make_int_msg(4));
+      check_eq(uut.size_hint(), 1u);
+    }
+  }
+}
+
 } // namespace
@@ -5,10 +5,13 @@
 #pragma once
 
 #include "caf/config.hpp"
+#include "caf/detail/assert.hpp"
 
+#include <array>
 #include <cassert>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <list>
 #include <mutex>
 #include <thread>
@@ -16,9 +19,12 @@
 namespace caf::detail {
 
 /*
- * A thread-safe, double-ended queue for work-stealing.
+ * A thread-safe, double-ended queue for work-stealing. Stores items in `Lanes`
+ * separate lanes. The owner takes items from all non-empty lanes in weighted
+ * round-robin order, whereas thieves always take items from the first
+ * non-empty lane.
  */
-template <class T>
+template <class T, size_t Lanes = 1>
 class double_ended_queue {
 public:
   using value_type = T;
@@ -28,63 +34,72 @@ public:
   using const_reference = const value_type&;
   using pointer = value_type*;
   using const_pointer = const value_type*;
+  using weights_type = std::array<size_t, Lanes>;
+
+  static constexpr size_t num_lanes = Lanes;
+
+  double_ended_queue() {
+    weights_.fill(1);
+    balances_.fill(0);
+  }
 
   // -- for the owner ----------------------------------------------------------
 
-  void prepend(pointer value) {
+  // Sets how often the owner takes items from each lane relative to the other
+  // lanes while multiple lanes have items.
+  void weights(const weights_type& xs) {
+    std::unique_lock guard{mtx_};
+    weights_ = xs;
+  }
+
+  void prepend(pointer value, size_t lane = 0) {
     CAF_ASSERT(value != nullptr);
+    CAF_ASSERT(lane < Lanes);
     std::unique_lock guard{mtx_};
-    items_.push_front(value);
+    lanes_[lane].push_front(value);
   }
 
   pointer try_take_head() {
     std::unique_lock guard{mtx_};
-    if (!items_.empty()) {
-      auto* result = items_.front();
-      items_.pop_front();
-      return result;
-    }
-    return nullptr;
+    return pop_head();
   }
 
   template <class Duration>
   pointer try_take_head(Duration rel_timeout) {
     auto abs_timeout = std::chrono::system_clock::now() + rel_timeout;
     std::unique_lock guard{mtx_};
-    while (items_.empty()) {
+    while (empty()) {
       if (cv_.wait_until(guard, abs_timeout) == std::cv_status::timeout) {
         return nullptr;
       }
     }
-    auto* result = items_.front();
-    items_.pop_front();
-    return result;
+    return pop_head();
   }
 
   pointer take_head() {
     std::unique_lock guard{mtx_};
-    while (items_.empty()) {
+    while (empty()) {
       cv_.wait(guard);
     }
-    auto* result = items_.front();
-    items_.pop_front();
-    return result;
+    return pop_head();
   }
 
   // Unsafe, since it does not wake up a currently sleeping worker.
-  void unsafe_append(pointer value) {
+  void unsafe_append(pointer value, size_t lane = 0) {
+    CAF_ASSERT(lane < Lanes);
     std::unique_lock guard{mtx_};
-    items_.push_back(value);
+    lanes_[lane].push_back(value);
   }
 
   // -- for others -------------------------------------------------------------
 
-  void append(pointer value) {
+  void append(pointer value, size_t lane = 0) {
+    CAF_ASSERT(lane < Lanes);
     bool do_notify = false;
     {
       std::unique_lock guard{mtx_};
-      do_notify = items_.empty();
-      items_.push_back(value);
+      do_notify = empty();
+      lanes_[lane].push_back(value);
     }
     if (do_notify) {
       cv_.notify_one();
@@ -93,18 +108,55 @@ public:
 
   pointer try_take_tail() {
     std::unique_lock guard{mtx_};
-    if (!items_.empty()) {
-      auto* result = items_.back();
-      items_.pop_back();
-      return result;
+    for (auto& items : lanes_) {
+      if (!items.empty()) {
+        auto* result = items.back();
+        items.pop_back();
+        return result;
+      }
     }
     return nullptr;
   }
 
 private:
+  // @pre `mtx_` is locked.
+  bool empty() const noexcept {
+    for (auto& items : lanes_)
+      if (!items.empty())
+        return false;
+    return true;
+  }
+
+  // Selects a lane with the smooth weighted round-robin algorithm: each
+  // non-empty lane gains its weight and the lane with the highest balance pays
+  // the sum of all gains.
+  // @pre `mtx_` is locked.
+  pointer pop_head() {
+    auto selected = Lanes;
+    auto total = ptrdiff_t{0};
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+      if (lanes_[lane].empty())
+        continue;
+      auto weight = static_cast<ptrdiff_t>(weights_[lane]);
+      balances_[lane] += weight;
+      total += weight;
+      if (selected == Lanes || balances_[lane] > balances_[selected])
+        selected = lane;
+    }
+    if (selected == Lanes)
+      return nullptr;
+    balances_[selected] -= total;
+    auto& items = lanes_[selected];
+    auto* result = items.front();
+    items.pop_front();
+    return result;
+  }
+
   std::mutex mtx_;
   std::condition_variable cv_;
-  std::list<pointer> items_;
+  std::array<std::list<pointer>, Lanes> lanes_;
+  weights_type weights_;
+  std::array<ptrdiff_t, Lanes> balances_;
 };
 
 } // namespace caf::detail
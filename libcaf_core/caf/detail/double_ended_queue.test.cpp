@@ -0,0 +1,70 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/double_ended_queue.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using queue_type = detail::double_ended_queue<int, 3>;
+
+TEST("the owner takes items from a single lane in FIFO order") {
+  detail::double_ended_queue<int> uut;
+  int xs[] = {1, 2, 3};
+  for (auto& x : xs)
+    uut.append(&x);
+  check_eq(uut.try_take_head(), &xs[0]);
+  check_eq(uut.try_take_tail(), &xs[2]);
+  check_eq(uut.try_take_head(), &xs[1]);
+  check_eq(uut.try_take_head(), nullptr);
+}
+
+TEST("the owner takes items from all lanes according to their weights") {
+  queue_type uut;
+  uut.weights({{4, 2, 1}});
+  std::vector<int> items(21);
+  for (size_t i = 0; i < items.size(); ++i) {
+    items[i] = static_cast<int>(i % 3);
+    uut.append(&items[i], i % 3);
+  }
+  auto count = std::vector<size_t>(3);
+  for (size_t i = 0; i < 7; ++i)
+    ++count[static_cast<size_t>(*uut.try_take_head())];
+  check_eq(count, std::vector<size_t>{4, 2, 1});
+  SECTION("lanes without items do not slow down other lanes") {
+    for (auto* x = uut.try_take_head(); x != nullptr; x = uut.try_take_head())
+      ++count[static_cast<size_t>(*x)];
+    check_eq(count, std::vector<size_t>{7, 7, 7});
+  }
+}
+
+TEST("thieves take items from the first non-empty lane") {
+  queue_type uut;
+  int xs[] = {0, 1, 2, 3};
+  uut.append(&xs[0], 2);
+  uut.append(&xs[1], 1);
+  uut.append(&xs[2], 1);
+  uut.append(&xs[3], 2);
+  check_eq(uut.try_take_tail(), &xs[2]);
+  check_eq(uut.try_take_tail(), &xs[1]);
+  check_eq(uut.try_take_tail(), &xs[3]);
+  check_eq(uut.try_take_tail(), &xs[0]);
+  check_eq(uut.try_take_tail(), nullptr);
+}
+
+TEST("prepend puts items to the front of their lane") {
+  queue_type uut;
+  int xs[] = {0, 1};
+  uut.append(&xs[0], 1);
+  uut.prepend(&xs[1], 1);
+  check_eq(uut.try_take_head(), &xs[1]);
+  check_eq(uut.try_take_head(), &xs[0]);
+}
+
+} // namespace
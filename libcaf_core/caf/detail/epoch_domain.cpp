@@ -0,0 +1,82 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/epoch_domain.hpp"
+
+#include <thread>
+
+namespace caf::detail {
+
+namespace {
+
+// Releases the record of a thread when the thread terminates. The record
+// itself remains in the list of its domain for re-use by other threads.
+struct record_owner {
+  epoch_domain::record* ptr = nullptr;
+
+  ~record_owner() {
+    if (ptr != nullptr)
+      ptr->in_use = false;
+  }
+};
+
+thread_local record_owner local_record_owner;
+
+} // namespace
+
+epoch_domain& epoch_domain::global() {
+  static auto* instance = new epoch_domain;
+  return *instance;
+}
+
+epoch_domain::record* epoch_domain::enter() {
+  auto* rec = local_record();
+  if (rec->nesting++ == 0)
+    rec->epoch = epoch_.load();
+  return rec;
+}
+
+void epoch_domain::leave(record* rec) noexcept {
+  if (--rec->nesting == 0)
+    rec->epoch = 0;
+}
+
+void epoch_domain::synchronize() {
+  // Readers that enter after this point observe the new epoch and thus also
+  // any pointer that the writer has published before calling this function.
+  auto target = ++epoch_;
+  for (auto* rec = head_.load(); rec != nullptr; rec = rec->next) {
+    for (;;) {
+      auto val = rec->epoch.load();
+      if (val == 0 || val >= target)
+        break;
+      std::this_thread::yield();
+    }
+  }
+}
+
+epoch_domain::record* epoch_domain::local_record() {
+  auto& owner = local_record_owner;
+  if (owner.ptr == nullptr)
+    owner.ptr = acquire_record();
+  return owner.ptr;
+}
+
+epoch_domain::record* epoch_domain::acquire_record() {
+  for (auto* rec = head_.load(); rec != nullptr; rec = rec->next) {
+    auto expected = false;
+    if (!rec->in_use.load()
+        && rec->in_use.compare_exchange_strong(expected, true))
+      return rec;
+  }
+  auto* rec = new record;
+  rec->in_use = true;
+  auto* next = head_.load();
+  do {
+    rec->next = next;
+  } while (!head_.compare_exchange_weak(next, rec));
+  return rec;
+}
+
+} // namespace caf::detail
@@ -0,0 +1,107 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace caf::detail {
+
+/// Implements read-copy-update (RCU) synchronization with epoch-based
+/// reclamation. Readers enter a critical section by announcing the current
+/// epoch in a per-thread record, which requires no locks and no writes to
+/// shared cache lines. Writers publish a new version of the data via an atomic
+/// pointer and then call `synchronize` to wait for all readers that may still
+/// see the old version before destroying it.
+///
+/// There is only a single, process-wide domain that all users share. This
+/// allows each thread to use a single record for all critical sections.
+class CAF_CORE_EXPORT epoch_domain {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Per-thread bookkeeping.
+  struct record {
+    /// The epoch that the owning thread announced when entering its current
+    /// critical section or 0 if the thread is outside of a critical section.
+    alignas(CAF_CACHE_LINE_SIZE) std::atomic<uint64_t> epoch = 0;
+
+    /// Counts nested critical sections of the owning thread.
+    size_t nesting = 0;
+
+    /// Signals whether a thread currently owns this record.
+    std::atomic<bool> in_use = false;
+
+    /// Links all records of the domain.
+    record* next = nullptr;
+  };
+
+  /// RAII type for read-side critical sections. Pointers loaded within the
+  /// critical section remain valid until the guard goes out of scope.
+  class read_guard {
+  public:
+    explicit read_guard(epoch_domain& domain) : rec_(domain.enter()) {
+      // nop
+    }
+
+    read_guard(const read_guard&) = delete;
+
+    read_guard& operator=(const read_guard&) = delete;
+
+    ~read_guard() {
+      epoch_domain::leave(rec_);
+    }
+
+  private:
+    record* rec_;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  epoch_domain(const epoch_domain&) = delete;
+
+  epoch_domain& operator=(const epoch_domain&) = delete;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the process-wide domain. The domain is never destroyed, because
+  /// threads may still hold records of the domain during static destruction.
+  static epoch_domain& global();
+
+  // -- synchronization --------------------------------------------------------
+
+  /// Enters a read-side critical section for the calling thread.
+  record* enter();
+
+  /// Leaves a read-side critical section.
+  static void leave(record* rec) noexcept;
+
+  /// Blocks until all readers that entered their critical section before this
+  /// call have left it.
+  /// @warning Calling this function from within a read-side critical section
+  ///          causes a deadlock.
+  void synchronize();
+
+private:
+  epoch_domain() = default;
+
+  /// Returns the record of the calling thread, acquiring one if necessary.
+  record* local_record();
+
+  /// Acquires an unused record or allocates a new one.
+  record* acquire_record();
+
+  /// The current epoch. Starts at 1, because 0 denotes inactive readers.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<uint64_t> epoch_ = 1;
+
+  /// Points to the first record in the list of all records.
+  std::atomic<record*> head_ = nullptr;
+};
+
+} // namespace caf::detail
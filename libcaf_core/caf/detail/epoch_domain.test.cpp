@@ -0,0 +1,81 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/epoch_domain.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using detail::epoch_domain;
+
+TEST("synchronize returns immediately if there are no readers") {
+  epoch_domain::global().synchronize();
+  epoch_domain::global().synchronize();
+}
+
+TEST("read guards may be nested") {
+  auto& domain = epoch_domain::global();
+  std::atomic<bool> synchronized = false;
+  std::thread writer;
+  {
+    epoch_domain::read_guard outer{domain};
+    {
+      epoch_domain::read_guard inner{domain};
+    }
+    writer = std::thread{[&] {
+      domain.synchronize();
+      synchronized = true;
+    }};
+    // The writer must wait for the outer guard.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    check(!synchronized.load());
+  }
+  writer.join();
+  check(synchronized.load());
+}
+
+TEST("writers never destroy data that readers still access") {
+  struct value {
+    explicit value(int x) : x(x) {
+      // nop
+    }
+    ~value() {
+      x = -1;
+    }
+    int x;
+  };
+  auto& domain = epoch_domain::global();
+  std::atomic<value*> current = new value{0};
+  std::atomic<bool> done = false;
+  std::atomic<size_t> errors = 0;
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        epoch_domain::read_guard guard{domain};
+        if (current.load()->x < 0)
+          ++errors;
+      }
+    });
+  }
+  for (int i = 1; i <= 1000; ++i) {
+    std::unique_ptr<value> old{current.exchange(new value{i})};
+    domain.synchronize();
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+  delete current.load();
+  check_eq(errors.load(), 0u);
+}
+
+} // namespace
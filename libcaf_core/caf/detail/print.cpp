@@ -7,8 +7,48 @@
 #include "caf/config.hpp"
 #include "caf/detail/assert.hpp"
 
+#include <cstring>
+
 namespace caf::detail {
 
+namespace {
+
+constexpr uint64_t repeat_byte(uint8_t x) {
+  return 0x0101010101010101ull * x;
+}
+
+// Returns a non-zero value if any byte in `x` is less than `n` (with n <= 128).
+constexpr uint64_t has_byte_less_than(uint64_t x, uint8_t n) {
+  return (x - repeat_byte(n)) & ~x & repeat_byte(0x80);
+}
+
+// Returns a non-zero value if any byte in `x` is equal to `n`.
+constexpr uint64_t has_byte(uint64_t x, uint8_t n) {
+  return has_byte_less_than(x ^ repeat_byte(n), 1);
+}
+
+constexpr bool is_escape_candidate(char c) {
+  return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+}
+
+} // namespace
+
+const char* find_escape_candidate(const char* first,
+                                  const char* last) noexcept {
+  // Skip blocks of eight characters that cannot contain special characters.
+  while (last - first >= 8) {
+    uint64_t block;
+    memcpy(&block, first, sizeof(block));
+    if (has_byte_less_than(block, 0x20) != 0 || has_byte(block, '"') != 0
+        || has_byte(block, '\\') != 0)
+      break;
+    first += 8;
+  }
+  while (first != last && !is_escape_candidate(*first))
+    ++first;
+  return first;
+}
+
 size_t print_timestamp(char* buf, size_t buf_size, time_t ts, size_t ms) {
   tm time_buf;
 #ifdef CAF_MSVC
@@ -96,11 +96,27 @@ auto print_escaped_to(Output&& out, char c) {
     return out;
 }
 
+/// Returns a pointer to the first character in `[first, last)` that may
+/// require escaping, i.e., a control character, a quote or a backslash.
+/// Returns `last` if no such character exists. Scans the input one machine
+/// word at a time.
+CAF_CORE_EXPORT
+const char* find_escape_candidate(const char* first, const char* last) noexcept;
+
 template <class Buffer>
 void print_escaped(Buffer& buf, std::string_view str) {
   buf.push_back('"');
-  for (auto c : str)
-    print_escaped_to(buf, c);
+  auto first = str.data();
+  auto last = first + str.size();
+  while (first != last) {
+    // Copy runs of characters that need no escaping in bulk.
+    auto pos = find_escape_candidate(first, last);
+    buf.insert(buf.end(), first, pos);
+    if (pos == last)
+      break;
+    print_escaped_to(buf, *pos);
+    first = pos + 1;
+  }
   buf.push_back('"');
 }
 
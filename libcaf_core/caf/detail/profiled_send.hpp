@@ -16,6 +16,8 @@
 
 namespace caf::detail {
 
+/// Sends a message to `dst` or counts it as rejected if `dst` is invalid. The
+/// receiver calls the `actor_profiler` hooks when enqueueing the message.
 template <class Self, class SelfHandle, class Handle, class... Ts>
 void profiled_send(Self* self, SelfHandle&& src, const Handle& dst,
                    message_id msg_id, scheduler* sched, Ts&&... xs) {
@@ -28,6 +30,7 @@ void profiled_send(Self* self, SelfHandle&& src, const Handle& dst,
   }
 }
 
+/// Schedules a message to `dst` or counts it as rejected if `dst` is invalid.
 template <class Self, class SelfHandle, class Handle, class... Ts>
 disposable profiled_send(Self* self, SelfHandle&& src, const Handle& dst,
                          actor_clock& clock, actor_clock::time_point timeout,
@@ -124,13 +124,8 @@ public:
     auto mid = self()->new_request_id(Priority);
     disposable in_flight_timeout;
     if (receiver) {
-      if (relative_timeout != infinite) {
-        auto& clock = self()->clock();
-        in_flight_timeout = clock.schedule_message(
-          nullptr, actor_cast(super::self_, weak_ref),
-          clock.now() + relative_timeout, mid.response_id(),
-          make_message(make_error(sec::request_timeout)));
-      }
+      in_flight_timeout = self()->request_response_timeout(relative_timeout,
+                                                           mid);
       auto* ptr = actor_cast<abstract_actor*>(receiver);
       ptr->enqueue(make_mailbox_element(self()->ctrl(), mid,
                                         std::move(super::content_)),
@@ -9,6 +9,7 @@
 #include "caf/log/core.hpp"
 #include "caf/mailbox_element.hpp"
 #include "caf/system_messages.hpp"
+#include "caf/trace_context.hpp"
 
 #include <utility>
 
@@ -45,6 +46,10 @@ bool forwarding_actor_proxy::forward_msg(strong_actor_ptr sender,
 bool forwarding_actor_proxy::enqueue(mailbox_element_ptr what, scheduler*) {
   CAF_PUSH_AID(0);
   CAF_ASSERT(what);
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+  // Pass the trace context on to the BASP broker.
+  trace_context::guard trace_guard{what->trace};
+#endif
   return forward_msg(std::move(what->sender), what->mid,
                      std::move(what->payload));
 }
@@ -86,6 +86,7 @@ class actor_companion;
 class actor_config;
 class actor_control_block;
 class actor_pool;
+class actor_profiler;
 class actor_proxy;
 class actor_registry;
 class actor_system;
@@ -167,6 +168,7 @@ struct stream_close_msg;
 struct stream_demand_msg;
 struct stream_open_msg;
 struct timeout_msg;
+struct trace_context;
 struct unit_t;
 
 // -- free template functions --------------------------------------------------
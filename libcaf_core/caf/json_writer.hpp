@@ -12,7 +12,7 @@
 namespace caf {
 
 /// Serializes an inspectable object to a JSON-formatted string.
-class CAF_CORE_EXPORT json_writer : public serializer {
+class CAF_CORE_EXPORT json_writer final : public serializer {
 public:
   // -- member types -----------------------------------------------------------
 
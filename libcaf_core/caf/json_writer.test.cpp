@@ -228,6 +228,34 @@ SCENARIO("the JSON writer converts builtin types to strings") {
       }
     }
   }
+  GIVEN("a long string with special characters at various positions") {
+    WHEN("converting it to JSON") {
+      THEN("the JSON output escapes each special character") {
+        for (size_t pos = 0; pos < 20; ++pos) {
+          for (auto special : {'"', '\\', '\n', '\t'}) {
+            auto x = std::string(20, 'a');
+            x[pos] = special;
+            auto out = std::string{"\""};
+            out.append(pos, 'a');
+            out += '\\';
+            switch (special) {
+              case '\n':
+                out += 'n';
+                break;
+              case '\t':
+                out += 't';
+                break;
+              default:
+                out += special;
+            }
+            out.append(19 - pos, 'a');
+            out += '"';
+            check_eq(to_json_string(x, 0), out);
+          }
+        }
+      }
+    }
+  }
   GIVEN("a list") {
     auto x = std::vector<int>{1, 2, 3};
     WHEN("converting it to JSON with indentation factor 0") {
@@ -6,6 +6,7 @@
 
 #include "caf/actor_cast.hpp"
 #include "caf/actor_ostream.hpp"
+#include "caf/actor_profiler.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
@@ -63,7 +64,7 @@ local_actor::local_actor(actor_config& cfg)
     context_(cfg.sched),
     current_element_(nullptr),
     initial_behavior_fac_(std::move(cfg.init_fun)) {
-  // nop
+  CAF_ADD_ACTOR(this, cfg.parent);
 }
 
 local_actor::~local_actor() {
@@ -169,6 +170,7 @@ void local_actor::initialize() {
 void local_actor::on_cleanup([[maybe_unused]] const error& reason) {
   auto lg = log::core::trace("reason = {}", reason);
   on_exit();
+  CAF_REMOVE_ACTOR(this);
   CAF_LOG_TERMINATE_EVENT(this, reason);
 }
 
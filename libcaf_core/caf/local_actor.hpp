@@ -108,7 +108,7 @@ public:
 
   /// Requests a new timeout for `mid`.
   /// @pre `mid.is_request()`
-  disposable request_response_timeout(timespan d, message_id mid);
+  virtual disposable request_response_timeout(timespan d, message_id mid);
 
   // -- printing ---------------------------------------------------------------
 
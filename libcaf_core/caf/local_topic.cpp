@@ -0,0 +1,146 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/local_topic.hpp"
+
+#include "caf/abstract_actor.hpp"
+#include "caf/detail/epoch_domain.hpp"
+#include "caf/local_actor.hpp"
+#include "caf/mailbox_element.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/message_id.hpp"
+
+#include <algorithm>
+
+namespace caf {
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+local_topic::local_topic() : subscribers_(new subscriber_list) {
+  // nop
+}
+
+local_topic::~local_topic() {
+  delete subscribers_.load();
+}
+
+// -- properties ---------------------------------------------------------------
+
+size_t local_topic::subscriber_count() const {
+  detail::epoch_domain::read_guard guard{detail::epoch_domain::global()};
+  return subscribers_.load()->size();
+}
+
+local_topic::subscriber_list local_topic::subscribers() const {
+  detail::epoch_domain::read_guard guard{detail::epoch_domain::global()};
+  return *subscribers_.load();
+}
+
+// -- publishing ---------------------------------------------------------------
+
+size_t local_topic::publish(message content, message_priority prio) {
+  return publish_impl(nullptr, nullptr, std::move(content), prio);
+}
+
+size_t local_topic::publish(local_actor* self, message content,
+                            message_priority prio) {
+  return publish_impl(self->ctrl(), self->context(), std::move(content), prio);
+}
+
+// -- private utility ----------------------------------------------------------
+
+bool local_topic::subscribe_impl(weak_actor_ptr hdl) {
+  if (!hdl)
+    return false;
+  // Destroys the previous snapshot outside of the critical section for the
+  // same reasoning as in actor_registry::erase.
+  std::unique_ptr<const subscriber_list> old;
+  { // Lifetime scope of guard.
+    std::unique_lock guard{mtx_};
+    auto* subs = subscribers_.load();
+    if (std::find(subs->begin(), subs->end(), hdl) != subs->end())
+      return false;
+    auto new_subs = std::make_unique<subscriber_list>();
+    new_subs->reserve(subs->size() + 1);
+    new_subs->insert(new_subs->end(), subs->begin(), subs->end());
+    new_subs->emplace_back(std::move(hdl));
+    old = publish_snapshot(std::move(new_subs));
+  }
+  return true;
+}
+
+bool local_topic::unsubscribe_impl(const actor_control_block* hdl) {
+  std::unique_ptr<const subscriber_list> old;
+  { // Lifetime scope of guard.
+    std::unique_lock guard{mtx_};
+    auto* subs = subscribers_.load();
+    auto i = std::find_if(subs->begin(), subs->end(),
+                          [hdl](const weak_actor_ptr& sub) {
+                            return sub.get() == hdl;
+                          });
+    if (i == subs->end())
+      return false;
+    auto new_subs = std::make_unique<subscriber_list>();
+    new_subs->reserve(subs->size() - 1);
+    new_subs->insert(new_subs->end(), subs->begin(), i);
+    new_subs->insert(new_subs->end(), i + 1, subs->end());
+    old = publish_snapshot(std::move(new_subs));
+  }
+  return true;
+}
+
+void local_topic::drop_expired() {
+  std::unique_ptr<const subscriber_list> old;
+  { // Lifetime scope of guard.
+    std::unique_lock guard{mtx_};
+    auto* subs = subscribers_.load();
+    auto new_subs = std::make_unique<subscriber_list>();
+    new_subs->reserve(subs->size());
+    for (auto& sub : *subs)
+      if (sub.get()->strong_refs.load() > 0)
+        new_subs->push_back(sub);
+    if (new_subs->size() == subs->size())
+      return;
+    old = publish_snapshot(std::move(new_subs));
+  }
+}
+
+size_t local_topic::publish_impl(strong_actor_ptr sender, scheduler* sched,
+                                 message content, message_priority prio) {
+  auto mid = make_message_id(prio);
+  size_t result = 0;
+  bool has_expired = false;
+  { // Lifetime scope of guard.
+    detail::epoch_domain::read_guard guard{detail::epoch_domain::global()};
+    // Each mailbox element shares the content with all other elements.
+    for (auto& sub : *subscribers_.load()) {
+      if (auto hdl = sub.lock()) {
+        if (hdl->enqueue(make_mailbox_element(sender, mid, content), sched))
+          ++result;
+      } else {
+        has_expired = true;
+      }
+    }
+  }
+  // Calling synchronize from a critical section would cause a deadlock.
+  if (has_expired)
+    drop_expired();
+  return result;
+}
+
+std::unique_ptr<const local_topic::subscriber_list>
+local_topic::publish_snapshot(std::unique_ptr<const subscriber_list> ptr) {
+  std::unique_ptr<const subscriber_list> old{
+    subscribers_.exchange(ptr.release())};
+  detail::epoch_domain::global().synchronize();
+  return old;
+}
+
+// -- free functions -----------------------------------------------------------
+
+local_topic_ptr make_local_topic() {
+  return make_counted<local_topic>();
+}
+
+} // namespace caf
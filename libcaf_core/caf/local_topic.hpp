@@ -0,0 +1,121 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/actor_cast.hpp"
+#include "caf/actor_control_block.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/message.hpp"
+#include "caf/message_priority.hpp"
+#include "caf/ref_counted.hpp"
+#include "caf/weak_intrusive_ptr.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace caf {
+
+/// Distributes messages to a dynamic set of local actors. All subscribers
+/// share the content of a published message, i.e., publishing allocates the
+/// `message` only once and subscribers only get their own mailbox element.
+///
+/// Publishing uses read-copy-update (RCU): publishers iterate an immutable
+/// snapshot of the subscriber list without acquiring any lock, while
+/// subscribing and unsubscribing replace the snapshot with an updated copy.
+/// Hence, changing the subscribers is relatively expensive, but publishing
+/// scales with the number of threads.
+///
+/// The topic only holds weak references to its subscribers. Publishing drops
+/// subscribers that no longer exist from the list.
+class CAF_CORE_EXPORT local_topic : public ref_counted {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using subscriber_list = std::vector<weak_actor_ptr>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  local_topic();
+
+  ~local_topic() override;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of current subscribers.
+  size_t subscriber_count() const;
+
+  /// Returns a copy of the current subscriber list.
+  subscriber_list subscribers() const;
+
+  // -- subscriptions ----------------------------------------------------------
+
+  /// Adds `hdl` to the subscribers.
+  /// @returns `true` if `hdl` was added, `false` if `hdl` is invalid or
+  ///          already subscribed.
+  template <class Handle>
+  bool subscribe(const Handle& hdl) {
+    return subscribe_impl(actor_cast<weak_actor_ptr>(hdl));
+  }
+
+  /// Removes `hdl` from the subscribers.
+  /// @returns `true` if `hdl` was removed, `false` if `hdl` was not
+  ///          subscribed.
+  template <class Handle>
+  bool unsubscribe(const Handle& hdl) {
+    return unsubscribe_impl(actor_cast<actor_control_block*>(hdl));
+  }
+
+  // -- publishing -------------------------------------------------------------
+
+  /// Sends `content` as anonymous message to all subscribers.
+  /// @returns the number of subscribers that received the message.
+  size_t publish(message content,
+                 message_priority prio = message_priority::normal);
+
+  /// Sends `content` to all subscribers on behalf of `self`. Schedules
+  /// subscribers that wake up on the execution context of `self`.
+  /// @returns the number of subscribers that received the message.
+  size_t publish(local_actor* self, message content,
+                 message_priority prio = message_priority::normal);
+
+private:
+  bool subscribe_impl(weak_actor_ptr hdl);
+
+  bool unsubscribe_impl(const actor_control_block* hdl);
+
+  /// Removes all subscribers that no longer exist.
+  void drop_expired();
+
+  size_t publish_impl(strong_actor_ptr sender, scheduler* sched,
+                      message content, message_priority prio);
+
+  /// Replaces the current snapshot with `ptr` and returns the previous
+  /// snapshot after all readers have left it.
+  /// @pre `mtx_` is locked by the caller
+  std::unique_ptr<const subscriber_list>
+  publish_snapshot(std::unique_ptr<const subscriber_list> ptr);
+
+  /// Points to the current snapshot of the subscriber list. Readers may only
+  /// access the snapshot in a read-side critical section of the global epoch
+  /// domain.
+  std::atomic<const subscriber_list*> subscribers_;
+
+  /// Serializes writers of the subscriber list.
+  std::mutex mtx_;
+};
+
+/// @relates local_topic
+using local_topic_ptr = intrusive_ptr<local_topic>;
+
+/// Creates a new topic without subscribers.
+/// @relates local_topic
+CAF_CORE_EXPORT local_topic_ptr make_local_topic();
+
+} // namespace caf
@@ -0,0 +1,113 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/local_topic.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/event_based_actor.hpp"
+
+#include <memory>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+using payload_list = std::vector<const detail::message_data*>;
+
+// Records the address of the content of all received messages.
+behavior subscriber_impl(event_based_actor* self,
+                         std::shared_ptr<payload_list> payloads) {
+  return {
+    [self, payloads](int32_t) {
+      payloads->push_back(self->current_mailbox_element()->payload.cptr());
+    },
+  };
+}
+
+struct fixture : test::fixture::deterministic {
+  fixture() {
+    topic = make_local_topic();
+    payloads = std::make_shared<payload_list>();
+  }
+
+  actor spawn_subscriber() {
+    return sys.spawn(subscriber_impl, payloads);
+  }
+
+  local_topic_ptr topic;
+  std::shared_ptr<payload_list> payloads;
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("subscribing adds each actor only once") {
+  auto s1 = spawn_subscriber();
+  auto s2 = spawn_subscriber();
+  check(topic->subscribe(s1));
+  check(topic->subscribe(s2));
+  check(!topic->subscribe(s1));
+  check(!topic->subscribe(actor{}));
+  check_eq(topic->subscriber_count(), 2u);
+  SECTION("unsubscribing removes the actor") {
+    check(topic->unsubscribe(s1));
+    check(!topic->unsubscribe(s1));
+    auto subs = topic->subscribers();
+    require_eq(subs.size(), 1u);
+    check(subs.front() == actor_cast<weak_actor_ptr>(s2));
+  }
+}
+
+TEST("publishing sends the message to all subscribers") {
+  auto s1 = spawn_subscriber();
+  auto s2 = spawn_subscriber();
+  auto s3 = spawn_subscriber();
+  topic->subscribe(s1);
+  topic->subscribe(s2);
+  topic->subscribe(s3);
+  auto msg = make_message(int32_t{42});
+  check_eq(topic->publish(msg), 3u);
+  expect<int32_t>().with(42).to(s1);
+  expect<int32_t>().with(42).to(s2);
+  expect<int32_t>().with(42).to(s3);
+  SECTION("all subscribers share the content of the message") {
+    check(*payloads == payload_list(3, msg.cptr()));
+  }
+  SECTION("unsubscribed actors receive no further messages") {
+    topic->unsubscribe(s2);
+    check_eq(topic->publish(msg), 2u);
+    expect<int32_t>().with(42).to(s1);
+    expect<int32_t>().with(42).to(s3);
+    check_eq(mail_count(s2), 0u);
+  }
+}
+
+TEST("publishing on behalf of an actor sets the sender") {
+  auto s1 = spawn_subscriber();
+  topic->subscribe(s1);
+  auto publisher = sys.spawn([this](event_based_actor* self) -> behavior {
+    return {
+      [this, self](int32_t x) { topic->publish(self, make_message(x)); },
+    };
+  });
+  inject().with(int32_t{7}).to(publisher);
+  expect<int32_t>().with(7).from(publisher).to(s1);
+}
+
+TEST("publishing drops subscribers that no longer exist") {
+  auto s1 = spawn_subscriber();
+  auto s2 = spawn_subscriber();
+  topic->subscribe(s1);
+  topic->subscribe(s2);
+  s2 = nullptr;
+  check_eq(topic->publish(make_message(int32_t{1})), 1u);
+  expect<int32_t>().with(1).to(s1);
+  check_eq(topic->subscriber_count(), 1u);
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
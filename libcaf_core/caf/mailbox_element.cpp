@@ -11,7 +11,9 @@ namespace caf {
 mailbox_element::mailbox_element(strong_actor_ptr sender, message_id mid,
                                  message payload)
   : sender(std::move(sender)), mid(mid), payload(std::move(payload)) {
-  // nop
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+  trace = trace_context::current();
+#endif
 }
 
 mailbox_element_ptr make_mailbox_element(strong_actor_ptr sender, message_id id,
@@ -5,10 +5,12 @@
 #pragma once
 
 #include "caf/actor_control_block.hpp"
+#include "caf/detail/build_config.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/intrusive/singly_linked.hpp"
 #include "caf/message.hpp"
 #include "caf/message_id.hpp"
+#include "caf/trace_context.hpp"
 
 #include <chrono>
 #include <cstddef>
@@ -31,6 +33,11 @@ public:
   /// Stores a timestamp for when this element got enqueued.
   std::chrono::steady_clock::time_point enqueue_time;
 
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+  /// Correlates this message with the message that caused it.
+  trace_context trace;
+#endif
+
   /// Sets `enqueue_time` to the current time.
   void set_enqueue_time() {
     enqueue_time = std::chrono::steady_clock::now();
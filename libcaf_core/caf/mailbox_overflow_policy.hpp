@@ -0,0 +1,49 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/default_enum_inspect.hpp"
+#include "caf/detail/core_export.hpp"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace caf {
+
+/// Selects how a bounded mailbox handles new messages once it reached its
+/// capacity.
+enum class mailbox_overflow_policy {
+  /// Drops the incoming message. Dropped requests never receive a response.
+  drop_newest,
+  /// Drops the oldest message in the mailbox. Dropped requests never receive a
+  /// response.
+  drop_oldest,
+  /// Drops the incoming message and responds to requests with
+  /// `sec::mailbox_full`.
+  reject,
+  /// Suspends the sender until the mailbox has free capacity. Only senders
+  /// that run in their own thread may block. Messages from all other senders
+  /// are handled as if the policy were `reject`.
+  block,
+};
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT std::string to_string(mailbox_overflow_policy);
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT bool from_string(std::string_view, mailbox_overflow_policy&);
+
+/// @relates mailbox_overflow_policy
+CAF_CORE_EXPORT bool from_integer(std::underlying_type_t<mailbox_overflow_policy>,
+                                  mailbox_overflow_policy&);
+
+/// @relates mailbox_overflow_policy
+template <class Inspector>
+bool inspect(Inspector& f, mailbox_overflow_policy& x) {
+  return default_enum_inspect(f, x);
+}
+
+} // namespace caf
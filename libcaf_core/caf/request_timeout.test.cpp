@@ -12,6 +12,7 @@
 #include "caf/stateful_actor.hpp"
 
 #include <chrono>
+#include <vector>
 
 using namespace caf;
 using namespace std::literals;
@@ -301,6 +302,75 @@ TEST("multiplexed timeout") {
   }
 }
 
+TEST("pending requests share a single clock entry for their timeouts") {
+  auto num_errors = std::make_shared<size_t>(0);
+  auto on_error = [num_errors](const error& err) {
+    test::runnable::current().require_eq(err, sec::request_timeout);
+    ++*num_errors;
+  };
+  auto sink = sys.spawn([](event_based_actor* self) -> behavior {
+    auto promises = std::make_shared<std::vector<response_promise>>();
+    return {
+      [self, promises](ping_atom) {
+        promises->emplace_back(self->make_response_promise());
+      },
+    };
+  });
+  SECTION("all requests time out together") {
+    sys.spawn([sink, on_error](event_based_actor* self) {
+      for (auto i = 0; i < 10; ++i)
+        self->mail(ping_atom_v)
+          .request(sink, 1s)
+          .then([](pong_atom) { test::runnable::current().fail("got pong"); },
+                on_error);
+    });
+    check_eq(num_timeouts(), 1u);
+    dispatch_messages();
+    check_eq(*num_errors, 0u);
+    trigger_timeout();
+    dispatch_messages();
+    check_eq(*num_errors, 10u);
+    check_eq(num_timeouts(), 0u);
+  }
+  SECTION("requests with different timeouts use separate clock entries") {
+    sys.spawn([sink, on_error](event_based_actor* self) {
+      for (auto timeout : {10s, 1s})
+        self->mail(ping_atom_v)
+          .request(sink, timeout)
+          .then([](pong_atom) { test::runnable::current().fail("got pong"); },
+                on_error);
+    });
+    check_eq(num_timeouts(), 2u);
+    dispatch_messages();
+    trigger_timeout();
+    dispatch_messages();
+    check_eq(*num_errors, 1u);
+    check_eq(num_timeouts(), 1u);
+    trigger_timeout();
+    dispatch_messages();
+    check_eq(*num_errors, 2u);
+    check_eq(num_timeouts(), 0u);
+  }
+  // The promises keep the sink alive until it terminates.
+  anon_send_exit(sink, exit_reason::user_shutdown);
+  dispatch_messages();
+}
+
+TEST("the last response cancels the scheduled timeout") {
+  auto num_responses = std::make_shared<size_t>(0);
+  auto buddy = sys.spawn(pong);
+  sys.spawn([buddy, num_responses](event_based_actor* self) {
+    for (auto i = 0; i < 3; ++i)
+      self->mail(ping_atom_v)
+        .request(buddy, 1s)
+        .then([num_responses](pong_atom) { ++*num_responses; });
+  });
+  check_eq(num_timeouts(), 1u);
+  dispatch_messages();
+  check_eq(*num_responses, 3u);
+  check_eq(num_timeouts(), 0u);
+}
+
 } // WITH_FIXTURE(test::fixture::deterministic)
 
 } // namespace
@@ -16,4 +16,8 @@ resumable::subtype_t resumable::subtype() const noexcept {
   return unspecified;
 }
 
+scheduling_class resumable::sched_class() const noexcept {
+  return scheduling_class::normal;
+}
+
 } // namespace caf
@@ -6,6 +6,7 @@
 
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
+#include "caf/scheduling_class.hpp"
 
 #include <type_traits>
 
@@ -44,6 +45,11 @@ public:
   /// delegate other subtypes to dedicated workers.
   virtual subtype_t subtype() const noexcept;
 
+  /// Returns the scheduling class of this object. Schedulers may use separate
+  /// queues and throughput budgets for each class. The default implementation
+  /// returns `scheduling_class::normal`.
+  virtual scheduling_class sched_class() const noexcept;
+
   /// Resume any pending computation until it is either finished
   /// or needs to be re-scheduled later.
   virtual resume_result resume(scheduler*, size_t max_throughput) = 0;
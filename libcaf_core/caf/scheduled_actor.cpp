@@ -6,6 +6,7 @@
 
 #include "caf/action.hpp"
 #include "caf/actor_ostream.hpp"
+#include "caf/actor_profiler.hpp"
 #include "caf/anon_mail.hpp"
 #include "caf/config.hpp"
 #include "caf/defaults.hpp"
@@ -25,6 +26,9 @@
 #include "caf/send.hpp"
 #include "caf/stream.hpp"
 
+#include <algorithm>
+#include <mutex>
+
 using namespace std::string_literals;
 
 namespace caf {
@@ -70,6 +74,118 @@ skippable_result drop_after_quit(scheduled_actor* self, message&) {
 
 } // namespace
 
+namespace detail {
+
+// Groups request timeouts that share a single clock entry. The clock delivers
+// the timeout messages for all requests of a batch that are still pending once
+// the latest deadline of the batch passes.
+class request_timeout_batch : public ref_counted {
+public:
+  // Cancels the timeout of a single request in the batch.
+  class entry : public ref_counted, public disposable::impl {
+  public:
+    entry(request_timeout_batch* batch, size_t index)
+      : batch_(batch), index_(index) {
+      // nop
+    }
+
+    void dispose() override {
+      if (!disposed_.exchange(true))
+        batch_->cancel(index_);
+    }
+
+    bool disposed() const noexcept override {
+      return disposed_.load();
+    }
+
+    void ref_disposable() const noexcept override {
+      ref();
+    }
+
+    void deref_disposable() const noexcept override {
+      deref();
+    }
+
+    friend void intrusive_ptr_add_ref(const entry* ptr) noexcept {
+      ptr->ref();
+    }
+
+    friend void intrusive_ptr_release(const entry* ptr) noexcept {
+      ptr->deref();
+    }
+
+  private:
+    intrusive_ptr<request_timeout_batch> batch_;
+    size_t index_;
+    std::atomic<bool> disposed_ = false;
+  };
+
+  explicit request_timeout_batch(weak_actor_ptr self) : self_(std::move(self)) {
+    // nop
+  }
+
+  // Adds a request to the batch.
+  disposable add(message_id response_id, actor_clock::time_point when) {
+    std::unique_lock guard{mtx_};
+    when_ = std::max(when_, when);
+    mids_.push_back(response_id);
+    ++pending_;
+    return disposable{make_counted<entry>(this, mids_.size() - 1)};
+  }
+
+  // Schedules the timeout messages unless all requests received a response.
+  void schedule(actor_clock& clock) {
+    std::unique_lock guard{mtx_};
+    if (pending_ == 0)
+      return;
+    auto fn = [ptr = intrusive_ptr{this}] { ptr->fire(); };
+    clock_entry_ = clock.schedule(when_, make_single_shot_action(fn));
+  }
+
+private:
+  // Drops the timeout for the request at `index`.
+  void cancel(size_t index) {
+    disposable clock_entry;
+    {
+      std::unique_lock guard{mtx_};
+      if (index >= mids_.size() || mids_[index].integer_value() == 0)
+        return;
+      mids_[index] = message_id{};
+      if (--pending_ == 0)
+        clock_entry.swap(clock_entry_);
+    }
+    clock_entry.dispose();
+  }
+
+  // Delivers the timeout messages for all pending requests.
+  void fire() {
+    std::vector<message_id> mids;
+    {
+      std::unique_lock guard{mtx_};
+      mids.swap(mids_);
+      pending_ = 0;
+      clock_entry_ = disposable{};
+    }
+    auto ptr = self_.lock();
+    if (!ptr)
+      return;
+    for (auto mid : mids)
+      if (mid.integer_value() != 0)
+        ptr->enqueue(make_mailbox_element(nullptr, mid,
+                                          make_error(sec::request_timeout)),
+                     nullptr);
+  }
+
+  std::mutex mtx_;
+  weak_actor_ptr self_;
+  actor_clock::time_point when_;
+  std::vector<message_id> mids_;
+  size_t pending_ = 0;
+  disposable clock_entry_;
+};
+
+} // namespace detail
+
 // -- static helper functions --------------------------------------------------
 
 void scheduled_actor::default_error_handler(scheduled_actor* ptr, error& x) {
@@ -163,6 +279,7 @@ bool scheduled_actor::enqueue(mailbox_element_ptr ptr, scheduler* sched) {
     ptr->set_enqueue_time();
     metrics_.mailbox_size->inc();
   }
+  CAF_ENQUEUED(this, *ptr);
   switch (mailbox().push_back(std::move(ptr))) {
     case intrusive::inbox_result::unblocked_reader: {
       CAF_LOG_ACCEPT_EVENT(true);
@@ -199,6 +316,14 @@ mailbox_element* scheduled_actor::peek_at_next_mailbox_element() {
                           : std::get<0>(*awaited_responses_.begin()));
 }
 
+size_t scheduled_actor::mailbox_size_hint() const noexcept {
+  return mailbox_->size_hint();
+}
+
+void scheduled_actor::enable_mailbox_size_hint() noexcept {
+  mailbox_->enable_size_hint();
+}
+
 // -- overridden functions of local_actor --------------------------------------
 
 const char* scheduled_actor::name() const {
@@ -234,18 +359,47 @@ void scheduled_actor::on_cleanup(const error& reason) {
   // Clear state for open requests, flows and streams.
   awaited_responses_.clear();
   multiplexed_responses_.clear();
+  open_request_timeouts_.clear();
   cancel_flows_and_streams();
   close_mailbox(reason);
   // Dispatch to parent's `on_cleanup` function.
   super::on_cleanup(reason);
 }
 
+disposable scheduled_actor::request_response_timeout(timespan timeout,
+                                                     message_id mid) {
+  auto lg = log::core::trace("timeout = {}, mid = {}", timeout, mid);
+  if (timeout == infinite)
+    return {};
+  // Requests with the same relative timeout that the actor sends during the
+  // same activation share a single clock entry.
+  auto same_timeout = [timeout](const auto& x) { return x.first == timeout; };
+  auto i = std::find_if(open_request_timeouts_.begin(),
+                        open_request_timeouts_.end(), same_timeout);
+  if (i == open_request_timeouts_.end()) {
+    if (open_request_timeouts_.empty())
+      delay(make_action([this] { flush_request_timeouts(); }));
+    auto batch = make_counted<detail::request_timeout_batch>(ctrl());
+    open_request_timeouts_.emplace_back(timeout, std::move(batch));
+    i = std::prev(open_request_timeouts_.end());
+  }
+  return i->second->add(mid.response_id(), clock().now() + timeout);
+}
+
 // -- overridden functions of resumable ----------------------------------------
 
 resumable::subtype_t scheduled_actor::subtype() const noexcept {
   return resumable::scheduled_actor;
 }
 
+scheduling_class scheduled_actor::sched_class() const noexcept {
+  if (getf(is_latency_sensitive_flag))
+    return scheduling_class::latency;
+  if (getf(is_batch_flag))
+    return scheduling_class::batch;
+  return scheduling_class::normal;
+}
+
 void scheduled_actor::ref_resumable() const noexcept {
   intrusive_ptr_add_ref(ctrl());
 }
@@ -283,6 +437,7 @@ resumable::resume_result scheduled_actor::resume(scheduler* sched,
       }
       continue; // Interrupted by a new message, try again.
     }
+    CAF_DEQUEUED(this, *ptr);
     auto res = run_with_metrics(*ptr, [this, &ptr, &consumed] {
       auto res = reactivate(*ptr);
       switch (res) {
@@ -334,6 +489,7 @@ void scheduled_actor::quit(error x) {
   bhvr_stack_.clear();
   awaited_responses_.clear();
   multiplexed_responses_.clear();
+  open_request_timeouts_.clear();
   // Ignore future exit, down and error messages.
   exit_handler_ = silently_ignore<exit_msg>;
   down_handler_ = silently_ignore<down_msg>;
@@ -424,6 +580,12 @@ void scheduled_actor::handle_timeout() {
   }
 }
 
+void scheduled_actor::flush_request_timeouts() {
+  for (auto& [timeout, batch] : open_request_timeouts_)
+    batch->schedule(clock());
+  open_request_timeouts_.clear();
+}
+
 // -- caf::flow API ------------------------------------------------------------
 
 namespace detail {
@@ -906,7 +1068,13 @@ auto scheduled_actor::reactivate(mailbox_element& x) -> activation_result {
   };
   try {
 #endif // CAF_ENABLE_EXCEPTIONS
-    switch (consume(x)) {
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+    trace_context::guard trace_guard{x.trace};
+#endif
+    CAF_BEFORE_PROCESSING(this, x);
+    auto consume_res = consume(x);
+    CAF_AFTER_PROCESSING(this, consume_res);
+    switch (consume_res) {
       case invoke_message_result::dropped:
         return activation_result::dropped;
       case invoke_message_result::consumed:
@@ -35,6 +35,7 @@
 #include <forward_list>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #ifdef CAF_ENABLE_EXCEPTIONS
 #  include <exception>
@@ -44,6 +45,7 @@
 namespace caf::detail {
 
 class batch_forwarder_impl;
+class request_timeout_batch;
 
 } // namespace caf::detail
 
@@ -200,6 +202,10 @@ public:
 
   mailbox_element* peek_at_next_mailbox_element() override;
 
+  size_t mailbox_size_hint() const noexcept override;
+
+  void enable_mailbox_size_hint() noexcept override;
+
   // -- overridden functions of local_actor ------------------------------------
 
   const char* name() const override;
@@ -208,10 +214,14 @@ public:
 
   void on_cleanup(const error& reason) override;
 
+  disposable request_response_timeout(timespan d, message_id mid) override;
+
   // -- overridden functions of resumable --------------------------------------
 
   subtype_t subtype() const noexcept override;
 
+  scheduling_class sched_class() const noexcept override;
+
   void ref_resumable() const noexcept final;
 
   void deref_resumable() const noexcept final;
@@ -689,8 +699,10 @@ protected:
   /// Stores callbacks for awaited responses.
   std::forward_list<pending_response> awaited_responses_;
 
-  /// Stores callbacks for multiplexed responses.
-  unordered_flat_map<message_id, std::pair<behavior, disposable>>
+  /// Stores callbacks for multiplexed responses. Uses a hash map, because
+  /// actors may have thousands of pending requests and look up a handler for
+  /// each incoming response.
+  std::unordered_map<message_id, std::pair<behavior, disposable>>
     multiplexed_responses_;
 
   /// Customization point for setting a default `message` callback.
@@ -762,6 +774,17 @@ private:
   /// Stores the current timeout state.
   timeout_state timeout_state_;
 
+  /// Passes all open batches of request timeouts to the clock.
+  void flush_request_timeouts();
+
+  /// Batches of request timeouts that the actor did not yet pass to the clock.
+  /// Rather than scheduling one clock entry per request, the actor groups all
+  /// requests with the same relative timeout that it sends during a single
+  /// activation and schedules one clock entry per group at the end of the
+  /// activation.
+  std::vector<std::pair<timespan, intrusive_ptr<detail::request_timeout_batch>>>
+    open_request_timeouts_;
+
   template <class T>
   flow::assert_scheduled_actor_hdr_t<flow::single<T>>
   single_from_response(message_id mid, disposable pending_timeout);
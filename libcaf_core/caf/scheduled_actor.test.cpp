@@ -201,4 +201,49 @@ TEST("actors can override the default exception handler") {
 
 #endif // CAF_ENABLE_EXCEPTIONS
 
+constexpr int num_requests = 5000;
+
+TEST("actors may have thousands of pending requests") {
+  actor_system_config cfg;
+  actor_system system{cfg};
+  scoped_actor self{system};
+  // The server answers all requests in reverse order once all have arrived.
+  auto server = self->spawn([](event_based_actor* server_self) {
+    auto pending = std::make_shared<std::vector<response_promise>>();
+    return behavior{
+      [server_self, pending](int x) {
+        auto rp = server_self->make_response_promise();
+        pending->emplace_back(rp);
+        if (pending->size() == static_cast<size_t>(num_requests))
+          for (auto i = pending->rbegin(); i != pending->rend(); ++i)
+            i->deliver(x);
+        return rp;
+      },
+    };
+  });
+  auto client = self->spawn([server](event_based_actor* client_self) {
+    auto received = std::make_shared<int>(0);
+    return behavior{
+      [client_self, server, received](get_atom) {
+        auto rp = client_self->make_response_promise<int>();
+        for (int i = 0; i < num_requests; ++i) {
+          client_self->mail(i)
+            .request(server, infinite)
+            .then([received, rp](int) mutable {
+              if (++*received == num_requests)
+                rp.deliver(*received);
+            });
+        }
+        return rp;
+      },
+    };
+  });
+  self->mail(get_atom_v)
+    .request(client, infinite)
+    .receive([this](int count) { check_eq(count, num_requests); },
+             [this](const error& err) { fail("unexpected error: {}", err); });
+  self->send_exit(client, exit_reason::user_shutdown);
+  self->send_exit(server, exit_reason::user_shutdown);
+}
+
 } // namespace
@@ -12,20 +12,28 @@
 #include "caf/defaults.hpp"
 #include "caf/detail/assert.hpp"
 #include "caf/detail/cleanup_and_release.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/default_thread_count.hpp"
 #include "caf/detail/double_ended_queue.hpp"
+#include "caf/log/core.hpp"
 #include "caf/logger.hpp"
 #include "caf/scheduled_actor.hpp"
 #include "caf/scoped_actor.hpp"
 #include "caf/send.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 #include "caf/thread_owner.hpp"
 
+#include <algorithm>
+#include <array>
 #include <condition_variable>
 #include <fstream>
 #include <ios>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <random>
+#include <string_view>
 #include <thread>
 
 namespace caf {
@@ -38,6 +46,30 @@ namespace {
 
 namespace work_stealing {
 
+// Groups victims for topology-aware stealing by their distance to the thief.
+enum victim_group : size_t {
+  // Workers that share the last-level cache with the thief.
+  shared_cache,
+  // Workers on the same NUMA node, but with a different last-level cache.
+  same_node,
+  // Workers on other NUMA nodes.
+  remote_node,
+  // The number of groups.
+  num_victim_groups,
+};
+
+// Number of lanes in the job queue of each worker, one per scheduling class.
+constexpr size_t num_scheduling_classes = 3;
+
+// Stores one value per scheduling class.
+using per_class_array = std::array<size_t, num_scheduling_classes>;
+
+// Returns the queue lane for `job`. Thieves take jobs from the lowest lane
+// first, i.e., from the lane for latency-sensitive actors.
+size_t lane_of(const resumable* job) {
+  return static_cast<size_t>(job->sched_class());
+}
+
 // Holds job queue of a worker and a random number generator.
 struct worker_data {
   // Configuration for aggressive/moderate/relaxed poll strategies.
@@ -85,12 +117,29 @@ struct worker_data {
 
   // This queue is exposed to other workers that may attempt to steal jobs
   // from it and the central scheduling unit can push new jobs to the queue.
-  detail::double_ended_queue<resumable> queue;
+  detail::double_ended_queue<resumable, num_scheduling_classes> queue;
 
   // Needed to generate pseudo random numbers.
   std::default_random_engine rengine;
   std::uniform_int_distribution<size_t> uniform;
   std::array<poll_strategy, 3> strategies;
+
+  // Stores the IDs of all other workers, grouped by their distance to this
+  // worker. Remains empty unless the scheduler runs in topology-aware mode.
+  std::array<std::vector<size_t>, num_victim_groups> victims;
+
+  // Counts successful steals per victim group in topology-aware mode.
+  std::array<telemetry::int_counter*, num_victim_groups> steals{};
+
+  // Number of failed steal attempts on the same NUMA node before trying to
+  // steal from other NUMA nodes.
+  size_t remote_steal_threshold = 0;
+
+  // Counts failed steal attempts since the last attempt on another NUMA node.
+  size_t failed_steals = 0;
+
+  // The CPU for the worker thread, if pinned.
+  std::optional<size_t> cpu;
 };
 
 /// Implementation of the work stealing worker class.
@@ -100,9 +149,9 @@ public:
 
   template <class SchedulerImpl>
   worker(size_t worker_id, SchedulerImpl*, const worker_data& init,
-         size_t throughput)
+         const per_class_array& throughput, const per_class_array& weights)
     : max_throughput_(throughput), id_(worker_id), data_(init) {
-    // nop
+    data_.queue.weights(weights);
   }
 
   worker(const worker&) = delete;
@@ -126,12 +175,12 @@ public:
 
   void schedule(job_ptr job) override {
     CAF_ASSERT(job != nullptr);
-    data_.queue.append(job);
+    data_.queue.append(job, lane_of(job));
   }
 
   void delay(job_ptr job) override {
     CAF_ASSERT(job != nullptr);
-    data_.queue.prepend(job);
+    data_.queue.prepend(job, lane_of(job));
   }
 
   size_t id() const {
@@ -146,8 +195,8 @@ public:
     return data_;
   }
 
-  size_t max_throughput() {
-    return max_throughput_;
+  size_t max_throughput(scheduling_class cls = scheduling_class::normal) {
+    return max_throughput_[static_cast<size_t>(cls)];
   }
 
 private:
@@ -158,6 +207,8 @@ private:
       // You can't steal from yourself, can you?
       return nullptr;
     }
+    if (p->topology_aware())
+      return try_steal_nearby(p);
     // Roll the dice to pick a victim other than ourselves.
     auto victim = data_.uniform(data_.rengine);
     if (victim == this->id())
@@ -166,6 +217,34 @@ private:
     return p->worker_by_id(victim)->data_.queue.try_take_tail();
   }
 
+  // Prefers victims that share the cache or the NUMA node with this worker.
+  // Moving a job to another NUMA node is expensive, so we only try remote
+  // victims after repeatedly failing to steal from nearby workers.
+  template <typename Parent>
+  resumable* try_steal_nearby(Parent* p) {
+    auto steal_from = [this, p](victim_group group) -> resumable* {
+      auto& ids = data_.victims[group];
+      if (ids.empty())
+        return nullptr;
+      using dist_type = std::uniform_int_distribution<size_t>;
+      auto victim = ids[dist_type{0, ids.size() - 1}(data_.rengine)];
+      auto* job = p->worker_by_id(victim)->data_.queue.try_take_tail();
+      if (job != nullptr)
+        data_.steals[group]->inc();
+      return job;
+    };
+    for (auto group : {shared_cache, same_node}) {
+      if (auto* job = steal_from(group)) {
+        data_.failed_steals = 0;
+        return job;
+      }
+    }
+    if (++data_.failed_steals < data_.remote_steal_threshold)
+      return nullptr;
+    data_.failed_steals = 0;
+    return steal_from(remote_node);
+  }
+
   template <typename Parent>
   resumable* policy_dequeue(Parent* parent) {
     // We wait for new jobs by polling our external queue: first, we assume an
@@ -201,18 +280,21 @@ private:
   template <typename Parent>
   void run(Parent* parent) {
     CAF_SET_LOGGER_SYS(&parent->system());
+    if (data_.cpu && !detail::pin_current_thread(*data_.cpu))
+      log::core::warning("failed to pin worker {} to CPU {}", id_, *data_.cpu);
     // scheduling loop
     for (;;) {
       auto job = policy_dequeue(parent);
       CAF_ASSERT(job != nullptr);
       CAF_ASSERT(job->subtype() != resumable::io_actor);
-      auto res = job->resume(this, max_throughput_);
+      auto lane = lane_of(job);
+      auto res = job->resume(this, max_throughput_[lane]);
       switch (res) {
         case resumable::resume_later: {
           // Keep reference to this actor, as it remains in the "loop" job has
           // voluntarily released the CPU to let others run instead this means
           // we are going to put this job to the very end of our queue.
-          data_.queue.unsafe_append(job);
+          data_.queue.unsafe_append(job, lane);
           break;
         }
         case resumable::done: {
@@ -230,8 +312,9 @@ private:
       }
     }
   }
-  // Number of messages each actor is allowed to consume per resume.
-  size_t max_throughput_;
+  // Number of messages each actor is allowed to consume per resume, indexed
+  // by scheduling class.
+  per_class_array max_throughput_;
 
   // The worker's thread.
   std::thread this_thread_;
@@ -252,6 +335,31 @@ public:
                              defaults::scheduler::max_throughput);
     num_workers_ = get_or(cfg, "caf.scheduler.max-threads",
                           detail::default_thread_count());
+    topology_aware_ = get_or(cfg, "caf.work-stealing.topology-aware",
+                             defaults::work_stealing::topology_aware);
+    // Weights of zero would starve a class entirely.
+    auto weight = [&cfg](std::string_view key, size_t fallback) {
+      return std::max(get_or(cfg, key, fallback), size_t{1});
+    };
+    weights_ = {{
+      weight("caf.scheduler.latency-weight",
+             defaults::scheduler::latency_weight),
+      weight("caf.scheduler.normal-weight", defaults::scheduler::normal_weight),
+      weight("caf.scheduler.batch-weight", defaults::scheduler::batch_weight),
+    }};
+    // Scale the throughput for each class relative to normal actors.
+    auto normal = weights_[static_cast<size_t>(scheduling_class::normal)];
+    for (size_t lane = 0; lane < num_scheduling_classes; ++lane) {
+      constexpr auto max_size = std::numeric_limits<size_t>::max();
+      auto& budget = throughputs_[lane];
+      if (max_throughput_ > max_size / weights_[lane])
+        budget = max_size;
+      else
+        budget = std::max(max_throughput_ * weights_[lane] / normal, size_t{1});
+    }
+    // Never change the budget of normal actors, even with rounding errors.
+    throughputs_[static_cast<size_t>(scheduling_class::normal)]
+      = max_throughput_;
   }
 
   using worker_type = worker;
@@ -274,6 +382,10 @@ public:
     return num_workers_;
   }
 
+  bool topology_aware() const noexcept {
+    return topology_aware_;
+  }
+
   // -- implementation of scheduler interface ----------------------------------
 
   void schedule(resumable* ptr) override {
@@ -292,8 +404,10 @@ public:
     workers_.reserve(num_workers_);
     // Create worker instances.
     for (size_t i = 0; i < num_workers_; ++i)
-      workers_.emplace_back(
-        std::make_unique<worker_type>(i, this, init, max_throughput_));
+      workers_.emplace_back(std::make_unique<worker_type>(
+        i, this, init, throughputs_, weights_));
+    if (topology_aware_)
+      init_topology();
     // Start all workers.
     for (auto& w : workers_)
       w->start(this);
@@ -356,6 +470,48 @@ public:
   }
 
 private:
+  /// Assigns a CPU to each worker and groups the victims of each worker by
+  /// their distance. Workers share CPUs if there are more workers than CPUs.
+  void init_topology() {
+    auto& cfg = config();
+    auto cpus = detail::read_cpu_topology();
+    auto pin = get_or(cfg, "caf.work-stealing.pin-workers",
+                      defaults::work_stealing::pin_workers);
+    auto threshold
+      = get_or(cfg, "caf.work-stealing.remote-steal-threshold",
+               defaults::work_stealing::remote_steal_threshold);
+    auto* steals = sys_->metrics().counter_family(
+      "caf.scheduler", "steals", {"locality"},
+      "Number of jobs that workers stole from other workers.");
+    auto counters = std::array<telemetry::int_counter*, num_victim_groups>{{
+      steals->get_or_add({{"locality", "shared-cache"}}),
+      steals->get_or_add({{"locality", "same-node"}}),
+      steals->get_or_add({{"locality", "remote-node"}}),
+    }};
+    auto cpu_of = [&cpus](size_t worker_id) -> const detail::cpu_info& {
+      return cpus[worker_id % cpus.size()];
+    };
+    for (size_t i = 0; i < num_workers_; ++i) {
+      auto& data = workers_[i]->data();
+      auto& self = cpu_of(i);
+      if (pin)
+        data.cpu = self.id;
+      data.steals = counters;
+      data.remote_steal_threshold = threshold;
+      for (size_t j = 0; j < num_workers_; ++j) {
+        if (i == j)
+          continue;
+        auto& other = cpu_of(j);
+        if (other.node_id != self.node_id)
+          data.victims[remote_node].push_back(j);
+        else if (other.cache_id != self.cache_id)
+          data.victims[same_node].push_back(j);
+        else
+          data.victims[shared_cache].push_back(j);
+      }
+    }
+  }
+
   /// Set of workers.
   std::vector<std::unique_ptr<worker_type>> workers_;
 
@@ -368,9 +524,19 @@ private:
   /// Number of messages each actor is allowed to consume per resume.
   size_t max_throughput_ = 0;
 
+  /// Number of messages each actor is allowed to consume per resume, indexed
+  /// by scheduling class.
+  per_class_array throughputs_ = {};
+
+  /// Relative share of each scheduling class.
+  per_class_array weights_ = {};
+
   /// Configured number of workers.
   size_t num_workers_ = 0;
 
+  /// Configures whether workers take the CPU topology into account.
+  bool topology_aware_ = false;
+
   /// Reference to the host system.
   actor_system* sys_ = nullptr;
 };
@@ -468,6 +634,8 @@ private:
   size_t id_;
 };
 
+/// Implementation of the work sharing scheduler. Ignores scheduling classes,
+/// since all workers share a single FIFO queue.
 class scheduler_impl : public scheduler {
 public:
   using super = scheduler;
@@ -5,12 +5,24 @@
 #include "caf/scheduler.hpp"
 
 #include "caf/test/outline.hpp"
+#include "caf/test/test.hpp"
 
+#include "caf/actor_system.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/detail/latch.hpp"
+#include "caf/event_based_actor.hpp"
 #include "caf/resumable.hpp"
+#include "caf/scheduled_actor.hpp"
+#include "caf/scheduling_class.hpp"
+#include "caf/spawn_options.hpp"
+#include "caf/telemetry/metric.hpp"
+#include "caf/telemetry/metric_family.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 
+#include <mutex>
+#include <set>
 #include <string>
+#include <vector>
 
 using namespace caf;
 using namespace std::literals;
@@ -178,4 +190,165 @@ OUTLINE("scheduling units that are awaiting") {
   )";
 }
 
+// Collects the label values of all `caf.scheduler.steals` counters.
+struct steals_collector {
+  template <class T>
+  void operator()(const telemetry::metric_family* family,
+                  const telemetry::metric* instance, const T*) {
+    if (family->prefix() != "caf.scheduler" || family->name() != "steals")
+      return;
+    for (auto& lbl : instance->labels())
+      localities.insert(std::string{lbl.value()});
+  }
+
+  std::set<std::string> localities;
+};
+
+TEST("the topology-aware work stealing scheduler runs all resumables") {
+  actor_system_config cfg;
+  cfg.set("caf.scheduler.policy", "stealing");
+  cfg.set("caf.scheduler.max-threads", 4);
+  cfg.set("caf.scheduler.max-throughput", 5);
+  cfg.set("caf.work-stealing.topology-aware", true);
+  auto sys = std::make_unique<actor_system>(cfg);
+  auto workers = std::vector<intrusive_ptr<testee>>{};
+  auto rendezvous = std::make_shared<latch>(11);
+  for (int i = 0; i < 10; i++) {
+    workers.emplace_back(make_counted<testee>(rendezvous));
+    workers.back()->ref();
+    sys->scheduler().schedule(workers.back().get());
+  }
+  rendezvous->count_down_and_wait();
+  for (const auto& worker : workers)
+    check_eq(worker->runs, 10u);
+  SECTION("the scheduler reports steals by locality") {
+    steals_collector collector;
+    sys->metrics().collect(collector);
+    check_eq(collector.localities,
+             std::set<std::string>{"remote-node", "same-node", "shared-cache"});
+  }
+  sys = nullptr;
+  for (const auto& worker : workers)
+    check_eq(worker->get_reference_count(), 1u);
+}
+
+// Records the order in which the scheduler runs jobs of different classes.
+struct classed_testee : resumable, ref_counted {
+  classed_testee(scheduling_class cls, std::shared_ptr<latch> latch_handle,
+                 std::mutex& mtx, std::vector<scheduling_class>& order)
+    : cls(cls), rendezvous(std::move(latch_handle)), mtx(mtx), order(order) {
+  }
+
+  subtype_t subtype() const noexcept override {
+    return resumable::function_object;
+  }
+
+  scheduling_class sched_class() const noexcept override {
+    return cls;
+  }
+
+  resume_result resume(scheduler*, size_t max_throughput) override {
+    received_throughput = max_throughput;
+    {
+      std::lock_guard guard{mtx};
+      order.push_back(cls);
+    }
+    rendezvous->count_down();
+    return resumable::done;
+  }
+
+  void ref_resumable() const noexcept final {
+    ref();
+  }
+
+  void deref_resumable() const noexcept final {
+    deref();
+  }
+
+  scheduling_class cls;
+  std::atomic<size_t> received_throughput = 0;
+  std::shared_ptr<latch> rendezvous;
+  std::mutex& mtx;
+  std::vector<scheduling_class>& order;
+};
+
+// Blocks the worker that runs it until the test opens the gate.
+struct gate : resumable, ref_counted {
+  subtype_t subtype() const noexcept override {
+    return resumable::function_object;
+  }
+
+  resume_result resume(scheduler*, size_t) override {
+    entered.count_down();
+    opened.wait();
+    return resumable::done;
+  }
+
+  void ref_resumable() const noexcept final {
+    ref();
+  }
+
+  void deref_resumable() const noexcept final {
+    deref();
+  }
+
+  latch entered{1};
+  latch opened{1};
+};
+
+TEST("spawn options select the scheduling class of actors") {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  auto dummy = [] { return behavior{[](int) {}}; };
+  auto sched_class_of = [](const actor& hdl) {
+    auto* ptr = actor_cast<abstract_actor*>(hdl);
+    return dynamic_cast<scheduled_actor*>(ptr)->sched_class();
+  };
+  check_eq(sched_class_of(sys.spawn(dummy)), scheduling_class::normal);
+  check_eq(sched_class_of(sys.spawn<latency_sensitive>(dummy)),
+           scheduling_class::latency);
+  check_eq(sched_class_of(sys.spawn<batch_processing>(dummy)),
+           scheduling_class::batch);
+}
+
+TEST("the work stealing scheduler prefers latency-sensitive jobs") {
+  actor_system_config cfg;
+  cfg.set("caf.scheduler.policy", "stealing");
+  cfg.set("caf.scheduler.max-threads", 1);
+  cfg.set("caf.scheduler.max-throughput", 10);
+  auto sys = std::make_unique<actor_system>(cfg);
+  // Block the only worker while filling its queue.
+  auto blocker = make_counted<gate>();
+  blocker->ref();
+  sys->scheduler().schedule(blocker.get());
+  blocker->entered.wait();
+  std::mutex mtx;
+  std::vector<scheduling_class> order;
+  auto rendezvous = std::make_shared<latch>(4);
+  auto jobs = std::vector<intrusive_ptr<classed_testee>>{};
+  for (auto cls : {scheduling_class::batch, scheduling_class::normal,
+                   scheduling_class::latency}) {
+    jobs.emplace_back(
+      make_counted<classed_testee>(cls, rendezvous, mtx, order));
+    jobs.back()->ref();
+    sys->scheduler().schedule(jobs.back().get());
+  }
+  blocker->opened.count_down();
+  rendezvous->count_down_and_wait();
+  SECTION("the worker runs the jobs in order of their weight") {
+    std::lock_guard guard{mtx};
+    check_eq(order, std::vector{scheduling_class::latency,
+                                scheduling_class::normal,
+                                scheduling_class::batch});
+  }
+  SECTION("the throughput of each job scales with its weight") {
+    check_eq(jobs[0]->received_throughput, 5u);
+    check_eq(jobs[1]->received_throughput, 10u);
+    check_eq(jobs[2]->received_throughput, 20u);
+  }
+  sys = nullptr;
+  for (const auto& job : jobs)
+    check_eq(job->get_reference_count(), 1u);
+}
+
 } // namespace
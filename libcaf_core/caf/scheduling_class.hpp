@@ -0,0 +1,47 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/default_enum_inspect.hpp"
+#include "caf/detail/core_export.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace caf {
+
+/// Selects how the scheduler prioritizes an actor relative to other actors.
+/// The work-stealing scheduler keeps separate queues for each class and
+/// weights the throughput budget of each actor by its class.
+enum class scheduling_class {
+  /// Receives the largest share of each worker. Suitable for actors that
+  /// handle few messages but must respond quickly, e.g., control-plane actors.
+  latency,
+  /// The default class for all actors.
+  normal,
+  /// Receives the smallest share of each worker. Suitable for actors with
+  /// deep mailboxes that process data in bulk.
+  batch,
+};
+
+/// @relates scheduling_class
+CAF_CORE_EXPORT std::string to_string(scheduling_class);
+
+/// @relates scheduling_class
+CAF_CORE_EXPORT bool from_string(std::string_view, scheduling_class&);
+
+/// @relates scheduling_class
+CAF_CORE_EXPORT bool from_integer(std::underlying_type_t<scheduling_class>,
+                                  scheduling_class&);
+
+/// @relates scheduling_class
+template <class Inspector>
+bool inspect(Inspector& f, scheduling_class& x) {
+  return default_enum_inspect(f, x);
+}
+
+} // namespace caf
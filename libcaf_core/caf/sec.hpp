@@ -175,6 +175,9 @@ enum class sec : uint8_t {
   invalid_utf8,
   /// A downstream operator failed to process inputs on time.
   backpressure_overflow,
+  /// Signals that a bounded mailbox rejected a message because it has reached
+  /// its capacity.
+  mailbox_full,
 };
 // --(rst-sec-end)--
 
@@ -17,7 +17,9 @@ enum class spawn_options : int {
   detach_flag = 0x04,
   hide_flag = 0x08,
   priority_aware_flag = 0x20,
-  lazy_init_flag = 0x40
+  lazy_init_flag = 0x40,
+  latency_flag = 0x80,
+  batch_flag = 0x100
 };
 
 /// Concatenates two {@link spawn_options}.
@@ -46,6 +48,13 @@ constexpr spawn_options hidden = spawn_options::hide_flag;
 /// initialization until a message arrives.
 constexpr spawn_options lazy_init = spawn_options::lazy_init_flag;
 
+/// Causes the scheduler to run the new actor with
+/// `scheduling_class::latency`.
+constexpr spawn_options latency_sensitive = spawn_options::latency_flag;
+
+/// Causes the scheduler to run the new actor with `scheduling_class::batch`.
+constexpr spawn_options batch_processing = spawn_options::batch_flag;
+
 /// Checks whether `haystack` contains `needle`.
 constexpr bool has_spawn_option(spawn_options haystack, spawn_options needle) {
   return (static_cast<int>(haystack) & static_cast<int>(needle)) != 0;
@@ -81,6 +90,16 @@ constexpr bool has_lazy_init_flag(spawn_options opts) {
   return has_spawn_option(opts, lazy_init);
 }
 
+/// Checks whether the {@link latency_sensitive} flag is set in `opts`.
+constexpr bool has_latency_flag(spawn_options opts) {
+  return has_spawn_option(opts, latency_sensitive);
+}
+
+/// Checks whether the {@link batch_processing} flag is set in `opts`.
+constexpr bool has_batch_flag(spawn_options opts) {
+  return has_spawn_option(opts, batch_processing);
+}
+
 /// @}
 
 /// @cond PRIVATE
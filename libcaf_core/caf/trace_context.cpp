@@ -0,0 +1,23 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/trace_context.hpp"
+
+namespace caf {
+
+namespace {
+
+thread_local trace_context current_trace_context;
+
+} // namespace
+
+trace_context trace_context::current() noexcept {
+  return current_trace_context;
+}
+
+void trace_context::current(trace_context ctx) noexcept {
+  current_trace_context = ctx;
+}
+
+} // namespace caf
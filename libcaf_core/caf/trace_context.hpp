@@ -0,0 +1,84 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <cstdint>
+
+namespace caf {
+
+/// Correlates messages that belong to the same chain of requests, across
+/// actors and nodes. While processing a message, an actor passes the context
+/// of that message on to all messages it sends. An @ref actor_profiler may
+/// assign new IDs when a message enters a mailbox.
+struct CAF_CORE_EXPORT trace_context {
+  // -- member types -----------------------------------------------------------
+
+  /// Sets the context of the calling thread for the lifetime of the guard and
+  /// restores the previous context afterwards.
+  class guard;
+
+  // -- member variables -------------------------------------------------------
+
+  /// Identifies a chain of messages. Zero denotes an untraced message.
+  uint64_t trace_id = 0;
+
+  /// Identifies a single step within the chain of messages.
+  uint64_t span_id = 0;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns whether this context belongs to a traced message.
+  explicit operator bool() const noexcept {
+    return trace_id != 0;
+  }
+
+  // -- thread-local state -----------------------------------------------------
+
+  /// Returns the context of the message that the calling thread currently
+  /// processes.
+  static trace_context current() noexcept;
+
+  /// Sets the context for the calling thread.
+  static void current(trace_context ctx) noexcept;
+};
+
+class trace_context::guard {
+public:
+  explicit guard(trace_context ctx) noexcept : prev_(current()) {
+    current(ctx);
+  }
+
+  guard(const guard&) = delete;
+
+  guard& operator=(const guard&) = delete;
+
+  ~guard() {
+    current(prev_);
+  }
+
+private:
+  trace_context prev_;
+};
+
+/// @relates trace_context
+inline bool operator==(trace_context x, trace_context y) noexcept {
+  return x.trace_id == y.trace_id && x.span_id == y.span_id;
+}
+
+/// @relates trace_context
+inline bool operator!=(trace_context x, trace_context y) noexcept {
+  return !(x == y);
+}
+
+/// @relates trace_context
+template <class Inspector>
+bool inspect(Inspector& f, trace_context& x) {
+  return f.object(x).fields(f.field("trace-id", x.trace_id),
+                            f.field("span-id", x.span_id));
+}
+
+} // namespace caf
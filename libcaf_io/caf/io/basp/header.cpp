@@ -9,6 +9,7 @@
 namespace caf::io::basp {
 
 const uint8_t header::named_receiver_flag;
+const uint8_t header::trace_context_flag;
 
 namespace {
 
@@ -47,6 +48,21 @@ bool heartbeat_valid(const header& hdr) {
          && zero(hdr.operation_data);
 }
 
+bool shared_memory_valid(const header& hdr) {
+  if (!zero(hdr.source_actor) || !zero(hdr.dest_actor))
+    return false;
+  switch (hdr.operation_data) {
+    case header::shared_memory_offer:
+      return !zero(hdr.payload_len);
+    case header::shared_memory_accept:
+    case header::shared_memory_reject:
+    case header::shared_memory_confirm:
+      return zero(hdr.payload_len);
+    default:
+      return false;
+  }
+}
+
 } // namespace
 
 bool valid(const header& hdr) {
@@ -67,6 +83,8 @@ bool valid(const header& hdr) {
       return down_message_valid(hdr);
     case message_type::heartbeat:
       return heartbeat_valid(hdr);
+    case message_type::shared_memory:
+      return shared_memory_valid(hdr);
   }
 }
 
@@ -48,12 +48,29 @@ struct header {
   /// Identifies a receiver by name rather than ID.
   static const uint8_t named_receiver_flag = 0x01;
 
+  /// Prefixes the payload of a message with a `trace_context`.
+  static const uint8_t trace_context_flag = 0x02;
+
   /// Identifies the config server.
   static const uint64_t config_server_id = 1;
 
   /// Identifies the spawn server.
   static const uint64_t spawn_server_id = 2;
 
+  /// Offers a shared memory segment to the receiver.
+  static const uint64_t shared_memory_offer = 0;
+
+  /// Accepts an offered segment, i.e., the sender has mapped the segment and
+  /// switches to it for all further data.
+  static const uint64_t shared_memory_accept = 1;
+
+  /// Declines an offered shared memory segment.
+  static const uint64_t shared_memory_reject = 2;
+
+  /// Confirms an accepted segment, i.e., the sender switches to the shared
+  /// memory segment as well.
+  static const uint64_t shared_memory_confirm = 3;
+
   /// Queries whether this header has the given flag.
   bool has(uint8_t flag) const {
     return (flags & flag) != 0;
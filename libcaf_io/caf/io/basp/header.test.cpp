@@ -77,6 +77,32 @@ TEST("down messages may only have a payload and a source") {
   check(!valid(bad3));
 }
 
+TEST("only shared memory offers may have a payload") {
+  header offer{message_type::shared_memory, 0, 32, header::shared_memory_offer,
+               0, 0};
+  check(valid(offer));
+  header accept{message_type::shared_memory, 0, 0, header::shared_memory_accept,
+                0, 0};
+  check(valid(accept));
+  header reject{message_type::shared_memory, 0, 0, header::shared_memory_reject,
+                0, 0};
+  check(valid(reject));
+  header confirm{message_type::shared_memory, 0, 0,
+                 header::shared_memory_confirm, 0, 0};
+  check(valid(confirm));
+  header bad1{message_type::shared_memory, 0, 0, header::shared_memory_offer,
+              0, 0};
+  check(!valid(bad1));
+  header bad2{message_type::shared_memory, 0, 32, header::shared_memory_accept,
+              0, 0};
+  check(!valid(bad2));
+  header bad3{message_type::shared_memory, 0, 0, 42, 0, 0};
+  check(!valid(bad3));
+  header bad4{message_type::shared_memory, 0, 0, header::shared_memory_reject,
+              42, 0};
+  check(!valid(bad4));
+}
+
 TEST("heartbeat messages must be all-zero except for the message type") {
   header good{message_type::heartbeat, 0, 0, 0, 0, 0};
   check(valid(good));
@@ -7,21 +7,55 @@
 #include "caf/io/basp/remote_message_handler.hpp"
 #include "caf/io/basp/version.hpp"
 #include "caf/io/basp/worker.hpp"
+#include "caf/io/scribe.hpp"
 
 #include "caf/actor_system_config.hpp"
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/defaults.hpp"
 #include "caf/detail/assert.hpp"
+#include "caf/ipv4_address.hpp"
+#include "caf/ipv6_address.hpp"
 #include "caf/log/io.hpp"
 #include "caf/settings.hpp"
 #include "caf/telemetry/histogram.hpp"
 #include "caf/telemetry/timer.hpp"
+#include "caf/trace_context.hpp"
 
 #include <algorithm>
+#include <cctype>
+#include <string_view>
 
 namespace caf::io::basp {
 
+namespace {
+
+// Checks whether `addr` is a loopback address.
+bool is_loopback(const std::string& addr) {
+  if (ipv4_address v4; !parse(addr, v4))
+    return v4.is_loopback();
+  if (ipv6_address v6; !parse(addr, v6))
+    return v6.is_loopback();
+  return false;
+}
+
+// Checks whether `name` follows the pattern "/caf-<pid>-<counter>-<random>"
+// of segments that the process `pid` creates.
+bool is_segment_name_of(std::string_view name, uint32_t pid) {
+  auto prefix = "/caf-" + std::to_string(pid) + '-';
+  if (name.compare(0, prefix.size(), prefix) != 0)
+    return false;
+  name.remove_prefix(prefix.size());
+  auto sep = name.find('-');
+  if (sep == 0 || sep == std::string_view::npos || sep + 1 == name.size())
+    return false;
+  auto is_digit = [](char c) { return isdigit(c) != 0; };
+  return std::all_of(name.begin(), name.begin() + sep, is_digit)
+         && std::all_of(name.begin() + sep + 1, name.end(), is_digit);
+}
+
+} // namespace
+
 instance::callee::callee(actor_system& sys, proxy_registry::backend& backend)
   : namespace_(sys, backend) {
   // nop
@@ -170,6 +204,15 @@ bool instance::dispatch(scheduler* ctx, const strong_actor_ptr& sender,
   if (!path)
     return false;
   auto& source_node = sender ? sender->node() : this_node_;
+  trace_context trace;
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+  trace = trace_context::current();
+  if (trace)
+    flags |= header::trace_context_flag;
+#endif
+  auto write_trace = [&](binary_serializer& sink) {
+    return (flags & header::trace_context_flag) == 0 || sink.apply(trace);
+  };
   if (dest_node == path->next_hop && source_node == this_node_) {
     header hdr{message_type::direct_message,
                flags,
@@ -178,7 +221,7 @@ bool instance::dispatch(scheduler* ctx, const strong_actor_ptr& sender,
                sender ? sender->id() : invalid_actor_id,
                dest_actor};
     auto writer = make_callback([&](binary_serializer& sink) { //
-      return sink.apply(msg);
+      return write_trace(sink) && sink.apply(msg);
     });
     write(*sys_, ctx, callee_.get_buffer(path->hdl), hdr, &writer);
   } else {
@@ -192,8 +235,9 @@ bool instance::dispatch(scheduler* ctx, const strong_actor_ptr& sender,
       log::io::debug(
         "send routed message: source_node = {} dest_node = {} msg = {}",
         source_node, dest_node, msg);
-      return sink.apply(source_node)  //
-             && sink.apply(dest_node) //
+      return write_trace(sink)         //
+             && sink.apply(source_node) //
+             && sink.apply(dest_node)   //
              && sink.apply(msg);
     });
     write(*sys_, ctx, callee_.get_buffer(path->hdl), hdr, &writer);
@@ -311,6 +355,21 @@ void instance::write_heartbeat(scheduler* ctx, byte_buffer& buf) {
   write(*sys_, ctx, buf, hdr);
 }
 
+void instance::write_shared_memory(scheduler* ctx, byte_buffer& buf,
+                                   uint64_t op, const std::string* name) {
+  auto lg = log::io::trace("op = {}", op);
+  header hdr{message_type::shared_memory, 0, 0, op, invalid_actor_id,
+             invalid_actor_id};
+  if (name != nullptr) {
+    auto writer = make_callback([&](binary_serializer& sink) { //
+      return sink.apply(*name);
+    });
+    write(*sys_, ctx, buf, hdr, &writer);
+  } else {
+    write(*sys_, ctx, buf, hdr);
+  }
+}
+
 connection_state instance::handle(scheduler* ctx, connection_handle hdl,
                                   header& hdr, byte_buffer* payload) {
   auto lg = log::io::trace("hdl = {}, hdr = {}", hdl, hdr);
@@ -384,6 +443,8 @@ connection_state instance::handle(scheduler* ctx, connection_handle hdl,
       }
       callee_.learned_new_node_directly(source_node, was_indirect);
       callee_.finalize_handshake(source_node, aid, sigs);
+      if (hdr.operation_data >= shared_memory_version)
+        offer_shared_memory(ctx, hdl, source_node);
       break;
     }
     case message_type::client_handshake: {
@@ -516,6 +577,9 @@ connection_state instance::handle(scheduler* ctx, connection_handle hdl,
       callee_.handle_heartbeat();
       break;
     }
+    case message_type::shared_memory: {
+      return handle_shared_memory(ctx, hdl, hdr, payload);
+    }
     default: {
       log::io::error("invalid operation");
       return malformed_message;
@@ -524,6 +588,102 @@ connection_state instance::handle(scheduler* ctx, connection_handle hdl,
   return await_header;
 }
 
+bool instance::shared_memory_enabled(const node_id& peer) {
+  if (!get_or(config(), "caf.middleman.enable-shared-memory",
+              defaults::middleman::enable_shared_memory))
+    return false;
+  // Host IDs are random, so we can't tell from the node ID whether the peer
+  // runs on the same machine. The callers check for a loopback connection.
+  return peer && std::holds_alternative<hashed_node_id>(peer->content);
+}
+
+void instance::offer_shared_memory(scheduler* ctx, connection_handle hdl,
+                                   const node_id& peer) {
+  auto lg = log::io::trace("hdl = {}, peer = {}", hdl, peer);
+  auto ptr = callee_.get_scribe(hdl);
+  if (ptr == nullptr || !shared_memory_enabled(peer)
+      || !is_loopback(ptr->addr()))
+    return;
+  auto ring_size = get_or(config(), "caf.middleman.shared-memory-ring-size",
+                          defaults::middleman::shared_memory_ring_size);
+  auto name = ptr->create_shared_memory(ring_size);
+  if (!name) {
+    log::io::debug("unable to create a shared memory segment: {}",
+                   name.error());
+    return;
+  }
+  write_shared_memory(ctx, callee_.get_buffer(hdl), header::shared_memory_offer,
+                      &*name);
+  callee_.flush(hdl);
+}
+
+connection_state instance::handle_shared_memory(scheduler* ctx,
+                                                connection_handle hdl,
+                                                const header& hdr,
+                                                byte_buffer* payload) {
+  auto lg = log::io::trace("hdl = {}, hdr = {}", hdl, hdr);
+  auto ptr = callee_.get_scribe(hdl);
+  if (ptr == nullptr)
+    return await_header;
+  switch (hdr.operation_data) {
+    case header::shared_memory_offer: {
+      // Server side: try to map the segment of the client.
+      binary_deserializer source{*sys_, *payload};
+      std::string name;
+      if (!source.apply(name)) {
+        log::io::warning("unable to deserialize shared memory offer: {}",
+                         source.get_error());
+        return serializing_basp_payload_failed;
+      }
+      // Only map segments that the peer created itself and only if it
+      // connected via the loopback interface.
+      auto reply = header::shared_memory_reject;
+      auto peer = tbl_.lookup_direct(hdl);
+      auto peer_id = peer ? std::get_if<hashed_node_id>(&peer->content)
+                          : nullptr;
+      if (!shared_memory_enabled(peer) || !is_loopback(ptr->addr())) {
+        log::io::debug("reject shared memory for a remote peer: hdl = {}",
+                       hdl);
+      } else if (peer_id == nullptr
+                 || !is_segment_name_of(name, peer_id->process_id)) {
+        log::io::warning("reject shared memory segment with invalid name: {}",
+                         name);
+      } else {
+        if (auto err = ptr->open_shared_memory(name))
+          log::io::debug("unable to open shared memory segment: {}", err);
+        else
+          reply = header::shared_memory_accept;
+      }
+      write_shared_memory(ctx, callee_.get_buffer(hdl), reply);
+      callee_.flush(hdl);
+      // Everything after the reply goes through the segment.
+      if (reply == header::shared_memory_accept)
+        ptr->switch_output_to_shared_memory();
+      break;
+    }
+    case header::shared_memory_accept:
+      // Client side: the server has mapped the segment and all of its data
+      // after this message arrives through the segment.
+      log::io::debug("switch to shared memory: hdl = {}", hdl);
+      ptr->unlink_shared_memory();
+      write_shared_memory(ctx, callee_.get_buffer(hdl),
+                          header::shared_memory_confirm);
+      callee_.flush(hdl);
+      ptr->switch_output_to_shared_memory();
+      ptr->switch_input_to_shared_memory();
+      break;
+    case header::shared_memory_reject:
+      log::io::debug("server rejected shared memory: hdl = {}", hdl);
+      ptr->close_shared_memory();
+      break;
+    case header::shared_memory_confirm:
+      log::io::debug("switch to shared memory: hdl = {}", hdl);
+      ptr->switch_input_to_shared_memory();
+      break;
+  }
+  return await_header;
+}
+
 void instance::forward(scheduler*, const node_id& dest_node, const header& hdr,
                        byte_buffer& payload) {
   auto lg = log::io::trace("dest_node = {}, hdr = {}, payload = {}", dest_node,
@@ -88,6 +88,9 @@ public:
     /// Returns a handle to the callee actor.
     virtual strong_actor_ptr this_actor() = 0;
 
+    /// Returns the scribe for `hdl` or `nullptr` if no such scribe exists.
+    virtual scribe* get_scribe(connection_handle hdl) = 0;
+
   protected:
     proxy_registry namespace_;
   };
@@ -188,6 +191,11 @@ public:
   /// Writes a `heartbeat` to `buf`.
   void write_heartbeat(scheduler* ctx, byte_buffer& buf);
 
+  /// Writes a `shared_memory` message with operation data `op` to `buf`. Only
+  /// offers carry the `name` of the segment.
+  void write_shared_memory(scheduler* ctx, byte_buffer& buf, uint64_t op,
+                           const std::string* name = nullptr);
+
   const node_id& this_node() const {
     return this_node_;
   }
@@ -212,6 +220,18 @@ public:
                           byte_buffer* payload);
 
 private:
+  /// Returns whether this node may use shared memory for connecting to `peer`
+  /// if the connection runs over the loopback interface.
+  bool shared_memory_enabled(const node_id& peer);
+
+  /// Offers a new shared memory segment to the server on `hdl`.
+  void offer_shared_memory(scheduler* ctx, connection_handle hdl,
+                           const node_id& peer);
+
+  connection_state handle_shared_memory(scheduler* ctx, connection_handle hdl,
+                                        const header& hdr,
+                                        byte_buffer* payload);
+
   void forward(scheduler* ctx, const node_id& dest_node, const header& hdr,
                byte_buffer& payload);
 
@@ -0,0 +1,104 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/io/basp/instance.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/io/middleman.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/raise_error.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/trace_context.hpp"
+
+#include <chrono>
+#include <memory>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+
+// Bundles an actor system with its configuration.
+struct node {
+  node() {
+    cfg.load<io::middleman>();
+    sys = std::make_unique<actor_system>(cfg);
+  }
+
+  actor_system_config cfg;
+  std::unique_ptr<actor_system> sys;
+};
+
+// Responds with the trace context of the current message.
+behavior trace_reporter() {
+  return {
+    [](get_atom) {
+      auto ctx = trace_context::current();
+      return make_message(ctx.trace_id, ctx.span_id);
+    },
+  };
+}
+
+struct fixture {
+  fixture() {
+    auto port = server.sys->middleman().publish(
+      server.sys->spawn(trace_reporter), 0, "127.0.0.1");
+    if (!port)
+      CAF_RAISE_ERROR("failed to publish the trace reporter");
+    auto hdl = client.sys->middleman().remote_actor("127.0.0.1", *port);
+    if (!hdl)
+      CAF_RAISE_ERROR("failed to connect to the trace reporter");
+    reporter = std::move(*hdl);
+  }
+
+  ~fixture() {
+    anon_send_exit(reporter, exit_reason::user_shutdown);
+  }
+
+  // Asks the remote actor for the trace context of its current message.
+  trace_context remote_context() {
+    trace_context result;
+    scoped_actor self{*client.sys};
+    self->mail(get_atom_v)
+      .request(reporter, 10s)
+      .receive(
+        [&result](uint64_t trace_id, uint64_t span_id) {
+          result = trace_context{trace_id, span_id};
+        },
+        [](const error& err) {
+          test::runnable::current().fail("error: {}", err);
+        });
+    return result;
+  }
+
+  node server;
+  node client;
+  actor reporter;
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("BASP transmits the trace context along with the message") {
+  SECTION("traced messages keep their context on the remote node") {
+    auto ctx = trace_context{42, 7};
+    trace_context::guard guard{ctx};
+    check_eq(remote_context(), ctx);
+  }
+  SECTION("untraced messages arrive without context") {
+    check_eq(remote_context(), trace_context{});
+  }
+}
+
+} // WITH_FIXTURE(fixture)
+
+#endif // CAF_ENABLE_ACTOR_PROFILER
+
+} // namespace
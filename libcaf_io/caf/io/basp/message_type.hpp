@@ -60,6 +60,12 @@ enum class message_type : uint8_t {
   ///
   /// ![](heartbeat.png)
   heartbeat = 0x06,
+
+  /// Negotiates moving the traffic of a direct connection between two nodes
+  /// on the same host to a shared memory segment. The client offers a segment
+  /// by sending its name, the server either accepts or rejects the offer and
+  /// the client confirms an acceptance.
+  shared_memory = 0x07,
 };
 
 CAF_IO_EXPORT std::string to_string(message_type);
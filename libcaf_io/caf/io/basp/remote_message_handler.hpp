@@ -24,6 +24,7 @@
 #include "caf/scheduler.hpp"
 #include "caf/telemetry/histogram.hpp"
 #include "caf/telemetry/timer.hpp"
+#include "caf/trace_context.hpp"
 
 #include <cstdint>
 #include <vector>
@@ -63,6 +64,13 @@ public:
       log::io::info("drop asynchronous remote message: unknown destination");
       return;
     }
+    // Read the trace context. We skip it when building without the profiler.
+    [[maybe_unused]] trace_context trace;
+    if (dref.hdr_.has(basp::header::trace_context_flag)
+        && !source.apply(trace)) {
+      log::io::error("failed to read trace context: {}", source.get_error());
+      return;
+    }
     // Deserialize source and destination node for routed messages.
     if (dref.hdr_.operation == basp::message_type::routed_message) {
       node_id src_node;
@@ -130,9 +138,11 @@ public:
     }
     // Ship the message.
     guard.disable();
-    dref.queue_->push(ctx, dref.msg_id_, std::move(dst),
-                      make_mailbox_element(std::move(src), mid,
-                                           std::move(msg)));
+    auto element = make_mailbox_element(std::move(src), mid, std::move(msg));
+#ifdef CAF_ENABLE_ACTOR_PROFILER
+    element->trace = trace;
+#endif
+    dref.queue_->push(ctx, dref.msg_id_, std::move(dst), std::move(element));
   }
 };
 
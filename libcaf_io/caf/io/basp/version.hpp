@@ -12,7 +12,11 @@ namespace caf::io::basp {
 /// @{
 
 /// The current BASP version. Note: BASP is not backwards compatible.
-constexpr uint64_t version = 8;
+constexpr uint64_t version = 9;
+
+/// The first BASP version that supports shared memory segments for
+/// connections between nodes on the same host.
+constexpr uint64_t shared_memory_version = 9;
 
 /// @}
 
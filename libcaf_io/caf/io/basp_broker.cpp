@@ -725,4 +725,8 @@ strong_actor_ptr basp_broker::this_actor() {
   return ctrl();
 }
 
+scribe* basp_broker::get_scribe(connection_handle hdl) {
+  return by_id(hdl).get();
+}
+
 } // namespace caf::io
@@ -89,6 +89,8 @@ public:
 
   strong_actor_ptr this_actor() override;
 
+  scribe* get_scribe(connection_handle hdl) override;
+
   // -- utility functions ------------------------------------------------------
 
   /// Sends `node_down_msg` to all registered observers.
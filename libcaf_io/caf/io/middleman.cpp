@@ -66,6 +66,16 @@ auto make_metrics(telemetry::metric_registry& reg) {
     500'000,
     1'000'000,
   }};
+  std::array<int64_t, 8> default_count_buckets{{
+    1,
+    2,
+    4,
+    8,
+    16,
+    32,
+    64,
+    128,
+  }};
   return middleman::metric_singletons_t{
     reg.histogram_singleton(
       "caf.middleman", "inbound-messages-size", default_size_buckets,
@@ -79,6 +89,12 @@ auto make_metrics(telemetry::metric_registry& reg) {
     reg.histogram_singleton<double>(
       "caf.middleman", "serialization-time", default_time_buckets,
       "Time the middleman needs to serialize outbound messages.", "seconds"),
+    reg.histogram_singleton(
+      "caf.middleman", "coalesced-messages", default_count_buckets,
+      "Number of messages the middleman writes to a socket at once."),
+    reg.histogram_singleton(
+      "caf.middleman", "write-size", default_size_buckets,
+      "Number of bytes the middleman writes per system call.", "bytes"),
   };
 }
 
@@ -193,7 +209,11 @@ void middleman::add_module_options(actor_system_config& cfg) {
                    "(disabled if 0, ignored if heartbeats are disabled)")
     .add<bool>("attach-utility-actors",
                "schedule utility actors instead of dedicating threads")
-    .add<size_t>("workers", "number of deserialization workers");
+    .add<size_t>("workers", "number of deserialization workers")
+    .add<bool>("enable-shared-memory",
+               "use shared memory for connections on the loopback interface")
+    .add<size_t>("shared-memory-ring-size",
+                 "size of each ring buffer in shared memory segments");
   config_option_adder{cfg.custom_options(), "caf.middleman.prometheus-http"}
     .add<uint16_t>("port", "listening port for incoming scrapes")
     .add<std::string>("address", "bind address for the HTTP server socket");
@@ -209,6 +229,10 @@ void middleman::add_module_options(actor_system_config& cfg) {
               defaults::middleman::heartbeat_interval);
   put_missing(grp, "connection-timeout",
               defaults::middleman::connection_timeout);
+  put_missing(grp, "enable-shared-memory",
+              defaults::middleman::enable_shared_memory);
+  put_missing(grp, "shared-memory-ring-size",
+              defaults::middleman::shared_memory_ring_size);
 }
 
 actor_system_module* middleman::make(actor_system& sys) {
@@ -49,6 +49,12 @@ public:
 
     /// Samples how long the middleman needs to serialize outbound messages.
     telemetry::dbl_histogram* serialization_time = nullptr;
+
+    /// Samples how many messages the middleman coalesces into a single write.
+    telemetry::int_histogram* coalesced_messages = nullptr;
+
+    /// Samples how many bytes the middleman writes per system call.
+    telemetry::int_histogram* write_size = nullptr;
   };
 
   /// Independent tasks that run in the background, usually in their own thread.
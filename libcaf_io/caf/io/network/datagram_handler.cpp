@@ -18,6 +18,13 @@ namespace {
 
 constexpr size_t receive_buffer_size = std::numeric_limits<uint16_t>::max();
 
+size_t udp_batch_size(caf::io::network::default_multiplexer& backend) {
+  auto result = caf::get_or(backend.system().config(),
+                            "caf.middleman.cached-udp-buffers",
+                            caf::defaults::middleman::cached_udp_buffers);
+  return std::max(result, size_t{1});
+}
+
 } // namespace
 
 namespace caf::io::network {
@@ -28,9 +35,15 @@ datagram_handler::datagram_handler(default_multiplexer& backend_ref,
     max_consecutive_reads_(get_or(backend().system().config(),
                                   "caf.middleman.max-consecutive-reads",
                                   defaults::middleman::max_consecutive_reads)),
+    batch_size_(udp_batch_size(backend_ref)),
     max_datagram_size_(receive_buffer_size),
     rd_buf_(receive_buffer_size),
+    rd_sizes_(batch_size_),
+    rd_senders_(batch_size_),
     send_buffer_size_(0) {
+  rd_bufs_.reserve(batch_size_);
+  for (size_t i = 0; i < batch_size_; ++i)
+    rd_bufs_.emplace_back(max_datagram_size_);
   allow_udp_connreset(sockfd, false);
   auto es = send_buffer_size(sockfd);
   if (!es)
@@ -69,7 +82,6 @@ void datagram_handler::flush(const manager_ptr& mgr) {
     backend().add(operation::write, fd(), this);
     writer_ = mgr;
     state_.writing = true;
-    prepare_next_write();
   }
 }
 
@@ -140,24 +152,50 @@ void datagram_handler::graceful_shutdown() {
 }
 
 void datagram_handler::prepare_next_read() {
-  auto lg
-    = log::io::trace("wr_buf_.second.size = {}, wr_offline_buf_.size = {}",
-                     wr_buf_.second.size(), wr_offline_buf_.size());
+  auto lg = log::io::trace("wr_offline_buf_.size = {}", wr_offline_buf_.size());
   rd_buf_.resize(max_datagram_size_);
 }
 
-void datagram_handler::prepare_next_write() {
+void datagram_handler::prepare_write_batch() {
   auto lg = log::io::trace("wr_offline_buf_.size = {}", wr_offline_buf_.size());
-  wr_buf_.second.clear();
-  if (wr_offline_buf_.empty()) {
-    state_.writing = false;
-    backend().del(operation::write, fd(), this);
-  } else {
-    wr_buf_.swap(wr_offline_buf_.front());
+  // Fill up the batch with pending datagrams. The batch may still contain
+  // datagrams from a previous write operation that sent only a prefix.
+  while (wr_batch_bufs_.size() < batch_size_ && !wr_offline_buf_.empty()) {
+    auto& [hdl, buf] = wr_offline_buf_.front();
+    auto itr = ep_by_hdl_.find(hdl);
+    // maybe this could be an assert?
+    if (itr == ep_by_hdl_.end())
+      CAF_RAISE_ERROR("got write event for undefined endpoint");
+    auto size_as_int = static_cast<int>(buf.size());
+    if (size_as_int > send_buffer_size_) {
+      send_buffer_size_ = size_as_int;
+      send_buffer_size(fd(), size_as_int);
+    }
+    wr_batch_hdls_.push_back(hdl);
+    wr_batch_bufs_.push_back(std::move(buf));
+    wr_batch_eps_.push_back(itr->second);
     wr_offline_buf_.pop_front();
   }
 }
 
+bool datagram_handler::handle_read_results(bool read_result,
+                                           size_t num_datagrams) {
+  if (!read_result)
+    return handle_read_result(false);
+  for (size_t i = 0; i < num_datagrams; ++i) {
+    // Swap the datagram into the read buffer, because servants access the
+    // data and the sender via `rd_buf()` and `sending_endpoint()`.
+    rd_buf_.swap(rd_bufs_[i]);
+    num_bytes_ = rd_sizes_[i];
+    sender_ = rd_senders_[i];
+    auto ok = handle_read_result(true);
+    rd_buf_.swap(rd_bufs_[i]);
+    if (!ok)
+      return false;
+  }
+  return true;
+}
+
 bool datagram_handler::handle_read_result(bool read_result) {
   if (!read_result) {
     reader_->io_failure(&backend(), operation::read);
@@ -181,20 +219,30 @@ bool datagram_handler::handle_read_result(bool read_result) {
   return true;
 }
 
-void datagram_handler::handle_write_result(bool write_result,
-                                           datagram_handle id, byte_buffer& buf,
-                                           size_t wb) {
+void datagram_handler::handle_write_results(bool write_result,
+                                            size_t num_sent) {
   if (!write_result) {
     writer_->io_failure(&backend(), operation::write);
     backend().del(operation::write, fd(), this);
-  } else if (wb > 0) {
-    CAF_ASSERT(wb == buf.size());
-    if (state_.ack_writes)
-      writer_->datagram_sent(&backend(), id, wb, std::move(buf));
-    prepare_next_write();
-  } else {
-    if (writer_)
-      writer_->io_failure(&backend(), operation::write);
+    return;
+  }
+  CAF_ASSERT(num_sent <= wr_batch_bufs_.size());
+  if (state_.ack_writes && writer_) {
+    for (size_t i = 0; i < num_sent; ++i) {
+      auto num_bytes = wr_batch_bufs_[i].size();
+      writer_->datagram_sent(&backend(), wr_batch_hdls_[i], num_bytes,
+                             std::move(wr_batch_bufs_[i]));
+    }
+  }
+  auto n = static_cast<ptrdiff_t>(num_sent);
+  wr_batch_hdls_.erase(wr_batch_hdls_.begin(), wr_batch_hdls_.begin() + n);
+  wr_batch_bufs_.erase(wr_batch_bufs_.begin(), wr_batch_bufs_.begin() + n);
+  wr_batch_eps_.erase(wr_batch_eps_.begin(), wr_batch_eps_.begin() + n);
+  // Stop writing once we have sent everything. Otherwise, we try again on the
+  // next write event.
+  if (wr_batch_bufs_.empty() && wr_offline_buf_.empty()) {
+    state_.writing = false;
+    backend().del(operation::write, fd(), this);
   }
 }
 
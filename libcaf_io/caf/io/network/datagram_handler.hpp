@@ -16,6 +16,7 @@
 #include "caf/log/io.hpp"
 #include "caf/raise_error.hpp"
 #include "caf/ref_counted.hpp"
+#include "caf/span.hpp"
 
 #include <unordered_map>
 #include <vector>
@@ -101,32 +102,29 @@ protected:
     switch (op) {
       case io::network::operation::read: {
         // Loop until an error occurs or we have nothing more to read
-        // or until we have handled `mcr` reads.
-        for (size_t i = 0; i < mcr; ++i) {
-          auto res = policy.read_datagram(num_bytes_, fd(), rd_buf_.data(),
-                                          rd_buf_.size(), sender_);
-          if (!handle_read_result(res))
+        // or until we have handled `mcr` datagrams.
+        for (size_t i = 0; i < mcr;) {
+          size_t num_datagrams = 0;
+          auto res = policy.read_datagrams(num_datagrams, fd(),
+                                           make_span(rd_bufs_),
+                                           make_span(rd_sizes_),
+                                           make_span(rd_senders_));
+          if (!handle_read_results(res, num_datagrams))
             return;
+          // Stop if the socket has no more data.
+          if (num_datagrams < rd_bufs_.size())
+            break;
+          i += num_datagrams;
         }
         break;
       }
       case io::network::operation::write: {
-        size_t wb; // written bytes
-        auto itr = ep_by_hdl_.find(wr_buf_.first);
-        // maybe this could be an assert?
-        if (itr == ep_by_hdl_.end())
-          CAF_RAISE_ERROR("got write event for undefined endpoint");
-        auto& id = itr->first;
-        auto& ep = itr->second;
-        byte_buffer buf;
-        std::swap(buf, wr_buf_.second);
-        auto size_as_int = static_cast<int>(buf.size());
-        if (size_as_int > send_buffer_size_) {
-          send_buffer_size_ = size_as_int;
-          send_buffer_size(fd(), size_as_int);
-        }
-        auto res = policy.write_datagram(wb, fd(), buf.data(), buf.size(), ep);
-        handle_write_result(res, id, buf, wb);
+        prepare_write_batch();
+        size_t num_sent = 0;
+        auto res = policy.write_datagrams(num_sent, fd(),
+                                          make_span(wr_batch_bufs_),
+                                          make_span(wr_batch_eps_));
+        handle_write_results(res, num_sent);
         break;
       }
       case operation::propagate_error:
@@ -140,12 +138,13 @@ private:
 
   void prepare_next_read();
 
-  void prepare_next_write();
+  void prepare_write_batch();
 
   bool handle_read_result(bool read_result);
 
-  void handle_write_result(bool write_result, datagram_handle id,
-                           byte_buffer& buf, size_t wb);
+  bool handle_read_results(bool read_result, size_t num_datagrams);
+
+  void handle_write_results(bool write_result, size_t num_sent);
 
   void handle_error();
 
@@ -153,6 +152,9 @@ private:
   std::unordered_map<ip_endpoint, datagram_handle> hdl_by_ep_;
   std::unordered_map<datagram_handle, ip_endpoint> ep_by_hdl_;
 
+  // maximum number of datagrams per system call
+  const size_t batch_size_;
+
   // state for reading
   const size_t max_datagram_size_;
   size_t num_bytes_;
@@ -160,11 +162,21 @@ private:
   manager_ptr reader_;
   ip_endpoint sender_;
 
+  // pre-allocated buffers for receiving multiple datagrams at once
+  std::vector<read_buffer_type> rd_bufs_;
+  std::vector<size_t> rd_sizes_;
+  std::vector<ip_endpoint> rd_senders_;
+
   // state for writing
   int send_buffer_size_;
   std::deque<job_type> wr_offline_buf_;
-  job_type wr_buf_;
   manager_ptr writer_;
+
+  // datagrams for the next system call, including leftovers from partial
+  // writes
+  std::vector<datagram_handle> wr_batch_hdls_;
+  std::vector<byte_buffer> wr_batch_bufs_;
+  std::vector<ip_endpoint> wr_batch_eps_;
 };
 
 } // namespace caf::io::network
@@ -51,6 +51,34 @@ void scribe_impl::flush() {
   stream_.flush(this);
 }
 
+expected<std::string> scribe_impl::create_shared_memory(size_t ring_size) {
+  auto lg = log::io::trace("ring_size = {}", ring_size);
+  return stream_.policy().create(ring_size);
+}
+
+error scribe_impl::open_shared_memory(const std::string& name) {
+  auto lg = log::io::trace("name = {}", name);
+  return stream_.policy().open(name);
+}
+
+void scribe_impl::unlink_shared_memory() {
+  stream_.policy().unlink();
+}
+
+void scribe_impl::close_shared_memory() {
+  stream_.policy().close();
+}
+
+void scribe_impl::switch_output_to_shared_memory() {
+  auto lg = log::io::trace("");
+  stream_.policy().switch_output(stream_.pending_output());
+}
+
+void scribe_impl::switch_input_to_shared_memory() {
+  auto lg = log::io::trace("");
+  stream_.policy().switch_input();
+}
+
 std::string scribe_impl::addr() const {
   auto x = remote_addr_of_fd(stream_.fd());
   if (!x)
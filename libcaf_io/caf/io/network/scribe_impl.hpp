@@ -10,7 +10,7 @@
 #include "caf/io/scribe.hpp"
 
 #include "caf/detail/io_export.hpp"
-#include "caf/policy/tcp.hpp"
+#include "caf/policy/shared_memory.hpp"
 
 namespace caf::io::network {
 
@@ -31,6 +31,18 @@ public:
 
   void flush() override;
 
+  expected<std::string> create_shared_memory(size_t ring_size) override;
+
+  error open_shared_memory(const std::string& name) override;
+
+  void unlink_shared_memory() override;
+
+  void close_shared_memory() override;
+
+  void switch_output_to_shared_memory() override;
+
+  void switch_input_to_shared_memory() override;
+
   std::string addr() const override;
 
   uint16_t port() const override;
@@ -43,7 +55,7 @@ public:
 
 protected:
   bool launched_;
-  stream_impl<policy::tcp> stream_;
+  stream_impl<policy::shared_memory> stream_;
 };
 
 } // namespace caf::io::network
@@ -0,0 +1,256 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/io/network/shm_segment.hpp"
+
+#include "caf/config.hpp"
+#include "caf/format_to_error.hpp"
+#include "caf/log/io.hpp"
+#include "caf/sec.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <random>
+
+#ifndef CAF_WINDOWS
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace caf::io::network {
+
+struct shm_segment::ring {
+  /// Number of bytes the producer has written so far.
+  alignas(64) std::atomic<uint64_t> head;
+
+  /// Number of bytes the consumer has read so far.
+  alignas(64) std::atomic<uint64_t> tail;
+
+  /// Set by the consumer while waiting for data.
+  alignas(64) std::atomic<uint32_t> reader_waiting;
+
+  /// Set by the producer while waiting for space.
+  std::atomic<uint32_t> writer_waiting;
+
+  std::byte* data() noexcept {
+    return reinterpret_cast<std::byte*>(this + 1);
+  }
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared memory rings require lock-free 64-bit atomics");
+
+namespace {
+
+constexpr size_t min_ring_size = 4096;
+
+size_t normalize(size_t ring_size) {
+  auto result = min_ring_size;
+  while (result < ring_size)
+    result <<= 1;
+  return result;
+}
+
+size_t mapped_size(size_t ring_size) {
+  return 2 * (sizeof(shm_segment::ring) + ring_size);
+}
+
+} // namespace
+
+shm_segment::shm_segment(std::string name, void* addr, size_t ring_size,
+                         bool owner)
+  : name_(std::move(name)), addr_(addr), ring_size_(ring_size), owner_(owner) {
+  auto first = reinterpret_cast<ring*>(addr);
+  auto second = reinterpret_cast<ring*>(first->data() + ring_size);
+  if (owner) {
+    new (first) ring{};
+    new (second) ring{};
+    output_ = first;
+    input_ = second;
+  } else {
+    input_ = first;
+    output_ = second;
+  }
+}
+
+shm_segment::~shm_segment() {
+#ifndef CAF_WINDOWS
+  unlink();
+  munmap(addr_, mapped_size(ring_size_));
+#endif
+}
+
+expected<shm_segment_ptr> shm_segment::create(size_t ring_size) {
+#ifdef CAF_WINDOWS
+  return make_error(sec::unsupported_operation,
+                    "shared memory segments require a POSIX system");
+#else
+  static std::atomic<uint32_t> counter;
+  ring_size = normalize(ring_size);
+  auto size = mapped_size(ring_size);
+  std::random_device rd;
+  auto name = "/caf-" + std::to_string(getpid()) + '-'
+              + std::to_string(counter.fetch_add(1)) + '-'
+              + std::to_string(rd());
+  auto fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0)
+    return format_to_error(sec::network_syscall_failed, "shm_open: {}",
+                           strerror(errno));
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    auto err = format_to_error(sec::network_syscall_failed, "ftruncate: {}",
+                               strerror(errno));
+    close(fd);
+    shm_unlink(name.c_str());
+    return err;
+  }
+  auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    auto err = format_to_error(sec::network_syscall_failed, "mmap: {}",
+                               strerror(errno));
+    shm_unlink(name.c_str());
+    return err;
+  }
+  log::io::debug("created shared memory segment {}", name);
+  return shm_segment_ptr{
+    new shm_segment(std::move(name), addr, ring_size, true)};
+#endif
+}
+
+expected<shm_segment_ptr> shm_segment::open(const std::string& name) {
+#ifdef CAF_WINDOWS
+  return make_error(sec::unsupported_operation,
+                    "shared memory segments require a POSIX system");
+#else
+  auto fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0)
+    return format_to_error(sec::network_syscall_failed, "shm_open: {}",
+                           strerror(errno));
+  // Restore the ring size from the size of the segment.
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    auto err = format_to_error(sec::network_syscall_failed, "fstat: {}",
+                               strerror(errno));
+    close(fd);
+    return err;
+  }
+  auto size = static_cast<size_t>(st.st_size);
+  auto ring_size = size / 2 - sizeof(ring);
+  if (size < mapped_size(min_ring_size) || ring_size != normalize(ring_size)
+      || size != mapped_size(ring_size)) {
+    close(fd);
+    return make_error(sec::invalid_argument,
+                      "shared memory segment has an invalid size");
+  }
+  auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+    return format_to_error(sec::network_syscall_failed, "mmap: {}",
+                           strerror(errno));
+  log::io::debug("opened shared memory segment {}", name);
+  return shm_segment_ptr{new shm_segment(name, addr, ring_size, false)};
+#endif
+}
+
+bool shm_segment::input_empty() const noexcept {
+  return input_->head.load(std::memory_order_acquire)
+         == input_->tail.load(std::memory_order_relaxed);
+}
+
+void shm_segment::unlink() noexcept {
+#ifndef CAF_WINDOWS
+  if (owner_) {
+    owner_ = false;
+    shm_unlink(name_.c_str());
+  }
+#endif
+}
+
+ptrdiff_t shm_segment::write(const void* buf, size_t len) noexcept {
+  auto& out = *output_;
+  auto head = out.head.load(std::memory_order_relaxed);
+  auto tail = out.tail.load(std::memory_order_acquire);
+  // The other process has write access to the ring as well. Hence, we must
+  // not trust the control block before checking it.
+  auto used = head - tail;
+  if (used > ring_size_) {
+    log::io::error("corrupted shared memory ring: head = {}, tail = {}", head,
+                   tail);
+    return -1;
+  }
+  auto n = std::min(len, ring_size_ - static_cast<size_t>(used));
+  if (n == 0)
+    return 0;
+  auto offset = static_cast<size_t>(head) & (ring_size_ - 1);
+  auto first = std::min(n, ring_size_ - offset);
+  auto src = reinterpret_cast<const std::byte*>(buf);
+  memcpy(out.data() + offset, src, first);
+  memcpy(out.data(), src + first, n - first);
+  out.head.store(head + n, std::memory_order_release);
+  return static_cast<ptrdiff_t>(n);
+}
+
+ptrdiff_t shm_segment::read(void* buf, size_t len) noexcept {
+  auto& in = *input_;
+  auto tail = in.tail.load(std::memory_order_relaxed);
+  auto head = in.head.load(std::memory_order_acquire);
+  auto used = head - tail;
+  if (used > ring_size_) {
+    log::io::error("corrupted shared memory ring: head = {}, tail = {}", head,
+                   tail);
+    return -1;
+  }
+  auto n = std::min(len, static_cast<size_t>(used));
+  if (n == 0)
+    return 0;
+  auto offset = static_cast<size_t>(tail) & (ring_size_ - 1);
+  auto first = std::min(n, ring_size_ - offset);
+  auto dst = reinterpret_cast<std::byte*>(buf);
+  memcpy(dst, in.data() + offset, first);
+  memcpy(dst + first, in.data(), n - first);
+  in.tail.store(tail + n, std::memory_order_release);
+  return static_cast<ptrdiff_t>(n);
+}
+
+// Note: the suspend and resume functions form a Dekker-style handshake. Each
+//       side first publishes its own state and then checks the state of the
+//       other side, with a full fence in between. This guarantees that at
+//       least one side sees the update of the other one.
+
+bool shm_segment::suspend_reader() noexcept {
+  input_->reader_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return input_empty();
+}
+
+bool shm_segment::suspend_writer() noexcept {
+  auto& out = *output_;
+  out.writer_waiting.store(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto head = out.head.load(std::memory_order_relaxed);
+  auto tail = out.tail.load(std::memory_order_acquire);
+  return static_cast<size_t>(head - tail) == ring_size_;
+}
+
+bool shm_segment::resume_reader() noexcept {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto& flag = output_->reader_waiting;
+  return flag.load(std::memory_order_relaxed) != 0
+         && flag.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+bool shm_segment::resume_writer() noexcept {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto& flag = input_->writer_waiting;
+  return flag.load(std::memory_order_relaxed) != 0
+         && flag.exchange(0, std::memory_order_relaxed) != 0;
+}
+
+} // namespace caf::io::network
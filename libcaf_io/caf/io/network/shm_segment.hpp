@@ -0,0 +1,113 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/detail/io_export.hpp"
+#include "caf/expected.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace caf::io::network {
+
+class shm_segment;
+
+/// @relates shm_segment
+using shm_segment_ptr = std::unique_ptr<shm_segment>;
+
+/// A shared memory segment with two single-producer, single-consumer byte
+/// rings for exchanging data between two processes on the same host. The
+/// process that creates the segment writes to the first ring and reads from
+/// the second one. The process that opens the segment does the opposite.
+///
+/// The rings only transport the data. Each side flags when it runs out of
+/// data to read or space to write and the other side then needs to wake it up
+/// by other means, e.g., by writing a byte to a socket.
+class CAF_IO_EXPORT shm_segment {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Control block of a single ring, followed by its data.
+  struct ring;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  shm_segment(const shm_segment&) = delete;
+
+  shm_segment& operator=(const shm_segment&) = delete;
+
+  ~shm_segment();
+
+  // -- factory functions ------------------------------------------------------
+
+  /// Creates a new segment with two rings of at least `ring_size` bytes. The
+  /// actual size is the next power of two.
+  static expected<shm_segment_ptr> create(size_t ring_size);
+
+  /// Maps the segment `name` that another process created with `create`.
+  static expected<shm_segment_ptr> open(const std::string& name);
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the system-wide name of this segment.
+  const std::string& name() const noexcept {
+    return name_;
+  }
+
+  /// Returns the capacity of each ring.
+  size_t ring_size() const noexcept {
+    return ring_size_;
+  }
+
+  /// Returns whether the input ring has no data.
+  bool input_empty() const noexcept;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Removes the name of this segment from the system. Both processes keep
+  /// their mapping until they destroy their `shm_segment` object.
+  void unlink() noexcept;
+
+  /// Copies up to `len` bytes from `buf` to the output ring.
+  /// @returns the number of copied bytes or -1 if the control block of the
+  ///          ring is inconsistent.
+  ptrdiff_t write(const void* buf, size_t len) noexcept;
+
+  /// Copies up to `len` bytes from the input ring to `buf`.
+  /// @returns the number of copied bytes or -1 if the control block of the
+  ///          ring is inconsistent.
+  ptrdiff_t read(void* buf, size_t len) noexcept;
+
+  /// Flags that this process waits for data on the input ring.
+  /// @returns `true` if the input ring is still empty after setting the flag,
+  ///          `false` otherwise.
+  bool suspend_reader() noexcept;
+
+  /// Flags that this process waits for space on the output ring.
+  /// @returns `true` if the output ring is still full after setting the flag,
+  ///          `false` otherwise.
+  bool suspend_writer() noexcept;
+
+  /// Clears the flag of the other process for waiting on data.
+  /// @returns `true` if the other process needs a wakeup, `false` otherwise.
+  bool resume_reader() noexcept;
+
+  /// Clears the flag of the other process for waiting on space.
+  /// @returns `true` if the other process needs a wakeup, `false` otherwise.
+  bool resume_writer() noexcept;
+
+private:
+  shm_segment(std::string name, void* addr, size_t ring_size, bool owner);
+
+  std::string name_;
+  void* addr_;
+  size_t ring_size_;
+  bool owner_;
+  ring* input_;
+  ring* output_;
+};
+
+} // namespace caf::io::network
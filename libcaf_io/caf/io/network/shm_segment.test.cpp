@@ -0,0 +1,141 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/io/network/shm_segment.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+#ifndef CAF_WINDOWS
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+using caf::io::network::shm_segment;
+
+namespace {
+
+#ifndef CAF_WINDOWS
+
+TEST("segments round up the ring size to the next power of two") {
+  auto uut = shm_segment::create(5000);
+  require(uut.has_value());
+  check_eq((*uut)->ring_size(), 8192u);
+  SECTION("opening a segment restores the ring size") {
+    auto peer = shm_segment::open((*uut)->name());
+    require(peer.has_value());
+    check_eq((*peer)->ring_size(), 8192u);
+  }
+}
+
+TEST("opening a segment fails after unlinking it") {
+  auto uut = shm_segment::create(4096);
+  require(uut.has_value());
+  (*uut)->unlink();
+  check(!shm_segment::open((*uut)->name()));
+}
+
+TEST("each side writes to the input ring of the other side") {
+  auto uut = shm_segment::create(4096);
+  require(uut.has_value());
+  auto peer = shm_segment::open((*uut)->name());
+  require(peer.has_value());
+  auto& x = **uut;
+  auto& y = **peer;
+  check_eq(x.write("ping", 4), 4);
+  check(x.input_empty());
+  check(!y.input_empty());
+  check_eq(y.write("pong!", 5), 5);
+  char buf[8];
+  check_eq(y.read(buf, sizeof(buf)), 4);
+  check_eq(std::string_view(buf, 4), "ping");
+  check(y.input_empty());
+  check_eq(x.read(buf, sizeof(buf)), 5);
+  check_eq(std::string_view(buf, 5), "pong!");
+}
+
+TEST("rings hold up to ring_size bytes and wrap around") {
+  auto uut = shm_segment::create(4096);
+  require(uut.has_value());
+  auto peer = shm_segment::open((*uut)->name());
+  require(peer.has_value());
+  auto& x = **uut;
+  auto& y = **peer;
+  std::vector<uint8_t> data(6000);
+  std::iota(data.begin(), data.end(), uint8_t{0});
+  std::vector<uint8_t> received(6000);
+  check_eq(x.write(data.data(), data.size()), 4096);
+  check_eq(x.write(data.data() + 4096, 1), 0);
+  check_eq(y.read(received.data(), 3000), 3000);
+  check_eq(x.write(data.data() + 4096, 1904), 1904);
+  check_eq(y.read(received.data() + 3000, 6000), 3000);
+  check(y.input_empty());
+  check(received == data);
+}
+
+TEST("suspended sides need a wakeup") {
+  auto uut = shm_segment::create(4096);
+  require(uut.has_value());
+  auto peer = shm_segment::open((*uut)->name());
+  require(peer.has_value());
+  auto& x = **uut;
+  auto& y = **peer;
+  SECTION("readers wait for data") {
+    check(!x.resume_reader());
+    check(y.suspend_reader());
+    check_eq(x.write("abc", 3), 3);
+    check(x.resume_reader());
+    check(!x.resume_reader());
+    check(!y.suspend_reader());
+  }
+  SECTION("writers wait for space") {
+    std::vector<uint8_t> data(4096);
+    check_eq(x.write(data.data(), data.size()), 4096);
+    check(!y.resume_writer());
+    check(x.suspend_writer());
+    check_eq(y.read(data.data(), 1), 1);
+    check(y.resume_writer());
+    check(!y.resume_writer());
+    check(!x.suspend_writer());
+  }
+}
+
+TEST("sides reject rings with an inconsistent control block") {
+  auto uut = shm_segment::create(4096);
+  require(uut.has_value());
+  auto peer = shm_segment::open((*uut)->name());
+  require(peer.has_value());
+  auto& x = **uut;
+  auto& y = **peer;
+  // Simulate a misbehaving process by moving the head of the first ring past
+  // the end of its data. The head is the first field of the control block.
+  auto fd = shm_open(x.name().c_str(), O_RDWR, 0600);
+  require(fd >= 0);
+  auto addr = mmap(nullptr, sizeof(uint64_t), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0);
+  close(fd);
+  require(addr != MAP_FAILED);
+  auto head = static_cast<std::atomic<uint64_t>*>(addr);
+  head->store(2 * x.ring_size());
+  munmap(addr, sizeof(uint64_t));
+  char buf[8];
+  check_eq(y.read(buf, sizeof(buf)), -1);
+  check_eq(x.write("abc", 3), -1);
+  SECTION("the other ring remains usable") {
+    check_eq(y.write("abc", 3), 3);
+    check_eq(x.read(buf, sizeof(buf)), 3);
+  }
+}
+
+#endif // CAF_WINDOWS
+
+} // namespace
@@ -4,6 +4,7 @@
 
 #include "caf/io/network/stream.hpp"
 
+#include "caf/io/middleman.hpp"
 #include "caf/io/network/default_multiplexer.hpp"
 
 #include "caf/actor_system_config.hpp"
@@ -11,6 +12,7 @@
 #include "caf/defaults.hpp"
 #include "caf/detail/assert.hpp"
 #include "caf/log/io.hpp"
+#include "caf/telemetry/histogram.hpp"
 
 #include <algorithm>
 
@@ -24,8 +26,18 @@ stream::stream(default_multiplexer& backend_ref, native_socket sockfd)
     read_threshold_(1),
     collected_(0),
     written_(0),
-    wr_op_backoff_(false) {
+    wr_op_backoff_(false),
+    wr_offline_msgs_(0),
+    wr_offline_flushed_(0),
+    coalesced_messages_(nullptr),
+    write_size_(nullptr) {
   configure_read(receive_policy::at_most(1024));
+  auto& sys = backend().system();
+  if (sys.has_middleman()) {
+    auto& metrics = sys.middleman().metric_singletons;
+    coalesced_messages_ = metrics.coalesced_messages;
+    write_size_ = metrics.write_size;
+  }
 }
 
 void stream::start(stream_manager* mgr) {
@@ -56,11 +68,19 @@ void stream::write(const void* buf, size_t num_bytes) {
 void stream::flush(const manager_ptr& mgr) {
   CAF_ASSERT(mgr != nullptr);
   auto lg = log::io::trace("wr_offline_buf_.size = {}", wr_offline_buf_.size());
+  // Each flush that adds data to the buffer marks the end of a message.
+  if (wr_offline_buf_.size() > wr_offline_flushed_) {
+    ++wr_offline_msgs_;
+    wr_offline_flushed_ = wr_offline_buf_.size();
+  }
+  // Note: we only register for write events here and pick up the buffered data
+  //       once the socket becomes writable. This coalesces all messages that
+  //       we flush during the same iteration of the multiplexer loop into a
+  //       single write.
   if (!wr_offline_buf_.empty() && !state_.writing && !wr_op_backoff_) {
     backend().add(operation::write, fd(), this);
     writer_ = mgr;
     state_.writing = true;
-    prepare_next_write();
   }
 }
 
@@ -131,9 +151,23 @@ void stream::prepare_next_write() {
     backend().del(operation::write, fd(), this);
     if (state_.shutting_down)
       send_fin();
-  } else {
-    wr_buf_.swap(wr_offline_buf_);
   }
+  // Otherwise, we stay registered for writing and the next write event picks
+  // up the content of the offline buffer.
+}
+
+void stream::start_next_write() {
+  auto lg = log::io::trace("wr_offline_buf_.size = {}", wr_offline_buf_.size());
+  CAF_ASSERT(wr_buf_.empty());
+  if (wr_offline_buf_.empty())
+    return;
+  wr_buf_.swap(wr_offline_buf_);
+  written_ = 0;
+  if (coalesced_messages_ != nullptr)
+    coalesced_messages_->observe(
+      static_cast<int64_t>(std::max(wr_offline_msgs_, size_t{1})));
+  wr_offline_msgs_ = 0;
+  wr_offline_flushed_ = 0;
 }
 
 bool stream::handle_read_result(rw_state read_result, size_t rb) {
@@ -191,6 +225,8 @@ void stream::handle_write_result(rw_state write_result, size_t wb) {
         break;
       [[fallthrough]];
     case rw_state::success:
+      if (wb > 0 && write_size_ != nullptr)
+        write_size_->observe(static_cast<int64_t>(wb));
       written_ += wb;
       CAF_ASSERT(written_ <= wr_buf_.size());
       auto remaining = wr_buf_.size() - written_;
@@ -12,6 +12,7 @@
 
 #include "caf/byte_buffer.hpp"
 #include "caf/detail/io_export.hpp"
+#include "caf/fwd.hpp"
 #include "caf/log/io.hpp"
 #include "caf/ref_counted.hpp"
 
@@ -50,6 +51,12 @@ public:
     return wr_offline_buf_;
   }
 
+  /// Returns the number of bytes that the stream still needs to write,
+  /// including the content of the write buffer.
+  size_t pending_output() const noexcept {
+    return (wr_buf_.size() - written_) + wr_offline_buf_.size();
+  }
+
   /// Returns the read buffer of this stream.
   /// @warning Must not be modified outside the IO multiplexers event loop
   ///          once the stream has been started.
@@ -96,6 +103,9 @@ protected:
         break;
       }
       case io::network::operation::write: {
+        // Pick up everything that accumulated since the last write.
+        if (wr_buf_.empty())
+          start_next_write();
         size_t wb; // Written bytes.
         auto res = policy.write_some(wb, fd(), wr_buf_.data() + written_,
                                      wr_buf_.size() - written_);
@@ -113,6 +123,8 @@ private:
 
   void prepare_next_write();
 
+  void start_next_write();
+
   bool handle_read_result(rw_state read_result, size_t rb);
 
   void handle_write_result(rw_state write_result, size_t wb);
@@ -138,6 +150,12 @@ private:
   byte_buffer wr_buf_;
   byte_buffer wr_offline_buf_;
   bool wr_op_backoff_;
+
+  // State for coalescing writes.
+  size_t wr_offline_msgs_;
+  size_t wr_offline_flushed_;
+  telemetry::int_histogram* coalesced_messages_;
+  telemetry::int_histogram* write_size_;
 };
 
 } // namespace caf::io::network
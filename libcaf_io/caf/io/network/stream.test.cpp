@@ -0,0 +1,187 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/io/network/stream.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/io/middleman.hpp"
+#include "caf/io/network/default_multiplexer.hpp"
+#include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/stream_impl.hpp"
+#include "caf/io/network/stream_manager.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/config.hpp"
+#include "caf/policy/tcp.hpp"
+#include "caf/raise_error.hpp"
+#include "caf/telemetry/histogram.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#ifndef CAF_WINDOWS
+#  include <sys/socket.h>
+#endif
+
+using namespace caf;
+using namespace caf::io::network;
+
+namespace {
+
+#ifndef CAF_WINDOWS
+
+// Forwards to the TCP policy and counts the calls to `write_some`.
+struct counting_policy : policy::tcp {
+  static inline size_t writes = 0;
+
+  static rw_state write_some(size_t& result, native_socket fd, const void* buf,
+                             size_t len) {
+    ++writes;
+    return tcp::write_some(result, fd, buf, len);
+  }
+};
+
+// Serves as writer for the stream without a parent broker.
+class dummy_manager : public stream_manager {
+public:
+  bool consume(scheduler*, const void*, size_t) override {
+    return true;
+  }
+
+  void data_transferred(scheduler*, size_t, size_t) override {
+    // nop
+  }
+
+  uint16_t port() const override {
+    return 0;
+  }
+
+  std::string addr() const override {
+    return {};
+  }
+
+  void graceful_shutdown() override {
+    // nop
+  }
+
+  void remove_from_loop() override {
+    // nop
+  }
+
+  void add_to_loop() override {
+    // nop
+  }
+
+protected:
+  message detach_message() override {
+    return {};
+  }
+
+  void detach_from(io::abstract_broker*) override {
+    // nop
+  }
+};
+
+// Returns how many values `hist` has observed.
+int64_t observations(const telemetry::int_histogram& hist) {
+  int64_t result = 0;
+  for (auto& bucket : hist.buckets())
+    result += bucket.count.value();
+  return result;
+}
+
+struct fixture {
+  fixture() {
+    cfg.load<io::middleman>();
+    sys = std::make_unique<actor_system>(cfg);
+    mpx = std::make_unique<default_multiplexer>(*sys);
+    native_socket fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+      CAF_RAISE_ERROR("socketpair failed");
+    std::ignore = nonblocking(fds[0], true);
+    std::ignore = nonblocking(fds[1], true);
+    peer = fds[1];
+    uut = std::make_unique<stream_impl<counting_policy>>(*mpx, fds[0]);
+    mgr = make_counted<dummy_manager>();
+    counting_policy::writes = 0;
+  }
+
+  ~fixture() {
+    close_socket(peer);
+  }
+
+  void write(std::string_view str) {
+    uut->write(str.data(), str.size());
+  }
+
+  // Reads everything that the stream has written to the socket.
+  std::string received() {
+    std::string result;
+    char buf[256];
+    for (;;) {
+      auto n = ::recv(peer, buf, sizeof(buf), 0);
+      if (n <= 0)
+        return result;
+      result.append(buf, static_cast<size_t>(n));
+    }
+  }
+
+  telemetry::int_histogram& coalesced_messages() {
+    return *sys->middleman().metric_singletons.coalesced_messages;
+  }
+
+  telemetry::int_histogram& write_size() {
+    return *sys->middleman().metric_singletons.write_size;
+  }
+
+  actor_system_config cfg;
+  std::unique_ptr<actor_system> sys;
+  std::unique_ptr<default_multiplexer> mpx;
+  std::unique_ptr<stream_impl<counting_policy>> uut;
+  intrusive_ptr<dummy_manager> mgr;
+  native_socket peer;
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("flushes in the same loop iteration result in a single write") {
+  // Three messages from the same loop iteration.
+  write("hello");
+  uut->flush(mgr);
+  write(" ");
+  uut->flush(mgr);
+  write("world");
+  uut->flush(mgr);
+  // Flushing without new data does not count as a message.
+  uut->flush(mgr);
+  check_eq(counting_policy::writes, 0u);
+  // The socket becomes writable in the next loop iteration.
+  uut->handle_event(operation::write);
+  check_eq(counting_policy::writes, 1u);
+  check_eq(received(), "hello world");
+  check_eq(observations(coalesced_messages()), 1);
+  check_eq(coalesced_messages().sum(), 3);
+  check_eq(observations(write_size()), 1);
+  check_eq(write_size().sum(), 11);
+  SECTION("flushing after a write starts the next batch") {
+    write("again");
+    uut->flush(mgr);
+    uut->handle_event(operation::write);
+    check_eq(counting_policy::writes, 2u);
+    check_eq(received(), "again");
+    check_eq(observations(coalesced_messages()), 2);
+    check_eq(coalesced_messages().sum(), 4);
+    check_eq(observations(write_size()), 2);
+    check_eq(write_size().sum(), 16);
+  }
+}
+
+} // WITH_FIXTURE(fixture)
+
+#endif // CAF_WINDOWS
+
+} // namespace
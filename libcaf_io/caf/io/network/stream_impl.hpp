@@ -19,6 +19,10 @@ public:
     // nop
   }
 
+  ProtocolPolicy& policy() noexcept {
+    return policy_;
+  }
+
   void handle_event(io::network::operation op) override {
     this->handle_event_impl(op, policy_);
   }
@@ -6,6 +6,7 @@
 
 #include "caf/detail/assert.hpp"
 #include "caf/log/io.hpp"
+#include "caf/sec.hpp"
 
 namespace caf::io {
 
@@ -17,6 +18,32 @@ scribe::~scribe() {
   auto lg = log::io::trace("");
 }
 
+expected<std::string> scribe::create_shared_memory(size_t) {
+  return make_error(sec::unsupported_operation,
+                    "scribe does not support shared memory");
+}
+
+error scribe::open_shared_memory(const std::string&) {
+  return make_error(sec::unsupported_operation,
+                    "scribe does not support shared memory");
+}
+
+void scribe::unlink_shared_memory() {
+  // nop
+}
+
+void scribe::close_shared_memory() {
+  // nop
+}
+
+void scribe::switch_output_to_shared_memory() {
+  // nop
+}
+
+void scribe::switch_input_to_shared_memory() {
+  // nop
+}
+
 message scribe::detach_message() {
   return make_message(connection_closed_msg{hdl()});
 }
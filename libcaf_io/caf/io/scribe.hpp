@@ -12,8 +12,10 @@
 #include "caf/allowed_unsafe_message_type.hpp"
 #include "caf/byte_buffer.hpp"
 #include "caf/detail/io_export.hpp"
+#include "caf/expected.hpp"
 #include "caf/message.hpp"
 
+#include <string>
 #include <vector>
 
 namespace caf::io {
@@ -45,6 +47,32 @@ public:
   /// content of the buffer via the network.
   virtual void flush() = 0;
 
+  // -- shared memory transport ------------------------------------------------
+
+  /// Creates a shared memory segment for exchanging data with a process on
+  /// the same host. The default implementation returns an error.
+  /// @returns the name of the new segment.
+  virtual expected<std::string> create_shared_memory(size_t ring_size);
+
+  /// Maps the shared memory segment `name` created by the remote process.
+  virtual error open_shared_memory(const std::string& name);
+
+  /// Removes the name of the shared memory segment from the system after
+  /// both processes have mapped it.
+  virtual void unlink_shared_memory();
+
+  /// Releases the shared memory segment unless the scribe already uses it.
+  virtual void close_shared_memory();
+
+  /// Sends all further data through the shared memory segment once the socket
+  /// has transmitted the content of the write buffer.
+  virtual void switch_output_to_shared_memory();
+
+  /// Receives all further data from the shared memory segment.
+  virtual void switch_input_to_shared_memory();
+
+  // -- overrides --------------------------------------------------------------
+
   bool consume(scheduler*, const void*, size_t) override;
 
   void data_transferred(scheduler*, size_t, size_t) override;
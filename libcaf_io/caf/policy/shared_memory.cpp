@@ -0,0 +1,172 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/policy/shared_memory.hpp"
+
+#include "caf/io/network/native_socket.hpp"
+
+#include "caf/log/io.hpp"
+#include "caf/policy/tcp.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#ifdef CAF_WINDOWS
+#  include <winsock2.h>
+#else
+#  include <sys/socket.h>
+#  include <sys/types.h>
+#endif
+
+using caf::io::network::is_error;
+using caf::io::network::last_socket_error;
+using caf::io::network::native_socket;
+using caf::io::network::no_sigpipe_io_flag;
+using caf::io::network::rw_state;
+using caf::io::network::shm_segment;
+using caf::io::network::signed_size_type;
+using caf::io::network::socket_error_as_string;
+
+namespace caf::policy {
+
+// -- I/O operations -----------------------------------------------------------
+
+rw_state shared_memory::read_some(size_t& result, native_socket fd, void* buf,
+                                  size_t len) {
+  if (!input_)
+    return tcp::read_some(result, fd, buf, len);
+  auto lg = log::io::trace("fd = {}, len = {}", fd, len);
+  // Drain all pending wakeups from the socket. Once the remote side has closed
+  // the connection, we still deliver the remaining data from the segment.
+  auto closed = false;
+  uint8_t tmp[64];
+  for (;;) {
+    auto sres = ::recv(fd, reinterpret_cast<io::network::socket_recv_ptr>(tmp),
+                       sizeof(tmp), no_sigpipe_io_flag);
+    if (is_error(sres, true)) {
+      // Make sure WSAGetLastError gets called immediately on Windows.
+      auto err = last_socket_error();
+      log::io::error("recv failed: {}", socket_error_as_string(err));
+      return rw_state::failure;
+    }
+    if (sres == 0) {
+      closed = true;
+      break;
+    }
+    if (sres < static_cast<signed_size_type>(sizeof(tmp)))
+      break;
+  }
+  auto n = segment_->read(buf, len);
+  if (n == 0 && !closed && !segment_->suspend_reader())
+    n = segment_->read(buf, len);
+  if (n < 0)
+    return rw_state::failure;
+  if (n == 0 && closed) {
+    log::io::debug("peer performed orderly shutdown fd = {}", fd);
+    return rw_state::failure;
+  }
+  if (n > 0) {
+    if (segment_->resume_writer())
+      wakeup(fd);
+    // The stream may return to the multiplexer after this read. Hence, we
+    // flag that we wait for data once we have drained the ring. Otherwise,
+    // the remote side writes without waking us up.
+    if (segment_->input_empty())
+      segment_->suspend_reader();
+  }
+  log::io::debug("len = {} fd = {} n = {}", len, fd, n);
+  result = static_cast<size_t>(n);
+  return rw_state::success;
+}
+
+rw_state shared_memory::write_some(size_t& result, native_socket fd,
+                                   const void* buf, size_t len) {
+  if (!output_)
+    return tcp::write_some(result, fd, buf, len);
+  // Data that the stream has buffered before switching still goes through the
+  // socket in order to preserve the order of the byte stream.
+  if (pending_ > 0) {
+    auto res = tcp::write_some(result, fd, buf, std::min(len, pending_));
+    if (res == rw_state::success)
+      pending_ -= result;
+    return res;
+  }
+  auto lg = log::io::trace("fd = {}, len = {}", fd, len);
+  auto n = segment_->write(buf, len);
+  if (n == 0 && !segment_->suspend_writer())
+    n = segment_->write(buf, len);
+  if (n < 0)
+    return rw_state::failure;
+  if (n == 0) {
+    log::io::debug("segment full, wait for the remote side fd = {}", fd);
+    result = 0;
+    return rw_state::want_read;
+  }
+  if (segment_->resume_reader())
+    wakeup(fd);
+  log::io::debug("len = {} fd = {} n = {}", len, fd, n);
+  result = static_cast<size_t>(n);
+  return rw_state::success;
+}
+
+bool shared_memory::must_read_more(native_socket, size_t) noexcept {
+  // Returning false hands control back to the multiplexer, which only calls
+  // us again after a wakeup. Hence, we must set the flag and then check the
+  // ring once more for data that arrived in the meantime.
+  return input_
+         && (!segment_->input_empty() || !segment_->suspend_reader());
+}
+
+// -- shared memory management -------------------------------------------------
+
+expected<std::string> shared_memory::create(size_t ring_size) {
+  auto segment = shm_segment::create(ring_size);
+  if (!segment)
+    return std::move(segment.error());
+  segment_ = std::move(*segment);
+  return segment_->name();
+}
+
+error shared_memory::open(const std::string& name) {
+  auto segment = shm_segment::open(name);
+  if (!segment)
+    return std::move(segment.error());
+  segment_ = std::move(*segment);
+  return none;
+}
+
+void shared_memory::unlink() {
+  if (segment_)
+    segment_->unlink();
+}
+
+void shared_memory::close() {
+  if (!input_ && !output_)
+    segment_.reset();
+}
+
+void shared_memory::switch_output(size_t pending) {
+  if (segment_) {
+    output_ = true;
+    pending_ = pending;
+  }
+}
+
+void shared_memory::switch_input() {
+  if (segment_)
+    input_ = true;
+}
+
+void shared_memory::wakeup(native_socket fd) {
+  // A full socket buffer means that the remote side has pending wakeups
+  // anyway, so we can safely drop this one.
+  uint8_t token = 1;
+  auto sres = ::send(fd, reinterpret_cast<io::network::socket_send_ptr>(&token),
+                     1, no_sigpipe_io_flag);
+  if (is_error(sres, true))
+    log::io::debug("failed to send wakeup: {}",
+                   socket_error_as_string(last_socket_error()));
+}
+
+} // namespace caf::policy
@@ -0,0 +1,78 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/rw_state.hpp"
+#include "caf/io/network/shm_segment.hpp"
+
+#include "caf/detail/io_export.hpp"
+#include "caf/expected.hpp"
+
+#include <string>
+
+namespace caf::policy {
+
+/// Policy object for TCP connections that may move their payload to a shared
+/// memory segment. Behaves like the `tcp` policy until switching input or
+/// output to the segment. Afterwards, the socket only carries wakeup
+/// notifications and signals when the remote side closes the connection.
+class CAF_IO_EXPORT shared_memory {
+public:
+  // -- I/O operations ---------------------------------------------------------
+
+  /// Reads up to `len` bytes from the socket or, after switching input, from
+  /// the segment. Returns `failure` once the remote side has closed the socket
+  /// and the segment has no more data.
+  io::network::rw_state read_some(size_t& result,
+                                  io::network::native_socket fd, void* buf,
+                                  size_t len);
+
+  /// Writes up to `len` bytes to the socket or, after switching output, to
+  /// the segment. Returns `want_read` if the segment is full, i.e., the stream
+  /// stops writing until the remote side wakes it up again.
+  io::network::rw_state write_some(size_t& result,
+                                   io::network::native_socket fd,
+                                   const void* buf, size_t len);
+
+  /// Returns `true` while the segment has unread data. Wakeups only signal
+  /// that new data is available but not how much. Flags that this side waits
+  /// for data before returning `false`.
+  bool must_read_more(io::network::native_socket, size_t) noexcept;
+
+  // -- shared memory management -----------------------------------------------
+
+  /// Creates a new segment with rings of at least `ring_size` bytes.
+  /// @returns the name of the new segment.
+  expected<std::string> create(size_t ring_size);
+
+  /// Maps the segment `name` that the remote side has created.
+  error open(const std::string& name);
+
+  /// Removes the name of the segment from the system after both sides have
+  /// mapped it.
+  void unlink();
+
+  /// Releases the segment. Has no effect after switching input or output.
+  void close();
+
+  /// Sends all data through the segment after writing the next `pending`
+  /// bytes to the socket.
+  void switch_output(size_t pending);
+
+  /// Reads all further data from the segment.
+  void switch_input();
+
+private:
+  /// Writes a single byte to the socket to wake up the remote side.
+  static void wakeup(io::network::native_socket fd);
+
+  io::network::shm_segment_ptr segment_;
+  bool input_ = false;
+  bool output_ = false;
+  size_t pending_ = 0;
+};
+
+} // namespace caf::policy
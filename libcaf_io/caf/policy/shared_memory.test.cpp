@@ -0,0 +1,106 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/policy/shared_memory.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/io/middleman.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/config.hpp"
+#include "caf/detail/get_process_id.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_actor.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+#ifdef CAF_LINUX
+
+// Counts how many mappings of shared memory segments this process has. Each
+// side of a connection maps the segment once.
+size_t mapped_segments() {
+  auto prefix = "/dev/shm/caf-" + std::to_string(detail::get_process_id())
+                + '-';
+  std::ifstream in{"/proc/self/maps"};
+  std::string line;
+  size_t result = 0;
+  while (std::getline(in, line))
+    if (line.find(prefix) != std::string::npos)
+      ++result;
+  return result;
+}
+
+behavior echo_server() {
+  return {
+    [](const std::string& str) { return str; },
+  };
+}
+
+// Bundles an actor system with its configuration.
+struct node {
+  explicit node(bool enable_shared_memory) {
+    cfg.load<io::middleman>();
+    put(cfg.content, "caf.middleman.enable-shared-memory",
+        enable_shared_memory);
+    sys = std::make_unique<actor_system>(cfg);
+  }
+
+  actor_system_config cfg;
+  std::unique_ptr<actor_system> sys;
+};
+
+// Runs a client and a server on the loopback interface and returns how many
+// shared memory mappings exist after sending `payload` back and forth.
+size_t roundtrip(bool enable_shared_memory, const std::string& payload) {
+  auto& rt = test::runnable::current();
+  auto server = node{enable_shared_memory};
+  auto client = node{enable_shared_memory};
+  auto port = server.sys->middleman().publish(
+    server.sys->spawn(echo_server), 0, "127.0.0.1");
+  rt.require(port.has_value());
+  auto hdl = client.sys->middleman().remote_actor("127.0.0.1", *port);
+  rt.require(hdl.has_value());
+  scoped_actor self{*client.sys};
+  // The first request may still travel via TCP while both sides negotiate the
+  // segment. Sending multiple requests makes sure that both sides use the
+  // segment in both directions.
+  for (int i = 0; i < 3; ++i) {
+    self->mail(payload)
+      .request(*hdl, 10s)
+      .receive([&rt, &payload](
+                 const std::string& str) { rt.check_eq(str, payload); },
+               [&rt](const error& err) { rt.fail("error: {}", err); });
+  }
+  auto result = mapped_segments();
+  self->send_exit(*hdl, exit_reason::user_shutdown);
+  return result;
+}
+
+TEST("BASP connections on the loopback interface switch to shared memory") {
+  SECTION("both sides map the segment after offer, accept and confirm") {
+    check_eq(roundtrip(true, "hello world"), 2u);
+  }
+  SECTION("messages may exceed the size of the rings") {
+    auto payload = std::string(3 * 1024 * 1024, 'x');
+    check_eq(roundtrip(true, payload), 2u);
+  }
+  SECTION("disabling shared memory keeps all traffic on the socket") {
+    check_eq(roundtrip(false, "hello world"), 0u);
+  }
+  check_eq(mapped_segments(), 0u);
+}
+
+#endif // CAF_LINUX
+
+} // namespace
@@ -6,6 +6,8 @@
 
 #include "caf/io/network/native_socket.hpp"
 
+#include "caf/config.hpp"
+#include "caf/detail/assert.hpp"
 #include "caf/log/io.hpp"
 
 #ifdef CAF_WINDOWS
@@ -15,6 +17,9 @@
 #  include <sys/types.h>
 #endif
 
+#include <algorithm>
+#include <vector>
+
 using caf::io::network::is_error;
 using caf::io::network::last_socket_error;
 using caf::io::network::native_socket;
@@ -64,4 +69,125 @@ bool udp::write_datagram(size_t& result, native_socket fd, void* buf,
   return true;
 }
 
+#ifdef CAF_LINUX
+
+namespace {
+
+/// Caches the message headers for `recvmmsg` and `sendmmsg`.
+struct mmsg_buffers {
+  std::vector<mmsghdr> hdrs;
+  std::vector<iovec> iovs;
+
+  void reset(size_t num) {
+    hdrs.resize(std::max(hdrs.size(), num));
+    iovs.resize(std::max(iovs.size(), num));
+    memset(hdrs.data(), 0, num * sizeof(mmsghdr));
+  }
+};
+
+// The I/O loop of the multiplexer runs in a single thread. Hence, each thread
+// only ever needs one set of buffers.
+thread_local mmsg_buffers mmsg_cache;
+
+} // namespace
+
+bool udp::read_datagrams(size_t& result, native_socket fd,
+                         span<io::network::receive_buffer> bufs,
+                         span<size_t> sizes,
+                         span<io::network::ip_endpoint> eps) {
+  auto lg = log::io::trace("fd = {}, bufs.size = {}", fd, bufs.size());
+  CAF_ASSERT(bufs.size() == sizes.size() && bufs.size() == eps.size());
+  auto num = bufs.size();
+  auto& cache = mmsg_cache;
+  cache.reset(num);
+  for (size_t i = 0; i < num; ++i) {
+    memset(eps[i].address(), 0, sizeof(sockaddr_storage));
+    cache.iovs[i].iov_base = bufs[i].data();
+    cache.iovs[i].iov_len = bufs[i].size();
+    auto& hdr = cache.hdrs[i].msg_hdr;
+    hdr.msg_name = eps[i].address();
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &cache.iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+  auto sres = ::recvmmsg(fd, cache.hdrs.data(), static_cast<unsigned>(num), 0,
+                         nullptr);
+  if (is_error(sres, true)) {
+    auto err = last_socket_error();
+    log::io::error("recvmmsg failed: {}", socket_error_as_string(err));
+    return false;
+  }
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  for (size_t i = 0; i < result; ++i) {
+    sizes[i] = cache.hdrs[i].msg_len;
+    *eps[i].length() = cache.hdrs[i].msg_hdr.msg_namelen;
+  }
+  return true;
+}
+
+bool udp::write_datagrams(size_t& result, native_socket fd,
+                          span<const byte_buffer> bufs,
+                          span<const io::network::ip_endpoint> eps) {
+  auto lg = log::io::trace("fd = {}, bufs.size = {}", fd, bufs.size());
+  CAF_ASSERT(bufs.size() == eps.size());
+  auto num = bufs.size();
+  auto& cache = mmsg_cache;
+  cache.reset(num);
+  for (size_t i = 0; i < num; ++i) {
+    cache.iovs[i].iov_base = const_cast<std::byte*>(bufs[i].data());
+    cache.iovs[i].iov_len = bufs[i].size();
+    auto& hdr = cache.hdrs[i].msg_hdr;
+    hdr.msg_name = const_cast<sockaddr*>(eps[i].caddress());
+    hdr.msg_namelen = static_cast<socklen_t>(*eps[i].clength());
+    hdr.msg_iov = &cache.iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+  auto sres = ::sendmmsg(fd, cache.hdrs.data(), static_cast<unsigned>(num), 0);
+  if (is_error(sres, true)) {
+    auto err = last_socket_error();
+    log::io::error("sendmmsg failed: {}", socket_error_as_string(err));
+    return false;
+  }
+  result = (sres > 0) ? static_cast<size_t>(sres) : 0;
+  return true;
+}
+
+#else // CAF_LINUX
+
+bool udp::read_datagrams(size_t& result, native_socket fd,
+                         span<io::network::receive_buffer> bufs,
+                         span<size_t> sizes,
+                         span<io::network::ip_endpoint> eps) {
+  CAF_ASSERT(bufs.size() == sizes.size() && bufs.size() == eps.size());
+  result = 0;
+  for (size_t i = 0; i < bufs.size(); ++i) {
+    if (!read_datagram(sizes[i], fd, bufs[i].data(), bufs[i].size(), eps[i]))
+      return result > 0;
+    // Without data, the socket has nothing more to read.
+    if (sizes[i] == 0)
+      return true;
+    ++result;
+  }
+  return true;
+}
+
+bool udp::write_datagrams(size_t& result, native_socket fd,
+                          span<const byte_buffer> bufs,
+                          span<const io::network::ip_endpoint> eps) {
+  CAF_ASSERT(bufs.size() == eps.size());
+  result = 0;
+  for (size_t i = 0; i < bufs.size(); ++i) {
+    size_t written = 0;
+    auto buf = const_cast<std::byte*>(bufs[i].data());
+    if (!write_datagram(written, fd, buf, bufs[i].size(), eps[i]))
+      return result > 0;
+    if (written == 0 && !bufs[i].empty())
+      return true;
+    ++result;
+  }
+  return true;
+}
+
+#endif // CAF_LINUX
+
 } // namespace caf::policy
@@ -6,8 +6,11 @@
 
 #include "caf/io/network/ip_endpoint.hpp"
 #include "caf/io/network/native_socket.hpp"
+#include "caf/io/network/receive_buffer.hpp"
 
+#include "caf/byte_buffer.hpp"
 #include "caf/detail/io_export.hpp"
+#include "caf/span.hpp"
 
 namespace caf::policy {
 
@@ -29,6 +32,24 @@ struct CAF_IO_EXPORT udp {
                              void* buf, size_t buf_len,
                              const io::network::ip_endpoint& ep);
 
+  /// Receives up to `bufs.size()` datagrams with a single system call on
+  /// platforms that support `recvmmsg`. Stores the number of received
+  /// datagrams in `result`, the size of each datagram in `sizes` and each
+  /// sender in `eps`. Returns `true` as long as no IO error occurs.
+  /// @pre `bufs.size() == sizes.size() && bufs.size() == eps.size()`
+  static bool read_datagrams(size_t& result, io::network::native_socket fd,
+                             span<io::network::receive_buffer> bufs,
+                             span<size_t> sizes,
+                             span<io::network::ip_endpoint> eps);
+
+  /// Sends the datagrams in `bufs` to the endpoints in `eps` with a single
+  /// system call on platforms that support `sendmmsg`. Stores the number of
+  /// sent datagrams in `result`. Returns `true` as long as no IO error occurs.
+  /// @pre `bufs.size() == eps.size()`
+  static bool write_datagrams(size_t& result, io::network::native_socket fd,
+                              span<const byte_buffer> bufs,
+                              span<const io::network::ip_endpoint> eps);
+
   /// Always returns `false`. Native UDP I/O event handlers only rely on the
   /// socket buffer.
   static constexpr bool must_read_more(io::network::native_socket, size_t) {
@@ -119,9 +119,10 @@ ptrdiff_t rfc6455::decode_header(const_byte_span data, header& result) {
   } else {
     hdr.mask_key = 0;
   }
-  // No extension bits allowed.
-  if (byte1 & 0x70)
+  // Only RSV1 has a meaning (for compressed messages).
+  if (byte1 & 0x30)
     return -1;
+  hdr.rsv1 = (byte1 & rsv1_flag) != 0;
   // Verify opcode and return number of consumed bytes.
   switch (hdr.opcode) {
     case continuation_frame:
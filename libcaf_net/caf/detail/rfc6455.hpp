@@ -19,6 +19,7 @@ struct CAF_NET_EXPORT rfc6455 {
 
   struct header {
     bool fin = false;
+    bool rsv1 = false;
     uint8_t opcode = invalid_frame;
     uint32_t mask_key = 0;
     uint64_t payload_len = 0;
@@ -47,6 +48,9 @@ struct CAF_NET_EXPORT rfc6455 {
 
   static constexpr uint8_t fin_flag = 0x80;
 
+  /// Marks compressed messages when using the permessage-deflate extension.
+  static constexpr uint8_t rsv1_flag = 0x40;
+
   // -- utility functions ------------------------------------------------------
 
   static void mask_data(uint32_t key, span<char> data, size_t offset = 0);
@@ -69,7 +69,7 @@ TEST("partial masking with offset") {
   }
 }
 
-TEST("decoding a frame with RSV bits fails") {
+TEST("decoding a frame with RSV2 or RSV3 bits fails") {
   std::vector<uint8_t> data;
   byte_buffer out = bytes({
     0xF2, // FIN + RSV + binary frame opcode
@@ -79,6 +79,17 @@ TEST("decoding a frame with RSV bits fails") {
   check_eq(impl::decode_header(out, hdr), -1);
 }
 
+TEST("decoding a frame with the RSV1 bit sets the rsv1 flag") {
+  byte_buffer out = bytes({
+    0xC2, // FIN + RSV1 + binary frame opcode
+    0x00, // data size = 0
+  });
+  impl::header hdr;
+  check_eq(impl::decode_header(out, hdr), 2);
+  check(hdr.rsv1);
+  check_eq(hdr.opcode, impl::binary_frame);
+}
+
 TEST("decode a header with no mask key and no data") {
   std::vector<uint8_t> data;
   byte_buffer out;
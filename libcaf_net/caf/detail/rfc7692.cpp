@@ -0,0 +1,429 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/rfc7692.hpp"
+
+#include "caf/net/web_socket/deflate_config.hpp"
+
+#include "caf/config.hpp"
+#include "caf/sec.hpp"
+#include "caf/string_algorithms.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#ifdef CAF_ENABLE_ZLIB
+CAF_PUSH_WARNINGS
+#  include <zlib.h>
+CAF_POP_WARNINGS
+#endif
+
+namespace caf::detail {
+
+namespace {
+
+#ifdef CAF_ENABLE_ZLIB
+
+/// Grows output buffers in steps of this size while running zlib.
+constexpr size_t zlib_chunk_size = 16 * 1024;
+
+/// Every message compressed with Z_SYNC_FLUSH ends with these bytes. RFC 7692
+/// strips them from the payload.
+constexpr std::byte deflate_tail[] = {std::byte{0x00}, std::byte{0x00},
+                                      std::byte{0xFF}, std::byte{0xFF}};
+
+#endif // CAF_ENABLE_ZLIB
+
+/// Stores the parameters of a single permessage-deflate offer or response as
+/// received from the remote side.
+struct raw_parameters {
+  bool server_no_context_takeover = false;
+  bool client_no_context_takeover = false;
+  std::optional<int> server_max_window_bits;
+  bool has_client_max_window_bits = false;
+  std::optional<int> client_max_window_bits;
+};
+
+/// Parses a window size in the range [8, 15], optionally in quotes.
+std::optional<int> parse_window_bits(std::string_view str) {
+  if (str.size() >= 2 && str.front() == '"' && str.back() == '"')
+    str = str.substr(1, str.size() - 2);
+  if (str.size() == 1 && (str[0] == '8' || str[0] == '9'))
+    return str[0] - '0';
+  if (str.size() == 2 && str[0] == '1' && str[1] >= '0' && str[1] <= '5')
+    return 10 + (str[1] - '0');
+  return std::nullopt;
+}
+
+/// Parses a single extension element such as `permessage-deflate;
+/// client_max_window_bits`. Returns `false` if the element names another
+/// extension or contains unknown, duplicate or malformed parameters.
+bool parse_element(std::string_view element, raw_parameters& result) {
+  std::vector<std::string_view> parts;
+  split(parts, element, ';');
+  if (parts.empty() || trim(parts[0]) != rfc7692::extension_name)
+    return false;
+  for (auto i = parts.begin() + 1; i != parts.end(); ++i) {
+    auto has_value = i->find('=') != std::string_view::npos;
+    auto [key, value] = split_by(*i, "=");
+    key = trim(key);
+    value = trim(value);
+    if (key == "server_no_context_takeover") {
+      if (has_value || result.server_no_context_takeover)
+        return false;
+      result.server_no_context_takeover = true;
+    } else if (key == "client_no_context_takeover") {
+      if (has_value || result.client_no_context_takeover)
+        return false;
+      result.client_no_context_takeover = true;
+    } else if (key == "server_max_window_bits") {
+      if (result.server_max_window_bits)
+        return false;
+      result.server_max_window_bits = parse_window_bits(value);
+      if (!result.server_max_window_bits)
+        return false;
+    } else if (key == "client_max_window_bits") {
+      if (result.has_client_max_window_bits)
+        return false;
+      result.has_client_max_window_bits = true;
+      if (has_value) {
+        result.client_max_window_bits = parse_window_bits(value);
+        if (!result.client_max_window_bits)
+          return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// The smallest window size we negotiate. zlib does not support raw DEFLATE
+/// streams with a window size of 8 bits and silently uses 9 bits instead.
+/// Hence, a peer using zlib may produce messages that a decompressor with a
+/// window size of 8 bits rejects.
+constexpr int min_supported_window_bits = 9;
+
+/// Returns the largest window size up to `limit` for decompressing messages
+/// that fits into `max_memory` next to a compressor for the window size
+/// `deflate_bits`. Returns 0 if no window size fits.
+int inflate_window_bits(int limit, int deflate_bits,
+                        size_t max_memory) noexcept {
+  auto used = rfc7692::deflate_memory(deflate_bits);
+  for (auto bits = std::min(limit, rfc7692::max_window_bits);
+       bits >= min_supported_window_bits; --bits)
+    if (used + rfc7692::inflate_memory(bits) <= max_memory)
+      return bits;
+  return 0;
+}
+
+/// Returns the largest window size up to `limit` for decompressing messages
+/// on the client. The client cannot know its window size for compressing
+/// messages before receiving the response of the server and thus reserves
+/// memory for the smallest window size.
+int client_inflate_window_bits(int limit, size_t max_memory) noexcept {
+  return inflate_window_bits(limit, min_supported_window_bits, max_memory);
+}
+
+void append(std::string& str, std::string_view param) {
+  str += "; ";
+  str += param;
+}
+
+void append(std::string& str, std::string_view param, int value) {
+  append(str, param);
+  str += '=';
+  str += std::to_string(value);
+}
+
+} // namespace
+
+// -- codec --------------------------------------------------------------------
+
+#ifdef CAF_ENABLE_ZLIB
+
+struct rfc7692::codec::impl {
+  z_stream deflater;
+  z_stream inflater;
+  bool has_deflater = false;
+  bool has_inflater = false;
+  bool reset_deflater = false;
+  bool reset_inflater = false;
+
+  impl() {
+    memset(&deflater, 0, sizeof(z_stream));
+    memset(&inflater, 0, sizeof(z_stream));
+  }
+
+  ~impl() {
+    if (has_deflater)
+      deflateEnd(&deflater);
+    if (has_inflater)
+      inflateEnd(&inflater);
+  }
+
+  // Runs the inflater on `input` until it has consumed all bytes.
+  bool inflate_all(const_byte_span input, byte_buffer& output,
+                   size_t max_size) {
+    inflater.next_in = reinterpret_cast<Bytef*>(
+      const_cast<std::byte*>(input.data()));
+    inflater.avail_in = static_cast<uInt>(input.size());
+    for (;;) {
+      auto offset = output.size();
+      output.resize(offset + zlib_chunk_size);
+      inflater.next_out = reinterpret_cast<Bytef*>(output.data() + offset);
+      inflater.avail_out = static_cast<uInt>(zlib_chunk_size);
+      auto rc = inflate(&inflater, Z_SYNC_FLUSH);
+      output.resize(output.size() - inflater.avail_out);
+      if (rc == Z_STREAM_END) {
+        // The sender may terminate the DEFLATE stream with a final block. In
+        // this case, we start over with a fresh stream for the next message.
+        inflateReset(&inflater);
+      } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+        return false;
+      }
+      if (output.size() > max_size)
+        return true;
+      if (inflater.avail_in == 0 && inflater.avail_out != 0)
+        return true;
+    }
+  }
+};
+
+rfc7692::codec::codec() : impl_(std::make_unique<impl>()) {
+  // nop
+}
+
+rfc7692::codec::~codec() {
+  // nop
+}
+
+bool rfc7692::codec::init(const parameters& params, bool is_server,
+                          const net::web_socket::deflate_config& cfg) {
+  auto own_bits = params.client_max_window_bits;
+  auto peer_bits = params.server_max_window_bits;
+  impl_->reset_deflater = params.client_no_context_takeover;
+  impl_->reset_inflater = params.server_no_context_takeover;
+  if (is_server) {
+    std::swap(own_bits, peer_bits);
+    std::swap(impl_->reset_deflater, impl_->reset_inflater);
+  }
+  auto bits = deflate_window_bits(own_bits, peer_bits, cfg.max_memory);
+  if (bits == 0)
+    return false;
+  // Negative window sizes select raw DEFLATE streams without zlib header.
+  if (deflateInit2(&impl_->deflater, cfg.level, Z_DEFLATED, -bits, bits - 7,
+                   Z_DEFAULT_STRATEGY)
+      != Z_OK)
+    return false;
+  impl_->has_deflater = true;
+  if (inflateInit2(&impl_->inflater, -peer_bits) != Z_OK)
+    return false;
+  impl_->has_inflater = true;
+  return true;
+}
+
+bool rfc7692::codec::compress(const_byte_span input, byte_buffer& output) {
+  auto& strm = impl_->deflater;
+  auto first = output.size();
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(input.data()));
+  strm.avail_in = static_cast<uInt>(input.size());
+  do {
+    auto offset = output.size();
+    output.resize(offset + zlib_chunk_size);
+    strm.next_out = reinterpret_cast<Bytef*>(output.data() + offset);
+    strm.avail_out = static_cast<uInt>(zlib_chunk_size);
+    auto rc = deflate(&strm, Z_SYNC_FLUSH);
+    output.resize(output.size() - strm.avail_out);
+    if (rc != Z_OK && rc != Z_BUF_ERROR) {
+      output.resize(first);
+      return false;
+    }
+  } while (strm.avail_out == 0);
+  // Strip the trailing empty block (cf. RFC 7692, Section 7.2.1).
+  auto tail = make_span(deflate_tail);
+  if (output.size() - first < tail.size()
+      || !std::equal(tail.begin(), tail.end(), output.end() - 4)) {
+    output.resize(first);
+    return false;
+  }
+  output.resize(output.size() - tail.size());
+  if (impl_->reset_deflater)
+    deflateReset(&strm);
+  return true;
+}
+
+bool rfc7692::codec::decompress(const_byte_span input, byte_buffer& output,
+                                size_t max_size) {
+  // Restore the trailing empty block (cf. RFC 7692, Section 7.2.2).
+  if (!impl_->inflate_all(input, output, max_size))
+    return false;
+  if (output.size() <= max_size
+      && !impl_->inflate_all(make_span(deflate_tail), output, max_size))
+    return false;
+  if (impl_->reset_inflater)
+    inflateReset(&impl_->inflater);
+  return true;
+}
+
+#else // CAF_ENABLE_ZLIB
+
+// Without zlib, we never negotiate the extension and thus never use a codec.
+
+struct rfc7692::codec::impl {};
+
+rfc7692::codec::codec() : impl_(std::make_unique<impl>()) {
+  // nop
+}
+
+rfc7692::codec::~codec() {
+  // nop
+}
+
+bool rfc7692::codec::init(const parameters&, bool,
+                          const net::web_socket::deflate_config&) {
+  return false;
+}
+
+bool rfc7692::codec::compress(const_byte_span, byte_buffer&) {
+  return false;
+}
+
+bool rfc7692::codec::decompress(const_byte_span, byte_buffer&, size_t) {
+  return false;
+}
+
+#endif // CAF_ENABLE_ZLIB
+
+// -- utility functions --------------------------------------------------------
+
+int rfc7692::deflate_window_bits(int limit, int inflate_window_bits,
+                                 size_t max_memory) noexcept {
+  for (auto bits = std::min(limit, max_window_bits);
+       bits >= min_supported_window_bits; --bits)
+    if (deflate_memory(bits) + inflate_memory(inflate_window_bits)
+        <= max_memory)
+      return bits;
+  return 0;
+}
+
+std::string rfc7692::make_offer(const net::web_socket::deflate_config& cfg) {
+  if (!available)
+    return {};
+  auto bits = client_inflate_window_bits(max_window_bits, cfg.max_memory);
+  if (bits == 0)
+    return {};
+  std::string result{extension_name};
+  if (!cfg.server_context_takeover)
+    append(result, "server_no_context_takeover");
+  if (!cfg.client_context_takeover)
+    append(result, "client_no_context_takeover");
+  if (bits < max_window_bits)
+    append(result, "server_max_window_bits", bits);
+  append(result, "client_max_window_bits");
+  return result;
+}
+
+std::optional<rfc7692::parameters>
+rfc7692::accept_offer(std::string_view offers,
+                      const net::web_socket::deflate_config& cfg,
+                      std::string& response) {
+  if (!available)
+    return std::nullopt;
+  std::vector<std::string_view> elements;
+  split(elements, offers, ',');
+  for (auto element : elements) {
+    raw_parameters raw;
+    if (!parse_element(element, raw))
+      continue;
+    parameters result;
+    if (raw.server_max_window_bits) {
+      // We cannot compress with a window size of 8 bits.
+      if (*raw.server_max_window_bits == min_window_bits)
+        continue;
+      result.server_max_window_bits = *raw.server_max_window_bits;
+    }
+    // The server compresses its messages with the largest window that leaves
+    // room for decompressing with the smallest window. The codec picks the
+    // same window size in `init`, since the client window never gets smaller
+    // than the remaining memory allows.
+    auto deflate_bits = deflate_window_bits(result.server_max_window_bits,
+                                            min_supported_window_bits,
+                                            cfg.max_memory);
+    if (deflate_bits == 0)
+      continue;
+    // Clients may only limit the window size for their messages if they have
+    // announced support for it. Otherwise, they use the largest window size.
+    if (raw.has_client_max_window_bits) {
+      auto limit = raw.client_max_window_bits.value_or(max_window_bits);
+      result.client_max_window_bits = inflate_window_bits(limit, deflate_bits,
+                                                          cfg.max_memory);
+    }
+    if (result.client_max_window_bits == 0
+        || deflate_memory(deflate_bits)
+               + inflate_memory(result.client_max_window_bits)
+             > cfg.max_memory)
+      continue;
+    result.server_no_context_takeover = raw.server_no_context_takeover
+                                        || !cfg.server_context_takeover;
+    result.client_no_context_takeover = raw.client_no_context_takeover
+                                        || !cfg.client_context_takeover;
+    response = extension_name;
+    if (result.server_no_context_takeover)
+      append(response, "server_no_context_takeover");
+    if (result.client_no_context_takeover)
+      append(response, "client_no_context_takeover");
+    if (raw.server_max_window_bits)
+      append(response, "server_max_window_bits",
+             result.server_max_window_bits);
+    if (raw.has_client_max_window_bits
+        && (raw.client_max_window_bits
+            || result.client_max_window_bits < max_window_bits))
+      append(response, "client_max_window_bits",
+             result.client_max_window_bits);
+    return result;
+  }
+  return std::nullopt;
+}
+
+expected<rfc7692::parameters>
+rfc7692::accept_response(std::string_view response,
+                         const net::web_socket::deflate_config& cfg) {
+  if (!available)
+    return make_error(sec::protocol_error,
+                      "permessage-deflate requires CAF_ENABLE_ZLIB");
+  raw_parameters raw;
+  if (response.find(',') != std::string_view::npos
+      || !parse_element(response, raw))
+    return make_error(sec::protocol_error,
+                      "invalid Sec-WebSocket-Extensions field in response");
+  // The server must confirm our restrictions for its messages.
+  auto bits = client_inflate_window_bits(max_window_bits, cfg.max_memory);
+  if ((!cfg.server_context_takeover && !raw.server_no_context_takeover)
+      || (bits < max_window_bits
+          && raw.server_max_window_bits.value_or(max_window_bits) > bits))
+    return make_error(sec::protocol_error,
+                      "server ignored permessage-deflate parameters");
+  // The server must pass a value when restricting our window size.
+  if (raw.has_client_max_window_bits && !raw.client_max_window_bits)
+    return make_error(sec::protocol_error,
+                      "client_max_window_bits in response lacks a value");
+  parameters result;
+  result.server_no_context_takeover = raw.server_no_context_takeover;
+  result.client_no_context_takeover = raw.client_no_context_takeover
+                                      || !cfg.client_context_takeover;
+  result.server_max_window_bits = raw.server_max_window_bits.value_or(
+    max_window_bits);
+  result.client_max_window_bits = raw.client_max_window_bits.value_or(
+    max_window_bits);
+  if (deflate_window_bits(result.client_max_window_bits,
+                          result.server_max_window_bits, cfg.max_memory)
+      == 0)
+    return make_error(sec::protocol_error,
+                      "unsupported window size in permessage-deflate response");
+  return result;
+}
+
+} // namespace caf::detail
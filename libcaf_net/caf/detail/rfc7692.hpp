@@ -0,0 +1,138 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/net/fwd.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/byte_span.hpp"
+#include "caf/config.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/expected.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace caf::detail {
+
+/// Implements the permessage-deflate extension for WebSocket as defined in
+/// RFC 7692.
+struct CAF_NET_EXPORT rfc7692 {
+  // -- member types -----------------------------------------------------------
+
+  /// Stores the negotiated extension parameters.
+  struct parameters {
+    bool server_no_context_takeover = false;
+    bool client_no_context_takeover = false;
+    int server_max_window_bits = max_window_bits;
+    int client_max_window_bits = max_window_bits;
+  };
+
+  /// Compresses and decompresses the messages of a single connection.
+  class CAF_NET_EXPORT codec {
+  public:
+    codec();
+
+    codec(const codec&) = delete;
+
+    codec& operator=(const codec&) = delete;
+
+    ~codec();
+
+    /// Initializes the zlib streams for one side of the connection.
+    /// @returns `false` if zlib fails to allocate its state.
+    [[nodiscard]] bool init(const parameters& params, bool is_server,
+                            const net::web_socket::deflate_config& cfg);
+
+    /// Compresses a message and appends the result to `output`.
+    [[nodiscard]] bool compress(const_byte_span input, byte_buffer& output);
+
+    /// Decompresses a message and appends the result to `output`. Stops early
+    /// once `output` exceeds `max_size` bytes.
+    /// @returns `false` if `input` is not a valid DEFLATE stream.
+    [[nodiscard]] bool decompress(const_byte_span input, byte_buffer& output,
+                                  size_t max_size);
+
+  private:
+    struct impl;
+
+    std::unique_ptr<impl> impl_;
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  /// The name of the extension in the `Sec-WebSocket-Extensions` field.
+  static constexpr std::string_view extension_name = "permessage-deflate";
+
+  /// The smallest LZ77 window size allowed by RFC 7692.
+  static constexpr int min_window_bits = 8;
+
+  /// The largest LZ77 window size allowed by RFC 7692.
+  static constexpr int max_window_bits = 15;
+
+  /// Signals whether CAF has been built with zlib. Without zlib, CAF never
+  /// negotiates the extension.
+#ifdef CAF_ENABLE_ZLIB
+  static constexpr bool available = true;
+#else
+  static constexpr bool available = false;
+#endif
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Returns how much memory zlib allocates for compressing with the given
+  /// window size.
+  static constexpr size_t deflate_memory(int window_bits) noexcept {
+    // zlib needs (1 << (windowBits + 2)) + (1 << (memLevel + 9)) bytes and we
+    // always use a memLevel of windowBits - 7.
+    return size_t{1} << (window_bits + 3);
+  }
+
+  /// Returns how much memory zlib allocates for decompressing with the given
+  /// window size.
+  static constexpr size_t inflate_memory(int window_bits) noexcept {
+    return (size_t{1} << window_bits) + 7168;
+  }
+
+  /// Returns how many bytes a compressed message may have at most if it
+  /// decompresses to at most `max_size` bytes. Allows the sender to encode
+  /// every byte with 9 bits, i.e., the longest literal with fixed Huffman
+  /// codes, plus some bytes for block headers.
+  static constexpr size_t max_compressed_size(size_t max_size) noexcept {
+    auto overhead = (max_size >> 3) + 64;
+    return max_size <= SIZE_MAX - overhead ? max_size + overhead : SIZE_MAX;
+  }
+
+  /// Returns the largest window size up to `limit` for compressing messages
+  /// that fits into `max_memory` next to a decompressor for the window size
+  /// `inflate_window_bits`. Returns 0 if no window size fits.
+  static int deflate_window_bits(int limit, int inflate_window_bits,
+                                 size_t max_memory) noexcept;
+
+  /// Generates the value for the `Sec-WebSocket-Extensions` field of a client
+  /// handshake. Returns an empty string if `cfg` leaves not enough memory for
+  /// compressing messages.
+  static std::string make_offer(const net::web_socket::deflate_config& cfg);
+
+  /// Selects the first acceptable offer from the `Sec-WebSocket-Extensions`
+  /// field of a client handshake and stores the value for the server response
+  /// in `response`.
+  static std::optional<parameters>
+  accept_offer(std::string_view offers,
+               const net::web_socket::deflate_config& cfg,
+               std::string& response);
+
+  /// Validates the `Sec-WebSocket-Extensions` field of a server response to
+  /// an offer generated by `make_offer`.
+  static expected<parameters>
+  accept_response(std::string_view response,
+                  const net::web_socket::deflate_config& cfg);
+};
+
+} // namespace caf::detail
@@ -0,0 +1,251 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/detail/rfc7692.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/net/web_socket/deflate_config.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/span.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using namespace caf;
+using namespace std::literals;
+
+using impl = detail::rfc7692;
+
+namespace {
+
+auto bytes(std::string_view str) {
+  auto first = reinterpret_cast<const std::byte*>(str.data());
+  return byte_buffer{first, first + str.size()};
+}
+
+std::string_view to_str(const byte_buffer& buf) {
+  return {reinterpret_cast<const char*>(buf.data()), buf.size()};
+}
+
+struct fixture {
+  net::web_socket::deflate_config cfg;
+
+  // Negotiates the parameters for a client and a server with the same config.
+  impl::parameters negotiate() {
+    std::string response;
+    auto offer = impl::make_offer(cfg);
+    auto params = impl::accept_offer(offer, cfg, response);
+    if (!params)
+      test::runnable::current().fail("server rejected the offer");
+    auto client_params = impl::accept_response(response, cfg);
+    if (!client_params)
+      test::runnable::current().fail("client rejected the response: {}",
+                                     client_params.error());
+    return *params;
+  }
+};
+
+WITH_FIXTURE(fixture) {
+
+#ifdef CAF_ENABLE_ZLIB
+
+TEST("clients offer permessage-deflate with window bits support") {
+  check_eq(impl::make_offer(cfg),
+           "permessage-deflate; client_max_window_bits");
+  SECTION("disabling the context takeover adds the matching parameters") {
+    cfg.server_context_takeover = false;
+    cfg.client_context_takeover = false;
+    check_eq(impl::make_offer(cfg),
+             "permessage-deflate; server_no_context_takeover; "
+             "client_no_context_takeover; client_max_window_bits");
+  }
+  SECTION("limiting the memory restricts the window size of the server") {
+    cfg.max_memory = impl::deflate_memory(9) + impl::inflate_memory(12);
+    check_eq(impl::make_offer(cfg),
+             "permessage-deflate; server_max_window_bits=12; "
+             "client_max_window_bits");
+  }
+  SECTION("clients offer nothing if compression exceeds the memory limit") {
+    cfg.max_memory = 1024;
+    check_eq(impl::make_offer(cfg), "");
+  }
+}
+
+TEST("servers accept the first valid offer") {
+  std::string response;
+  SECTION("servers accept offers without parameters") {
+    auto params = impl::accept_offer("permessage-deflate", cfg, response);
+    require(params.has_value());
+    check_eq(response, "permessage-deflate");
+    check_eq(params->server_max_window_bits, 15);
+    check_eq(params->client_max_window_bits, 15);
+    check(!params->server_no_context_takeover);
+    check(!params->client_no_context_takeover);
+  }
+  SECTION("servers skip unknown extensions and invalid offers") {
+    auto offers = "x-webkit-deflate-frame, "
+                  "permessage-deflate; foo=bar, "
+                  "permessage-deflate; server_max_window_bits=16, "
+                  "permessage-deflate; server_max_window_bits=10"sv;
+    auto params = impl::accept_offer(offers, cfg, response);
+    require(params.has_value());
+    check_eq(response, "permessage-deflate; server_max_window_bits=10");
+    check_eq(params->server_max_window_bits, 10);
+  }
+  SECTION("servers confirm context takeover parameters") {
+    auto offer = "permessage-deflate; server_no_context_takeover"sv;
+    auto params = impl::accept_offer(offer, cfg, response);
+    require(params.has_value());
+    check_eq(response, "permessage-deflate; server_no_context_takeover");
+    check(params->server_no_context_takeover);
+  }
+  SECTION("servers restrict the client window size to fit the memory limit") {
+    cfg.max_memory = impl::deflate_memory(15) + impl::inflate_memory(10);
+    auto offer = "permessage-deflate; client_max_window_bits"sv;
+    auto params = impl::accept_offer(offer, cfg, response);
+    require(params.has_value());
+    check_eq(response, "permessage-deflate; client_max_window_bits=10");
+    check_eq(params->client_max_window_bits, 10);
+  }
+  SECTION("servers reject offers that exceed the memory limit") {
+    cfg.max_memory = impl::deflate_memory(15) + impl::inflate_memory(10);
+    check(!impl::accept_offer("permessage-deflate", cfg, response));
+  }
+  SECTION("servers reject offers with a server window of 8 bits") {
+    auto offer = "permessage-deflate; server_max_window_bits=8"sv;
+    check(!impl::accept_offer(offer, cfg, response));
+  }
+}
+
+TEST("clients validate the response of the server") {
+  check(impl::accept_response("permessage-deflate", cfg).has_value());
+  check(!impl::accept_response("permessage-deflate; foo", cfg));
+  check(!impl::accept_response("x-webkit-deflate-frame", cfg));
+  check(!impl::accept_response("permessage-deflate, permessage-deflate", cfg));
+  check(!impl::accept_response("permessage-deflate; client_max_window_bits",
+                               cfg));
+  SECTION("clients reject responses that ignore their parameters") {
+    cfg.server_context_takeover = false;
+    check(!impl::accept_response("permessage-deflate", cfg));
+  }
+}
+
+TEST("the codec decompresses the example from RFC 7692") {
+  auto params = negotiate();
+  impl::codec uut;
+  require(uut.init(params, false, cfg));
+  // Section 7.2.3.1: a message with "Hello" compressed.
+  auto input = byte_buffer{std::byte{0xf2}, std::byte{0x48}, std::byte{0xcd},
+                           std::byte{0xc9}, std::byte{0xc9}, std::byte{0x07},
+                           std::byte{0x00}};
+  byte_buffer output;
+  require(uut.decompress(input, output, 1024));
+  check_eq(to_str(output), "Hello");
+  SECTION("the codec reuses the context for subsequent messages") {
+    // Section 7.2.3.2: the second "Hello" refers to the first one.
+    input = byte_buffer{std::byte{0xf2}, std::byte{0x00}, std::byte{0x11},
+                        std::byte{0x00}, std::byte{0x00}};
+    output.clear();
+    require(uut.decompress(input, output, 1024));
+    check_eq(to_str(output), "Hello");
+  }
+}
+
+TEST("messages survive a round trip through client and server codecs") {
+  auto text = std::string{};
+  for (int i = 0; i < 100; ++i)
+    text += R"({"id": 42, "name": "sensor", "values": [1, 2, 3]})";
+  auto round_trip = [this, &text] {
+    auto params = negotiate();
+    impl::codec client;
+    impl::codec server;
+    require(client.init(params, false, cfg));
+    require(server.init(params, true, cfg));
+    for (int i = 0; i < 3; ++i) {
+      byte_buffer compressed;
+      byte_buffer output;
+      require(client.compress(bytes(text), compressed));
+      check_lt(compressed.size(), text.size() / 10);
+      require(server.decompress(compressed, output, text.size()));
+      check_eq(to_str(output), text);
+      compressed.clear();
+      output.clear();
+      require(server.compress(bytes(text), compressed));
+      require(client.decompress(compressed, output, text.size()));
+      check_eq(to_str(output), text);
+    }
+  };
+  SECTION("with context takeover") {
+    round_trip();
+  }
+  SECTION("without context takeover") {
+    cfg.server_context_takeover = false;
+    cfg.client_context_takeover = false;
+    round_trip();
+  }
+  SECTION("with restricted window sizes") {
+    cfg.max_memory = impl::deflate_memory(9) + impl::inflate_memory(9);
+    round_trip();
+  }
+}
+
+TEST("the codec stops decompressing after exceeding the maximum size") {
+  auto params = negotiate();
+  impl::codec client;
+  impl::codec server;
+  require(client.init(params, false, cfg));
+  require(server.init(params, true, cfg));
+  byte_buffer compressed;
+  byte_buffer output;
+  require(client.compress(byte_buffer(1024 * 1024), compressed));
+  require(server.decompress(compressed, output, 1024));
+  check_gt(output.size(), 1024u);
+  check_lt(output.size(), 1024u * 1024u);
+}
+
+TEST("the codec rejects invalid input") {
+  auto params = negotiate();
+  impl::codec uut;
+  require(uut.init(params, true, cfg));
+  byte_buffer output;
+  check(!uut.decompress(bytes("\xff\xff\xff\xff"), output, 1024));
+}
+
+TEST("incompressible messages stay within the maximum compressed size") {
+  auto params = negotiate();
+  impl::codec uut;
+  require(uut.init(params, false, cfg));
+  for (auto n : {size_t{0}, size_t{1}, size_t{1024}, size_t{1024 * 1024}}) {
+    // Generates pseudo-random bytes with a linear congruential generator.
+    auto input = byte_buffer(n);
+    auto state = uint32_t{42};
+    for (auto& x : input) {
+      state = state * 1103515245u + 12345u;
+      x = static_cast<std::byte>(state >> 24);
+    }
+    byte_buffer compressed;
+    require(uut.compress(input, compressed));
+    check_le(compressed.size(), impl::max_compressed_size(n));
+  }
+}
+
+#else // CAF_ENABLE_ZLIB
+
+TEST("the extension is unavailable without zlib") {
+  std::string response;
+  check(impl::make_offer(cfg).empty());
+  check(!impl::accept_offer("permessage-deflate", cfg, response));
+  check(!impl::accept_response("permessage-deflate", cfg));
+  impl::codec uut;
+  check(!uut.init(impl::parameters{}, true, cfg));
+}
+
+#endif // CAF_ENABLE_ZLIB
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
@@ -20,12 +20,13 @@
 namespace caf::internal {
 
 /// Translates between a message-oriented transport and data flows.
-template <class UpperLayer, class LowerLayer, class ItemType>
+template <class UpperLayer, class LowerLayer, class ItemType,
+          class OutputType = ItemType>
 class flow_bridge_base : public UpperLayer {
 public:
   using input_type = ItemType;
 
-  using output_type = ItemType;
+  using output_type = OutputType;
 
   /// Type for the consumer adapter. We consume the output of the application.
   using consumer_type = async::consumer_adapter<output_type>;
@@ -81,7 +82,7 @@ public:
   // -- implementation of the lower_layer --------------------------------------
 
   void prepare_send() override {
-    input_type tmp;
+    output_type tmp;
     while (down_->can_send_more()) {
       switch (in_.pull(async::delay_errors, tmp)) {
         case async::read_result::ok:
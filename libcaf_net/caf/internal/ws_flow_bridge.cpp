@@ -7,6 +7,7 @@
 #include "caf/net/socket_manager.hpp"
 #include "caf/net/web_socket/frame.hpp"
 #include "caf/net/web_socket/lower_layer.hpp"
+#include "caf/net/web_socket/message_chunk.hpp"
 #include "caf/net/web_socket/upper_layer.hpp"
 
 #include "caf/async/consumer_adapter.hpp"
@@ -18,6 +19,23 @@ namespace caf::net::web_socket {
 
 namespace {
 
+/// Writes `item` as a single message to `down`.
+bool write_frame(lower_layer* down, const frame& item) {
+  if (item.is_binary()) {
+    down->begin_binary_message();
+    auto& bytes = down->binary_message_buffer();
+    auto src = item.as_binary();
+    bytes.insert(bytes.end(), src.begin(), src.end());
+    return down->end_binary_message();
+  } else {
+    down->begin_text_message();
+    auto& text = down->text_message_buffer();
+    auto src = item.as_text();
+    text.insert(text.end(), src.begin(), src.end());
+    return down->end_text_message();
+  }
+}
+
 /// Convenience alias for referring to the base type of @ref flow_bridge.
 template <class Base>
 using flow_bridge_base_t
@@ -33,19 +51,7 @@ public:
   using super::super;
 
   bool write(const frame& item) override {
-    if (item.is_binary()) {
-      super::down_->begin_binary_message();
-      auto& bytes = super::down_->binary_message_buffer();
-      auto src = item.as_binary();
-      bytes.insert(bytes.end(), src.begin(), src.end());
-      return super::down_->end_binary_message();
-    } else {
-      super::down_->begin_text_message();
-      auto& text = super::down_->text_message_buffer();
-      auto src = item.as_text();
-      text.insert(text.end(), src.begin(), src.end());
-      return super::down_->end_text_message();
-    }
+    return write_frame(super::down_, item);
   }
 
   // -- implementation of web_socket::lower_layer ------------------------------
@@ -91,6 +97,70 @@ private:
   push_t push_;
 };
 
+/// Translates between a message-oriented transport and data flows. Passes
+/// received messages to the application in chunks as they arrive. The last
+/// chunk of each message has the final flag set.
+class chunk_flow_bridge
+  : public internal::flow_bridge_base<upper_layer, lower_layer, message_chunk,
+                                      frame> {
+public:
+  using super = internal::flow_bridge_base<upper_layer, lower_layer,
+                                           message_chunk, frame>;
+
+  using pull_t = async::consumer_resource<frame>;
+
+  using push_t = async::producer_resource<message_chunk>;
+
+  chunk_flow_bridge(pull_t pull, push_t push)
+    : pull_(std::move(pull)), push_(std::move(push)) {
+    // nop
+  }
+
+  error start(lower_layer* down_ptr) override {
+    CAF_ASSERT(down_ptr != nullptr);
+    super::down_ = down_ptr;
+    return super::init(&down_ptr->mpx(), std::move(pull_), std::move(push_));
+  }
+
+  bool write(const frame& item) override {
+    return write_frame(super::down_, item);
+  }
+
+  // -- implementation of web_socket::upper_layer ------------------------------
+
+  bool consumes_chunks() const noexcept override {
+    return true;
+  }
+
+  ptrdiff_t consume_binary(byte_span buf) override {
+    return consume_binary_chunk(buf, true);
+  }
+
+  ptrdiff_t consume_text(std::string_view buf) override {
+    return consume_text_chunk(buf, true);
+  }
+
+  ptrdiff_t consume_binary_chunk(byte_span buf, bool final) override {
+    return push(message_chunk{frame{buf}, final});
+  }
+
+  ptrdiff_t consume_text_chunk(std::string_view buf, bool final) override {
+    return push(message_chunk{frame{buf}, final});
+  }
+
+private:
+  ptrdiff_t push(const message_chunk& item) {
+    if (!super::out_)
+      return -1;
+    if (super::out_.push(item) == 0)
+      super::down_->suspend_reading();
+    return static_cast<ptrdiff_t>(item.size());
+  }
+
+  pull_t pull_;
+  push_t push_;
+};
+
 /// Specializes the WebSocket flow bridge for the server side.
 class flow_bridge_acceptor : public flow_bridge<upper_layer::server> {
 public:
@@ -154,6 +224,13 @@ make_ws_flow_bridge(async::consumer_resource<net::web_socket::frame> pull,
   return std::make_unique<impl_t>(std::move(pull), std::move(push));
 }
 
+std::unique_ptr<net::web_socket::upper_layer> make_ws_chunk_flow_bridge(
+  async::consumer_resource<net::web_socket::frame> pull,
+  async::producer_resource<net::web_socket::message_chunk> push) {
+  using impl_t = net::web_socket::chunk_flow_bridge;
+  return std::make_unique<impl_t>(std::move(pull), std::move(push));
+}
+
 std::unique_ptr<net::web_socket::upper_layer::server>
 make_ws_flow_bridge(detail::ws_conn_acceptor_ptr wca) {
   using impl_t = net::web_socket::flow_bridge_acceptor;
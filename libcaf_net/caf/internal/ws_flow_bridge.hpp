@@ -19,6 +19,13 @@ std::unique_ptr<net::web_socket::upper_layer>
 make_ws_flow_bridge(async::consumer_resource<net::web_socket::frame> pull,
                     async::producer_resource<net::web_socket::frame> push);
 
+/// Creates a flow bridge that passes received messages to the application in
+/// chunks as they arrive instead of reassembling them first. The last chunk of
+/// each message has the final flag set.
+std::unique_ptr<net::web_socket::upper_layer> make_ws_chunk_flow_bridge(
+  async::consumer_resource<net::web_socket::frame> pull,
+  async::producer_resource<net::web_socket::message_chunk> push);
+
 std::unique_ptr<net::web_socket::upper_layer::server>
 make_ws_flow_bridge(detail::ws_conn_acceptor_ptr wca);
 
@@ -19,7 +19,8 @@
 #include "caf/mixin/requester.hpp"
 #include "caf/mixin/sender.hpp"
 #include "caf/none.hpp"
-#include "caf/unordered_flat_map.hpp"
+
+#include <unordered_map>
 
 namespace caf::net {
 
@@ -140,7 +141,7 @@ private:
   fallback_handler fallback_;
 
   /// Stores callbacks for multiplexed responses.
-  unordered_flat_map<message_id, multiplexed_response> multiplexed_responses_;
+  std::unordered_map<message_id, multiplexed_response> multiplexed_responses_;
 
   /// Callback for processing the next message on the event loop.
   action resume_;
@@ -94,7 +94,7 @@ protected:
           return res_t{maybe_ctx.error()};
         ctx = std::make_shared<ssl::context>(std::move(*maybe_ctx));
       }
-      auto conn = ctx->new_connection(std::forward<fd_t>(fd));
+      auto conn = new_ssl_connection(*ctx, fd);
       if (!conn)
         return res_t{conn.error()};
       return fn(std::move(*conn));
@@ -112,7 +112,7 @@ protected:
         if (!maybe_ctx)
           return res_t{maybe_ctx.error()};
         auto& ctx = *maybe_ctx;
-        auto conn = ctx->new_connection(std::forward<fd_t>(fd));
+        auto conn = new_ssl_connection(*ctx, fd);
         if (!conn)
           return res_t{conn.error()};
         return fn(std::move(*conn));
@@ -133,6 +133,19 @@ protected:
     };
   }
 
+  /// Creates a new SSL connection on `fd`, passing the server address to the
+  /// context if known for enabling SNI and session resumption.
+  expected<ssl::connection> new_ssl_connection(ssl::context& ctx,
+                                               stream_socket fd) {
+    auto* lazy = std::get_if<client_config::lazy>(&base_config().data);
+    if (lazy == nullptr)
+      return ctx.new_connection(fd);
+    if (auto* addr = std::get_if<server_address>(&lazy->server))
+      return ctx.new_connection(fd, addr->host, addr->port);
+    auto& auth = std::get<uri>(lazy->server).authority();
+    return ctx.new_connection(fd, auth.host_str(), auth.port);
+  }
+
   virtual client_config_value& base_config() = 0;
 };
 
@@ -35,6 +35,7 @@ class multiplexer;
 class socket_event_layer;
 class socket_manager;
 class this_host;
+class udp_datagram_batch;
 
 // -- structs ------------------------------------------------------------------
 
@@ -103,6 +104,8 @@ class lower_layer;
 class server;
 class upper_layer;
 
+struct write_config;
+
 using frame = caf::chunk;
 
 } // namespace caf::net::lp
@@ -114,15 +117,19 @@ class frame;
 class framing;
 class has_on_request;
 class lower_layer;
+class message_chunk;
 class server;
 class upper_layer;
 
+struct deflate_config;
+
 enum class status : uint16_t;
 
 } // namespace caf::net::web_socket
 
 namespace caf::net::http {
 
+class connection_pool;
 class header;
 class lower_layer;
 class request;
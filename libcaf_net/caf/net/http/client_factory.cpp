@@ -4,7 +4,9 @@
 
 #include "caf/net/http/client_factory.hpp"
 
+#include "caf/net/http/connection_pool.hpp"
 #include "caf/net/http/method.hpp"
+#include "caf/net/middleman.hpp"
 #include "caf/net/multiplexer.hpp"
 #include "caf/net/socket_manager.hpp"
 
@@ -23,6 +25,8 @@ public:
   std::string path;
 
   caf::unordered_flat_map<std::string, std::string> fields;
+
+  bool keep_alive = false;
 };
 
 client_factory::client_factory(client_factory&& other) noexcept {
@@ -54,6 +58,11 @@ client_factory& client_factory::add_header_field(std::string key,
   return *this;
 }
 
+client_factory& client_factory::keep_alive(bool value) {
+  config_->keep_alive = value;
+  return *this;
+}
+
 expected<std::pair<async::future<response>, disposable>> client_factory::get() {
   return request(http::method::get);
 }
@@ -103,6 +112,8 @@ client_factory::request(http::method method, const_byte_span payload) {
   const auto& resource = std::get<uri>(data.server);
   config_->path = resource.path_query_fragment();
   config_->fields.emplace("Host"s, resource.authority().host_str());
+  if (config_->keep_alive)
+    config_->fields.emplace("Connection"s, "keep-alive"s);
   return do_start(data, method, payload);
 }
 
@@ -111,22 +122,78 @@ client_factory::request(http::method method, std::string_view payload) {
   return request(method, as_bytes(make_span(payload)));
 }
 
+template <typename Conn>
+socket_manager_ptr
+client_factory::make_manager(multiplexer* mpx, Conn conn,
+                             std::unique_ptr<upper_layer::client> app) {
+  using transport_t = typename Conn::transport_type;
+  auto http_client = http::client::make(std::move(app));
+  auto transport = transport_t::make(std::move(conn), std::move(http_client));
+  transport->active_policy().connect();
+  return net::socket_manager::make(mpx, std::move(transport));
+}
+
 template <typename Conn>
 expected<std::pair<async::future<response>, disposable>>
 client_factory::do_start_impl(Conn conn, http::method method,
                               const_byte_span payload) {
-  using transport_t = typename Conn::transport_type;
   auto app_t = async_client::make(method, config_->path, config_->fields,
                                   payload);
   auto ret = app_t->get_future();
-  auto http_client = http::client::make(std::move(app_t));
-  auto transport = transport_t::make(std::move(conn), std::move(http_client));
-  transport->active_policy().connect();
-  auto ptr = net::socket_manager::make(config_->mpx, std::move(transport));
+  auto ptr = make_manager(config_->mpx, std::move(conn), std::move(app_t));
   config_->mpx->start(ptr);
   return std::pair{std::move(ret), disposable{std::move(ptr)}};
 }
 
+client_factory::return_t
+client_factory::do_start_pooled(dsl::client_config::lazy& data,
+                                const uri::authority_type& auth, bool use_ssl,
+                                http::method method, const_byte_span payload) {
+  // Connections with a user-defined SSL context may only be re-used for
+  // requests with the same context.
+  std::shared_ptr<ssl::context> ctx;
+  if (use_ssl) {
+    if (auto* sub = config_->as_has_make_ctx(); sub && sub->make_ctx) {
+      auto maybe_ctx = sub->make_ctx();
+      if (!maybe_ctx)
+        return do_start(std::move(maybe_ctx.error()));
+      ctx = std::move(*maybe_ctx);
+    }
+  }
+  connection_pool::endpoint key{auth.host_str(), auth.port, use_ssl, ctx};
+  connection_pool::request_data req{method, config_->path, config_->fields,
+                                    byte_buffer{payload.begin(),
+                                                payload.end()}};
+  // Note: the pool may call this function again later for retrying the
+  //       request. Hence, the function may not refer to this factory.
+  auto connect = make_shared_type_erased_callback(
+    [mpx = config_->mpx, auth, use_ssl, ctx,
+     timeout = data.connection_timeout, retries = data.max_retry_count,
+     delay = data.retry_delay](connection_pool::upper_layer_ptr app) mutable
+    -> expected<socket_manager_ptr> {
+      auto fd = detail::tcp_try_connect(auth, timeout, retries, delay);
+      if (!fd)
+        return fd.error();
+      if (!use_ssl)
+        return make_manager(mpx, *fd, std::move(app));
+      if (!ctx) {
+        auto maybe_ctx = ssl::context::make_client(ssl::tls::v1_2);
+        if (!maybe_ctx)
+          return maybe_ctx.error();
+        ctx = std::make_shared<ssl::context>(std::move(*maybe_ctx));
+      }
+      auto conn = ctx->new_connection(*fd, auth.host_str(), auth.port);
+      if (!conn)
+        return conn.error();
+      return make_manager(mpx, std::move(*conn), std::move(app));
+    });
+  auto& pool = config_->mpx->owner().http_client_pool();
+  auto result = pool.request(key, std::move(req), std::move(connect));
+  if (!result)
+    return do_start(std::move(result.error()));
+  return result;
+}
+
 expected<std::pair<async::future<response>, disposable>>
 client_factory::do_start(dsl::client_config::lazy& data, http::method method,
                          const_byte_span payload) {
@@ -151,6 +218,8 @@ client_factory::do_start(dsl::client_config::lazy& data, http::method method,
                           "unsupported URI scheme: expected http or https");
     return return_t{std::move(err)};
   }
+  if (config_->keep_alive)
+    return do_start_pooled(data, auth, use_ssl, method, payload);
   return detail::tcp_try_connect(auth, data.connection_timeout,
                                  data.max_retry_count, data.retry_delay)
     .and_then(this->with_ssl_connection_or_socket_select(
@@ -50,6 +50,14 @@ public:
   /// Add an additional HTTP header field to the request.
   client_factory& add_header_field(std::string key, std::string value);
 
+  /// Configures whether the client re-uses connections from the connection
+  /// pool of the middleman. When enabled, the client sends requests with
+  /// `Connection: keep-alive` and returns the connection to the pool after
+  /// receiving the response. Disposing the handle returned by the request
+  /// functions then only discards the response instead of closing the
+  /// connection.
+  client_factory& keep_alive(bool value = true);
+
   /// Sends an HTTP GET message.
   expected<std::pair<async::future<response>, disposable>> get();
 
@@ -96,10 +104,19 @@ private:
 
   dsl::client_config_value& init_config(multiplexer* mpx);
 
+  template <typename Conn>
+  static socket_manager_ptr
+  make_manager(multiplexer* mpx, Conn conn,
+               std::unique_ptr<upper_layer::client> app);
+
   template <typename Conn>
   return_t
   do_start_impl(Conn conn, http::method method, const_byte_span payload);
 
+  return_t do_start_pooled(dsl::client_config::lazy& data,
+                           const uri::authority_type& auth, bool use_ssl,
+                           http::method method, const_byte_span payload);
+
   return_t do_start(dsl::client_config::lazy& data, http::method method,
                     const_byte_span payload);
 
@@ -0,0 +1,484 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/http/connection_pool.hpp"
+
+#include "caf/net/http/lower_layer.hpp"
+#include "caf/net/http/response.hpp"
+#include "caf/net/http/response_header.hpp"
+#include "caf/net/multiplexer.hpp"
+
+#include "caf/action.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/async/promise.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/atomic_ref_counted.hpp"
+#include "caf/log/net.hpp"
+#include "caf/scheduler.hpp"
+#include "caf/sec.hpp"
+#include "caf/settings.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+namespace caf::net::http {
+
+namespace {
+
+class pooled_client;
+
+/// Checks whether clients may safely send a request with method `x` again
+/// after losing the connection without receiving a response (RFC 9110,
+/// section 9.2.2).
+bool is_idempotent(http::method x) noexcept {
+  switch (x) {
+    case http::method::get:
+    case http::method::head:
+    case http::method::put:
+    case http::method::del:
+    case http::method::options:
+    case http::method::trace:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+// -- pending requests ---------------------------------------------------------
+
+struct connection_pool::pending_request {
+  request_data data;
+  async::promise<response> promise;
+
+  /// Allows users to cancel the request. Disposing the token discards the
+  /// response but does not affect other requests on the same connection.
+  action token;
+
+  /// Establishes a fresh connection for retrying the request. Only set for
+  /// idempotent requests that the pool sends over a re-used connection.
+  connect_fn_ptr retry;
+};
+
+// -- connection state ---------------------------------------------------------
+
+class connection_pool::connection : public detail::atomic_ref_counted {
+public:
+  explicit connection(endpoint key) : key(std::move(key)) {
+    // nop
+  }
+
+  /// The endpoint of this connection.
+  const endpoint key;
+
+  /// The manager for the socket. Guarded by the mutex of the pool. Set to
+  /// `nullptr` when the pool closes the connection.
+  socket_manager_ptr mgr;
+
+  /// Number of requests that await a response. Guarded by the mutex of the
+  /// pool.
+  size_t in_flight = 0;
+
+  /// Stores whether the pool closed this connection. Guarded by the mutex of
+  /// the pool.
+  bool closed = false;
+
+  /// Points to the HTTP application. Only accessed from the multiplexer.
+  pooled_client* app = nullptr;
+
+  CAF_INTRUSIVE_PTR_FRIENDS(connection)
+};
+
+namespace {
+
+/// HTTP client application that sends any number of requests over a single
+/// connection and matches responses to requests by their order.
+class pooled_client : public upper_layer::client {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  using pending_request = connection_pool::pending_request;
+
+  pooled_client(connection_pool* pool, connection_pool::connection_ptr conn,
+                pending_request first)
+    : pool_(pool), conn_(std::move(conn)) {
+    queue_.push_back(std::move(first));
+  }
+
+  ~pooled_client() override {
+    conn_->app = nullptr;
+    idle_timer_.dispose();
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Sends `req` and appends it to the queue of pending requests.
+  void submit(pending_request req) {
+    if (closing_) {
+      pool_->retry_or_fail(down_->manager()->mpx().system(), conn_->key,
+                           std::move(req), make_error(sec::connection_closed));
+      return;
+    }
+    idle_timer_.dispose();
+    send_request(req.data);
+    queue_.push_back(std::move(req));
+  }
+
+  // -- generic lower layer implementation -------------------------------------
+
+  void prepare_send() override {
+    // nop
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+  void abort(const error& reason) override {
+    closing_ = true;
+    pool_->close(conn_.get());
+    retry_or_fail_all(reason);
+  }
+
+  // -- http::upper_layer::client implementation -------------------------------
+
+  error start(lower_layer::client* down) override {
+    down_ = down;
+    conn_->app = this;
+    for (auto& req : queue_)
+      send_request(req.data);
+    down_->request_messages();
+    return none;
+  }
+
+  ptrdiff_t consume(const response_header& hdr,
+                    const_byte_span payload) override {
+    if (queue_.empty()) {
+      log::net::error("received a response without pending request");
+      return -1;
+    }
+    auto req = std::move(queue_.front());
+    queue_.pop_front();
+    // Update the state of the pool before delivering the response to make sure
+    // that the next request from the same thread observes the new state.
+    auto keep_alive = hdr.keep_alive();
+    if (!keep_alive) {
+      // The server closes the connection after this response.
+      closing_ = true;
+      pool_->close(conn_.get());
+    } else if (pool_->release(conn_.get())) {
+      // The connection became idle: close it unless it receives another
+      // request before reaching the timeout.
+      auto now = std::chrono::steady_clock::now();
+      auto evict = make_action([pool = pool_, conn = conn_] { //
+        pool->evict(conn.get());
+      });
+      idle_timer_ = down_->manager()->delay_until(now + pool_->max_idle_time(),
+                                                  std::move(evict));
+    }
+    if (req.token.disposed()) {
+      req.promise.set_error(make_error(sec::disposed));
+    } else {
+      response::fields_map fields;
+      hdr.for_each_field([&fields](auto key, auto value) {
+        fields.container().emplace_back(key, value);
+      });
+      req.promise.set_value(response{static_cast<status>(hdr.status()),
+                                     std::move(fields),
+                                     byte_buffer{payload.begin(),
+                                                 payload.end()}});
+    }
+    if (!keep_alive) {
+      retry_or_fail_all(make_error(sec::connection_closed));
+      down_->shutdown();
+    }
+    return static_cast<ptrdiff_t>(payload.size());
+  }
+
+private:
+  void send_request(const connection_pool::request_data& req) {
+    down_->begin_header(req.method, req.path);
+    for (const auto& [key, value] : req.fields)
+      down_->add_header_field(key, value);
+    if (!req.payload.empty())
+      down_->add_header_field("Content-Length",
+                              std::to_string(req.payload.size()));
+    down_->end_header();
+    if (!req.payload.empty())
+      down_->send_payload(req.payload);
+  }
+
+  /// Retries or fails all requests that did not receive a response.
+  void retry_or_fail_all(const error& reason) {
+    auto pending = std::move(queue_);
+    queue_.clear();
+    if (pending.empty())
+      return;
+    auto& sys = down_->manager()->mpx().system();
+    for (auto& req : pending)
+      pool_->retry_or_fail(sys, conn_->key, std::move(req), reason);
+  }
+
+  connection_pool* pool_;
+
+  connection_pool::connection_ptr conn_;
+
+  lower_layer::client* down_ = nullptr;
+
+  /// Requests in the order we have sent them.
+  std::deque<pending_request> queue_;
+
+  /// Closes the connection after it remained idle for too long.
+  disposable idle_timer_;
+
+  /// Stores whether the connection shuts down and thus may not carry any
+  /// additional request.
+  bool closing_ = false;
+};
+
+} // namespace
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+connection_pool::connection_pool(actor_system& sys)
+  : connection_pool(
+    get_or(sys.config(), "caf.net.http-client.max-pipelined-requests",
+           defaults::net::http_client_max_pipelined_requests),
+    get_or(sys.config(), "caf.net.http-client.max-idle-time",
+           defaults::net::http_client_max_idle_time),
+    get_or(sys.config(), "caf.net.http-client.max-idle-connections",
+           defaults::net::http_client_max_idle_connections)) {
+  auto& reg = sys.metrics();
+  metrics_.connections = reg.gauge_singleton(
+    "caf.net", "http-client-connections",
+    "Number of connections in the HTTP client connection pool.");
+  metrics_.idle_connections = reg.gauge_singleton(
+    "caf.net", "http-client-idle-connections",
+    "Number of pooled HTTP client connections without pending requests.");
+  metrics_.reused_connections = reg.counter_singleton(
+    "caf.net", "http-client-reused-connections",
+    "Number of HTTP requests that re-used a pooled connection.", "1", true);
+  metrics_.evicted_connections = reg.counter_singleton(
+    "caf.net", "http-client-evicted-connections",
+    "Number of idle HTTP client connections closed by the pool.", "1", true);
+}
+
+connection_pool::connection_pool(size_t max_pipelined_requests,
+                                 timespan max_idle_time,
+                                 size_t max_idle_connections,
+                                 metrics_t metrics)
+  : max_pipelined_requests_(std::max(max_pipelined_requests, size_t{1})),
+    max_idle_time_(max_idle_time),
+    max_idle_connections_(max_idle_connections),
+    metrics_(metrics) {
+  // nop
+}
+
+connection_pool::~connection_pool() {
+  // nop
+}
+
+// -- properties ---------------------------------------------------------------
+
+size_t connection_pool::num_connections() const {
+  std::unique_lock guard{mtx_};
+  size_t result = 0;
+  for (auto& kvp : connections_)
+    result += kvp.second.size();
+  return result;
+}
+
+size_t connection_pool::num_idle_connections() const {
+  std::unique_lock guard{mtx_};
+  size_t result = 0;
+  for (auto& kvp : connections_)
+    for (auto& conn : kvp.second)
+      if (conn->in_flight == 0)
+        ++result;
+  return result;
+}
+
+// -- sending of requests ------------------------------------------------------
+
+connection_pool::result_type
+connection_pool::request(const endpoint& key, request_data req,
+                         connect_fn_ptr connect) {
+  pending_request pending{std::move(req), async::promise<response>{},
+                          make_action([] {}), nullptr};
+  auto result = std::pair{pending.promise.get_future(),
+                          pending.token.as_disposable()};
+  // Fast path: send the request over an existing connection.
+  if (auto conn = checkout(key)) {
+    log::net::debug("re-use pooled connection to {}:{}", key.host, key.port);
+    // The server may have closed the connection already.
+    if (is_idempotent(pending.data.method))
+      pending.retry = std::move(connect);
+    auto mgr = conn->mgr;
+    mgr->schedule_fn([this, conn, mgr, req = std::move(pending)]() mutable {
+      if (conn->app != nullptr) {
+        conn->app->submit(std::move(req));
+        return;
+      }
+      // The connection closed in the meantime.
+      retry_or_fail(mgr->mpx().system(), conn->key, std::move(req),
+                    make_error(sec::connection_closed));
+    });
+    return result;
+  }
+  // Slow path: establish a new connection.
+  if (auto err = connect_and_send(key, std::move(pending), *connect))
+    return result_type{std::move(err)};
+  return result;
+}
+
+// -- callbacks for connections ------------------------------------------------
+
+bool connection_pool::release(connection* conn) {
+  socket_manager_ptr mgr;
+  { // Lifetime scope of guard.
+    std::unique_lock guard{mtx_};
+    if (conn->closed)
+      return false;
+    if (--conn->in_flight > 0)
+      return false;
+    auto& conns = connections_[conn->key];
+    auto idle = std::count_if(conns.begin(), conns.end(),
+                              [](const connection_ptr& x) {
+                                return x->in_flight == 0;
+                              });
+    if (static_cast<size_t>(idle) <= max_idle_connections_) {
+      if (metrics_.idle_connections)
+        metrics_.idle_connections->inc();
+      return true;
+    }
+    if (metrics_.evicted_connections)
+      metrics_.evicted_connections->inc();
+    mgr = close_locked(conn);
+  }
+  // Note: we never reach this point with an empty manager, because the pool
+  //       only closes connections once.
+  mgr->dispose();
+  return false;
+}
+
+void connection_pool::close(connection* conn) {
+  // Make sure to release the manager outside of the critical section.
+  socket_manager_ptr mgr;
+  std::unique_lock guard{mtx_};
+  if (conn->closed)
+    return;
+  if (conn->in_flight == 0 && metrics_.idle_connections)
+    metrics_.idle_connections->dec();
+  mgr = close_locked(conn);
+}
+
+void connection_pool::evict(connection* conn) {
+  socket_manager_ptr mgr;
+  { // Lifetime scope of guard.
+    std::unique_lock guard{mtx_};
+    if (conn->closed || conn->in_flight > 0)
+      return;
+    log::net::debug("evict idle connection to {}:{}", conn->key.host,
+                    conn->key.port);
+    if (metrics_.idle_connections)
+      metrics_.idle_connections->dec();
+    if (metrics_.evicted_connections)
+      metrics_.evicted_connections->inc();
+    mgr = close_locked(conn);
+  }
+  mgr->dispose();
+}
+
+void connection_pool::retry_or_fail(actor_system& sys, const endpoint& key,
+                                    pending_request req, const error& reason) {
+  if (req.retry == nullptr || req.token.disposed()) {
+    req.promise.set_error(reason);
+    return;
+  }
+  log::net::debug("retry request to {}:{} on a new connection", key.host,
+                  key.port);
+  // Establishing a connection blocks, so we must not run it in the
+  // multiplexer. Clearing `retry` makes sure that we retry only once.
+  auto connect = std::move(req.retry);
+  req.retry = nullptr;
+  auto fn = make_single_shot_action(
+    [this, key, connect, req = std::move(req)]() mutable {
+      auto promise = req.promise;
+      if (auto err = connect_and_send(key, std::move(req), *connect))
+        promise.set_error(std::move(err));
+    });
+  auto* ptr = fn.ptr();
+  ptr->ref_resumable();
+  sys.scheduler().schedule(ptr);
+}
+
+connection_pool::connection_ptr
+connection_pool::checkout(const endpoint& key) {
+  std::unique_lock guard{mtx_};
+  auto i = connections_.find(key);
+  if (i == connections_.end())
+    return nullptr;
+  // Pick the connection with the least amount of pending requests.
+  connection* best = nullptr;
+  for (auto& conn : i->second) {
+    if (conn->in_flight < max_pipelined_requests_
+        && (best == nullptr || conn->in_flight < best->in_flight))
+      best = conn.get();
+  }
+  if (best == nullptr)
+    return nullptr;
+  if (best->in_flight++ == 0 && metrics_.idle_connections)
+    metrics_.idle_connections->dec();
+  if (metrics_.reused_connections)
+    metrics_.reused_connections->inc();
+  return connection_ptr{best};
+}
+
+error connection_pool::connect_and_send(const endpoint& key,
+                                        pending_request req,
+                                        connect_fn& connect) {
+  auto conn = make_counted<connection>(key);
+  conn->in_flight = 1;
+  auto app = std::make_unique<pooled_client>(this, conn, std::move(req));
+  auto mgr = connect(std::move(app));
+  if (!mgr)
+    return std::move(mgr.error());
+  {
+    std::unique_lock guard{mtx_};
+    conn->mgr = *mgr;
+    connections_[key].push_back(conn);
+    if (metrics_.connections)
+      metrics_.connections->inc();
+  }
+  (*mgr)->mpx().start(*mgr);
+  return {};
+}
+
+socket_manager_ptr connection_pool::close_locked(connection* conn) {
+  // Note: the connection may get destroyed when removing it from the list.
+  auto result = std::move(conn->mgr);
+  auto key = conn->key;
+  conn->closed = true;
+  if (auto i = connections_.find(key); i != connections_.end()) {
+    auto& conns = i->second;
+    auto j = std::find_if(conns.begin(), conns.end(),
+                          [conn](const connection_ptr& x) {
+                            return x.get() == conn;
+                          });
+    if (j != conns.end()) {
+      conns.erase(j);
+      if (metrics_.connections)
+        metrics_.connections->dec();
+    }
+    if (conns.empty())
+      connections_.erase(i);
+  }
+  return result;
+}
+
+} // namespace caf::net::http
@@ -0,0 +1,211 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/net/fwd.hpp"
+#include "caf/net/http/method.hpp"
+#include "caf/net/http/upper_layer.hpp"
+#include "caf/net/socket_manager.hpp"
+
+#include "caf/async/future.hpp"
+#include "caf/byte_buffer.hpp"
+#include "caf/callback.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/disposable.hpp"
+#include "caf/expected.hpp"
+#include "caf/hash/fnv.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/int_gauge.hpp"
+#include "caf/timespan.hpp"
+#include "caf/unordered_flat_map.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace caf::net::http {
+
+/// Keeps HTTP client connections open for re-use by subsequent requests.
+/// Connections are grouped by host, port and SSL context. Each connection
+/// carries up to `max_pipelined_requests` requests at a time and closes after
+/// remaining idle for `max_idle_time`. Idempotent requests that fail on a
+/// re-used connection, e.g., because the server has closed it in the meantime,
+/// are sent once more over a fresh connection.
+/// @note The @ref middleman owns the connection pool for its actor system. All
+///       member functions are thread-safe.
+class CAF_NET_EXPORT connection_pool {
+public:
+  // -- member types -----------------------------------------------------------
+
+  class connection;
+
+  using connection_ptr = intrusive_ptr<connection>;
+
+  /// Identifies a remote endpoint.
+  struct endpoint {
+    /// The name or IP address of the server.
+    std::string host;
+
+    /// The TCP port of the server.
+    uint16_t port = 0;
+
+    /// Stores whether the connection uses SSL.
+    bool use_ssl = false;
+
+    /// Points to the user-defined SSL context or is `nullptr` when using the
+    /// default context. Sharing ownership of the context makes sure that a
+    /// new context never re-uses the address of a destroyed one.
+    std::shared_ptr<ssl::context> ctx;
+
+    friend bool operator==(const endpoint& x, const endpoint& y) noexcept {
+      return x.host == y.host && x.port == y.port && x.use_ssl == y.use_ssl
+             && x.ctx == y.ctx;
+    }
+  };
+
+  /// Computes a hash value for an endpoint.
+  struct endpoint_hash {
+    size_t operator()(const endpoint& x) const noexcept {
+      auto ctx = reinterpret_cast<uintptr_t>(x.ctx.get());
+      return hash::fnv<size_t>::compute(x.host, x.port, x.use_ssl, ctx);
+    }
+  };
+
+  /// Bundles all parameters for a single request.
+  struct request_data {
+    http::method method;
+    std::string path;
+    unordered_flat_map<std::string, std::string> fields;
+    byte_buffer payload;
+  };
+
+  /// Bundles metrics for the connection pool.
+  struct metrics_t {
+    /// Counts how many connections the pool currently manages.
+    telemetry::int_gauge* connections;
+
+    /// Counts how many connections currently have no pending request.
+    telemetry::int_gauge* idle_connections;
+
+    /// Counts how many requests re-used an existing connection.
+    telemetry::int_counter* reused_connections;
+
+    /// Counts how many connections the pool closed after reaching the idle
+    /// timeout or the maximum number of idle connections.
+    telemetry::int_counter* evicted_connections;
+  };
+
+  using upper_layer_ptr = std::unique_ptr<upper_layer::client>;
+
+  /// Establishes a new connection that runs the given HTTP application. The
+  /// pool starts the returned socket manager.
+  using connect_fn = callback<expected<socket_manager_ptr>(upper_layer_ptr)>;
+
+  /// Shared handle to a connect function. The pool keeps the handle for
+  /// retrying requests later on a fresh connection.
+  using connect_fn_ptr
+    = shared_callback_ptr<expected<socket_manager_ptr>(upper_layer_ptr)>;
+
+  /// A request that awaits its response.
+  struct pending_request;
+
+  using result_type = expected<std::pair<async::future<response>, disposable>>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a new pool with parameters from the configuration of `sys`.
+  explicit connection_pool(actor_system& sys);
+
+  connection_pool(size_t max_pipelined_requests, timespan max_idle_time,
+                  size_t max_idle_connections, metrics_t metrics = {});
+
+  connection_pool(const connection_pool&) = delete;
+
+  connection_pool& operator=(const connection_pool&) = delete;
+
+  ~connection_pool();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns how many requests a single connection carries at most at the
+  /// same time. A value of 1 disables pipelining.
+  size_t max_pipelined_requests() const noexcept {
+    return max_pipelined_requests_;
+  }
+
+  /// Returns how long a connection may remain idle before the pool closes it.
+  timespan max_idle_time() const noexcept {
+    return max_idle_time_;
+  }
+
+  /// Returns how many idle connections the pool keeps open per endpoint.
+  size_t max_idle_connections() const noexcept {
+    return max_idle_connections_;
+  }
+
+  /// Returns the number of connections in the pool.
+  size_t num_connections() const;
+
+  /// Returns the number of connections without pending requests.
+  size_t num_idle_connections() const;
+
+  // -- sending of requests ----------------------------------------------------
+
+  /// Sends a request to `key`, re-using an open connection if possible.
+  /// Otherwise, calls `connect` to establish a new connection.
+  /// @returns a future for the response and a handle for canceling the
+  ///          request or an error if establishing the connection failed.
+  result_type request(const endpoint& key, request_data req,
+                      connect_fn_ptr connect);
+
+  // -- callbacks for connections ----------------------------------------------
+
+  /// @private
+  bool release(connection* conn);
+
+  /// @private
+  void close(connection* conn);
+
+  /// @private
+  void evict(connection* conn);
+
+  /// @private
+  void retry_or_fail(actor_system& sys, const endpoint& key,
+                     pending_request req, const error& reason);
+
+private:
+  /// Returns an open connection to `key` with capacity for another request or
+  /// `nullptr` if no such connection exists.
+  connection_ptr checkout(const endpoint& key);
+
+  /// Establishes a new connection to `key` for sending `req`.
+  error connect_and_send(const endpoint& key, pending_request req,
+                         connect_fn& connect);
+
+  /// Removes `conn` from the pool.
+  /// @pre `mtx_` is locked
+  socket_manager_ptr close_locked(connection* conn);
+
+  size_t max_pipelined_requests_;
+
+  timespan max_idle_time_;
+
+  size_t max_idle_connections_;
+
+  metrics_t metrics_;
+
+  mutable std::mutex mtx_;
+
+  std::unordered_map<endpoint, std::vector<connection_ptr>, endpoint_hash>
+    connections_;
+};
+
+} // namespace caf::net::http
@@ -0,0 +1,248 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/http/connection_pool.hpp"
+
+#include "caf/test/scenario.hpp"
+
+#include "caf/net/http/response.hpp"
+#include "caf/net/http/with.hpp"
+#include "caf/net/middleman.hpp"
+#include "caf/net/socket_guard.hpp"
+#include "caf/net/stream_socket.hpp"
+#include "caf/net/tcp_accept_socket.hpp"
+#include "caf/net/tcp_stream_socket.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/detail/format.hpp"
+#include "caf/raise_error.hpp"
+#include "caf/uri.hpp"
+
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+constexpr std::string_view keep_alive_response
+  = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+
+constexpr std::string_view close_response
+  = "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 2\r\n\r\nok";
+
+// Accepts a single connection and answers `num_requests` requests on it. The
+// last response asks the client to close the connection if `close_at_end`.
+void run_server(net::tcp_accept_socket acceptor, int num_requests,
+                bool close_at_end) {
+  auto acceptor_guard = net::make_socket_guard(acceptor);
+  auto conn = net::accept(acceptor);
+  if (!conn)
+    return;
+  auto guard = net::make_socket_guard(*conn);
+  std::string input;
+  byte_buffer buf;
+  buf.resize(1024);
+  for (int i = 0; i < num_requests; ++i) {
+    while (input.find("\r\n\r\n") == std::string::npos) {
+      auto n = net::read(*conn, buf);
+      if (n <= 0)
+        return;
+      input.append(reinterpret_cast<const char*>(buf.data()),
+                   static_cast<size_t>(n));
+    }
+    input.erase(0, input.find("\r\n\r\n") + 4);
+    auto str = close_at_end && i + 1 == num_requests ? close_response
+                                                     : keep_alive_response;
+    net::write(*conn, as_bytes(make_span(str)));
+  }
+  // Wait for the client to close the connection.
+  while (net::read(*conn, buf) > 0)
+    ; // nop
+}
+
+// Reads a request header from `conn` into `input`. Returns false if the
+// connection closed before receiving a full header.
+bool read_request(net::stream_socket conn, std::string& input) {
+  byte_buffer buf;
+  buf.resize(1024);
+  while (input.find("\r\n\r\n") == std::string::npos) {
+    auto n = net::read(conn, buf);
+    if (n <= 0)
+      return false;
+    input.append(reinterpret_cast<const char*>(buf.data()),
+                 static_cast<size_t>(n));
+  }
+  input.erase(0, input.find("\r\n\r\n") + 4);
+  return true;
+}
+
+// Answers the first request on a connection with keep-alive but closes the
+// connection when receiving the second request without responding, i.e., it
+// simulates a server that closes idle connections. Then answers one request
+// on a second connection.
+void run_closing_server(net::tcp_accept_socket acceptor) {
+  auto acceptor_guard = net::make_socket_guard(acceptor);
+  std::string input;
+  {
+    auto conn = net::accept(acceptor);
+    if (!conn)
+      return;
+    auto guard = net::make_socket_guard(*conn);
+    if (!read_request(*conn, input))
+      return;
+    net::write(*conn, as_bytes(make_span(keep_alive_response)));
+    input.clear();
+    if (!read_request(*conn, input))
+      return;
+  }
+  auto conn = net::accept(acceptor);
+  if (!conn)
+    return;
+  auto guard = net::make_socket_guard(*conn);
+  input.clear();
+  if (!read_request(*conn, input))
+    return;
+  net::write(*conn, as_bytes(make_span(keep_alive_response)));
+  byte_buffer buf;
+  buf.resize(1024);
+  while (net::read(*conn, buf) > 0)
+    ; // nop
+}
+
+std::string_view to_str(const_byte_span bytes) {
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+struct fixture {
+  fixture() : sys(init_config(cfg)) {
+    auto acceptor = net::make_tcp_accept_socket(0, "127.0.0.1");
+    if (!acceptor)
+      CAF_RAISE_ERROR("failed to open an accept socket");
+    fd = *acceptor;
+    auto port = net::local_port(fd);
+    if (!port)
+      CAF_RAISE_ERROR("failed to retrieve the port of the accept socket");
+    server_uri = detail::format("http://127.0.0.1:{}/foo", *port);
+  }
+
+  static actor_system_config& init_config(actor_system_config& cfg) {
+    cfg.load<net::middleman>();
+    return cfg;
+  }
+
+  auto& pool() {
+    return sys.network_manager().http_client_pool();
+  }
+
+  auto get() {
+    return net::http::with(sys)
+      .connect(make_uri(server_uri))
+      .keep_alive()
+      .get();
+  }
+
+  actor_system_config cfg;
+  actor_system sys;
+  net::tcp_accept_socket fd;
+  std::string server_uri;
+};
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("HTTP clients with keep-alive re-use pooled connections") {
+  GIVEN("a server that accepts only a single connection") {
+    auto server = std::thread{run_server, fd, 3, false};
+    WHEN("sending multiple requests with keep-alive") {
+      THEN("all requests use the same connection") {
+        for (int i = 0; i < 3; ++i) {
+          auto res = get();
+          require(res.has_value());
+          auto maybe_resp = res->first.get(5s);
+          if (check(maybe_resp.has_value())) {
+            check_eq(maybe_resp->code(), net::http::status::ok);
+            check_eq(to_str(maybe_resp->body()), "ok");
+          }
+        }
+        check_eq(pool().num_connections(), 1u);
+        check_eq(pool().num_idle_connections(), 1u);
+      }
+    }
+    // Closes all connections.
+    sys.network_manager().mpx().shutdown();
+    server.join();
+  }
+}
+
+SCENARIO("the pool drops connections after receiving Connection: close") {
+  GIVEN("a server that closes the connection after the second request") {
+    auto server = std::thread{run_server, fd, 2, true};
+    WHEN("sending two requests with keep-alive") {
+      THEN("the pool drops the connection after the second response") {
+        for (int i = 0; i < 2; ++i) {
+          auto res = get();
+          require(res.has_value());
+          auto maybe_resp = res->first.get(5s);
+          check(maybe_resp.has_value());
+        }
+        check_eq(pool().num_connections(), 0u);
+      }
+    }
+    server.join();
+  }
+}
+
+SCENARIO("the pool retries idempotent requests on a fresh connection") {
+  GIVEN("a server that closes a pooled connection when receiving a request") {
+    auto server = std::thread{run_closing_server, fd};
+    WHEN("sending a GET request over the stale connection") {
+      THEN("the pool sends the request again over a new connection") {
+        for (int i = 0; i < 2; ++i) {
+          auto res = get();
+          require(res.has_value());
+          auto maybe_resp = res->first.get(5s);
+          if (check(maybe_resp.has_value())) {
+            check_eq(maybe_resp->code(), net::http::status::ok);
+            check_eq(to_str(maybe_resp->body()), "ok");
+          }
+        }
+        check_eq(pool().num_connections(), 1u);
+      }
+    }
+    sys.network_manager().mpx().shutdown();
+    server.join();
+  }
+  GIVEN("a server that closes a pooled connection when receiving a request") {
+    auto server = std::thread{run_closing_server, fd};
+    WHEN("sending a POST request over the stale connection") {
+      THEN("the pool reports an error instead of sending it again") {
+        auto res = get();
+        require(res.has_value());
+        check(res->first.get(5s).has_value());
+        res = net::http::with(sys)
+                .connect(make_uri(server_uri))
+                .keep_alive()
+                .post("foo");
+        require(res.has_value());
+        auto maybe_resp = res->first.get(5s);
+        check(!maybe_resp.has_value());
+      }
+    }
+    sys.network_manager().mpx().shutdown();
+    // Unblock the server that waits for a second connection.
+    if (auto port = net::local_port(fd)) {
+      auto conn = net::make_connected_tcp_stream_socket("127.0.0.1", *port);
+      if (conn)
+        net::close(*conn);
+    }
+    server.join();
+  }
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
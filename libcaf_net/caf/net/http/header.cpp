@@ -7,6 +7,8 @@
 #include "caf/logger.hpp"
 #include "caf/string_algorithms.hpp"
 
+#include <limits>
+
 namespace caf::net::http {
 
 namespace {
@@ -44,18 +46,41 @@ header::~header() {
 
 header::header(const header& other) {
   if (!other.raw_.empty()) {
-    raw_.assign(other.raw_.begin(), other.raw_.end());
+    assign_raw(other.raw_, true);
     reassign_fields(other);
   }
 }
 
+header::header(header&& other) noexcept
+  : raw_(other.raw_),
+    buf_(std::move(other.buf_)),
+    fields_(std::move(other.fields_)),
+    index_(other.index_) {
+  // Note: moving the buffer keeps its memory, so `raw_` and `fields_` remain
+  //       valid. We must not call the virtual `clear` here, because derived
+  //       types move their own members only after this constructor returns.
+  other.reset();
+}
+
 header& header::operator=(const header& other) {
+  if (this == &other)
+    return *this;
   if (!other.raw_.empty()) {
-    raw_.assign(other.raw_.begin(), other.raw_.end());
+    assign_raw(other.raw_, true);
     reassign_fields(other);
   } else {
-    raw_.clear();
-    fields_.clear();
+    clear();
+  }
+  return *this;
+}
+
+header& header::operator=(header&& other) noexcept {
+  if (this != &other) {
+    raw_ = other.raw_;
+    buf_ = std::move(other.buf_);
+    fields_ = std::move(other.fields_);
+    index_ = other.index_;
+    other.reset();
   }
   return *this;
 }
@@ -68,11 +93,52 @@ void header::reassign_fields(const header& other) {
     fields_[index].first = remap(base, other.fields_[index].first, new_base);
     fields_[index].second = remap(base, other.fields_[index].second, new_base);
   }
+  index_ = other.index_;
+}
+
+void header::assign_raw(std::string_view input, bool copy) {
+  if (copy) {
+    buf_.assign(input.begin(), input.end());
+    raw_ = std::string_view{buf_.data(), buf_.size()};
+  } else {
+    buf_.clear();
+    raw_ = input;
+  }
 }
 
 void header::clear() noexcept {
+  reset();
+}
+
+void header::reset() noexcept {
   fields_.clear();
-  raw_.clear();
+  raw_ = std::string_view{};
+  buf_.clear();
+  index_ = field_index{};
+}
+
+void header::index_field(std::string_view key, size_t pos) noexcept {
+  auto update = [pos](size_t& field) {
+    if (field == no_field)
+      field = pos;
+  };
+  // Dispatch on the size first to avoid comparing against each key.
+  switch (key.size()) {
+    case 10:
+      if (icase_equal(key, "Connection"))
+        update(index_.connection);
+      break;
+    case 14:
+      if (icase_equal(key, "Content-Length"))
+        update(index_.content_length);
+      break;
+    case 17:
+      if (icase_equal(key, "Transfer-Encoding"))
+        update(index_.transfer_encoding);
+      break;
+    default:
+      break;
+  }
 }
 
 // Note: does not take ownership of the data.
@@ -85,6 +151,7 @@ expected<std::string_view> header::parse_fields(std::string_view data) {
       auto m = static_cast<size_t>(std::distance(sep + 1, line.end()));
       auto val = trim(std::string_view{std::addressof(*(sep + 1)), m});
       if (!key.empty()) {
+        index_field(key, fields_.size());
         fields_.emplace_back(key, val);
         return true;
       }
@@ -97,11 +164,36 @@ expected<std::string_view> header::parse_fields(std::string_view data) {
 }
 
 bool header::chunked_transfer_encoding() const noexcept {
-  return field("Transfer-Encoding").find("chunked") != std::string_view::npos;
+  return indexed_field(index_.transfer_encoding).find("chunked")
+         != std::string_view::npos;
 }
 
 std::optional<size_t> header::content_length() const noexcept {
-  return field_as<size_t>("Content-Length");
+  auto str = indexed_field(index_.content_length);
+  if (str.empty())
+    return std::nullopt;
+  size_t result = 0;
+  for (auto c : str) {
+    if (c < '0' || c > '9')
+      return std::nullopt;
+    auto digit = static_cast<size_t>(c - '0');
+    // Reject values that do not fit into a size_t.
+    if (result > (std::numeric_limits<size_t>::max() - digit) / 10)
+      return std::nullopt;
+    result = result * 10 + digit;
+  }
+  return result;
+}
+
+bool header::has_connection_option(std::string_view token) const noexcept {
+  auto str = indexed_field(index_.connection);
+  while (!str.empty()) {
+    auto [option, remainder] = split_by(str, ",");
+    if (icase_equal(trim(option), token))
+      return true;
+    str = remainder;
+  }
+  return false;
 }
 
 } // namespace caf::net::http
@@ -27,10 +27,10 @@ public:
   header() = default;
 
   /// Move constructor.
-  header(header&&) = default;
+  header(header&& other) noexcept;
 
   /// Move assignment operator.
-  header& operator=(header&&) = default;
+  header& operator=(header&& other) noexcept;
 
   /// Copy constructor.
   header(const header&);
@@ -108,6 +108,15 @@ public:
   /// Convenience function for `field_as<size_t>("Content-Length")`.
   std::optional<size_t> content_length() const noexcept;
 
+  /// Checks whether the `Connection` field lists `token`, e.g., `close` or
+  /// `keep-alive`, using case-insensitive comparison.
+  bool has_connection_option(std::string_view token) const noexcept;
+
+  /// Checks whether the header refers to memory that it does not own.
+  bool borrows_data() const noexcept {
+    return !raw_.empty() && buf_.empty();
+  }
+
   /// Checks if the request header is valid (non-empty).
   bool valid() const noexcept {
     return !raw_.empty();
@@ -141,12 +150,44 @@ protected:
   /// Reassigns the shallow map from one address to another.
   void reassign_fields(const header& other);
 
-  /// Stores the raw HTTP input.
-  std::vector<char> raw_;
+  /// Sets the raw HTTP input, either by copying `input` into an internal
+  /// buffer or by referring to the memory of the caller.
+  void assign_raw(std::string_view input, bool copy);
+
+  /// Points to the raw HTTP input.
+  std::string_view raw_;
 
 private:
+  /// Marks fields that are not present in the header.
+  static constexpr size_t no_field = static_cast<size_t>(-1);
+
+  /// Positions of frequently accessed fields in `fields_`. Parsing the header
+  /// fills this index to avoid scanning all fields for each lookup.
+  struct field_index {
+    size_t content_length = no_field;
+    size_t transfer_encoding = no_field;
+    size_t connection = no_field;
+  };
+
+  /// Returns the value of the field at `pos` or an empty view for `no_field`.
+  std::string_view indexed_field(size_t pos) const noexcept {
+    return pos < fields_.size() ? fields_[pos].second : std::string_view{};
+  }
+
+  /// Adds `key` to the index if it is one of the frequently accessed fields.
+  void index_field(std::string_view key, size_t pos) noexcept;
+
+  /// Clears the members of this class without affecting derived types.
+  void reset() noexcept;
+
+  /// Stores the raw HTTP input unless the header refers to external memory.
+  std::vector<char> buf_;
+
   /// A shallow map for looking up individual header fields.
   fields_map fields_;
+
+  /// Allows constant-time access to frequently accessed fields.
+  field_index index_;
 };
 
 } // namespace caf::net::http
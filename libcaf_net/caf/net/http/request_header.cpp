@@ -38,23 +38,38 @@ request_header& request_header::operator=(const request_header& other) {
   return *this;
 }
 
+bool request_header::keep_alive() const noexcept {
+  if (version_ == "HTTP/1.0")
+    return has_connection_option("keep-alive");
+  return !has_connection_option("close");
+}
+
 std::pair<status, std::string_view>
 request_header::parse(std::string_view raw) {
-  auto lg = log::net::trace("raw = {}", raw);
+  return parse_impl(raw, true);
+}
+
+std::pair<status, std::string_view>
+request_header::parse_in_place(std::string_view raw) {
+  return parse_impl(raw, false);
+}
+
+std::pair<status, std::string_view>
+request_header::parse_impl(std::string_view raw, bool copy) {
+  auto lg = log::net::trace("raw = {}, copy = {}", raw, copy);
   // Sanity checking and copying of the raw input.
   clear();
   if (raw.empty())
     return {status::bad_request, "Empty header."};
-  raw_.assign(raw.begin(), raw.end());
+  assign_raw(raw, copy);
   // Parse the first line, i.e., "METHOD REQUEST-URI VERSION".
-  auto [first_line, remainder]
-    = split_by(std::string_view{raw_.data(), raw_.size()}, eol);
+  auto [first_line, remainder] = split_by(raw_, eol);
   auto [method_str, first_line_remainder] = split_by(first_line, " ");
   auto [request_uri_str, version] = split_by(first_line_remainder, " ");
   // The path must be absolute.
   if (request_uri_str.empty() || request_uri_str.front() != '/') {
     log::net::debug("Malformed Request-URI: expected an absolute path.");
-    raw_.clear();
+    clear();
     return {status::bad_request,
             "Malformed Request-URI: expected an absolute path."};
   }
@@ -65,7 +80,7 @@ request_header::parse(std::string_view raw) {
   } else {
     log::net::debug("Failed to parse URI {} -> {}", request_uri_str,
                     res.error());
-    raw_.clear();
+    clear();
     return {status::bad_request, "Malformed Request-URI."};
   }
   // Verify and store the method.
@@ -87,7 +102,7 @@ request_header::parse(std::string_view raw) {
     method_ = method::trace;
   } else {
     log::net::debug("Invalid HTTP method.");
-    raw_.clear();
+    clear();
     return {status::bad_request, "Invalid HTTP method."};
   }
   // Store the remaining header fields.
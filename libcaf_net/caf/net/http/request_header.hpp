@@ -32,6 +32,9 @@ public:
   /// Move constructor.
   request_header(request_header&&) = default;
 
+  /// Move assignment operator.
+  request_header& operator=(request_header&&) = default;
+
   /// Copy constructor.
   request_header(const request_header&);
 
@@ -66,13 +69,27 @@ public:
     return version_;
   }
 
+  /// Checks whether the client wants to keep the connection open after
+  /// receiving the response. HTTP/1.1 connections are persistent unless the
+  /// client sends `Connection: close`, whereas HTTP/1.0 clients must opt in by
+  /// sending `Connection: keep-alive`.
+  bool keep_alive() const noexcept;
+
   /// Parses a raw request header string and returns a pair containing the
   /// status and a description for the status.
   /// @returns `status::bad_request` on error with a human-readable description
   ///          of the error, `status::ok` otherwise.
   std::pair<status, std::string_view> parse(std::string_view raw);
 
+  /// Like `parse`, but refers to `raw` instead of copying it.
+  /// @warning The header becomes invalid once `raw` goes out of scope. Copies
+  ///          of the header own their data.
+  std::pair<status, std::string_view> parse_in_place(std::string_view raw);
+
 private:
+  std::pair<status, std::string_view> parse_impl(std::string_view raw,
+                                                 bool copy);
+
   /// Stores the HTTP method that we've parsed from the raw input.
   http::method method_;
 
@@ -186,4 +186,57 @@ TEST("invalid request headers are copyable and movable") {
   }
 }
 
+TEST("parsing in place refers to the input instead of copying it") {
+  std::string input = "GET /foo HTTP/1.1\r\n"
+                      "Host: localhost:8090\r\n"
+                      "Content-Length: 3\r\n\r\n";
+  net::http::request_header uut;
+  auto [status, _] = uut.parse_in_place(input);
+  require_eq(status, net::http::status::ok);
+  check(uut.borrows_data());
+  check_eq(uut.field("Host").data(), input.data() + input.find("localhost"));
+  SECTION("copies of the header own their data") {
+    auto other{uut};
+    check(!other.borrows_data());
+    input.assign(input.size(), 'x');
+    check_eq(other.version(), "HTTP/1.1");
+    check_eq(other.field("Host"), "localhost:8090");
+    check_eq(other.content_length(), std::optional<size_t>{3});
+  }
+  SECTION("parse copies the input") {
+    net::http::request_header other;
+    other.parse(input);
+    check(!other.borrows_data());
+  }
+}
+
+TEST("request headers provide fast access to common fields") {
+  net::http::request_header uut;
+  SECTION("Content-Length") {
+    uut.parse("POST /foo HTTP/1.1\r\ncontent-length: 42\r\n\r\n");
+    check_eq(uut.content_length(), std::optional<size_t>{42});
+    uut.parse("POST /foo HTTP/1.1\r\nContent-Length: 4x\r\n\r\n");
+    check(!uut.content_length());
+    uut.parse("POST /foo HTTP/1.1\r\n\r\n");
+    check(!uut.content_length());
+  }
+  SECTION("Transfer-Encoding") {
+    uut.parse("POST /foo HTTP/1.1\r\nTRANSFER-ENCODING: chunked\r\n\r\n");
+    check(uut.chunked_transfer_encoding());
+    uut.parse("POST /foo HTTP/1.1\r\nContent-Length: 3\r\n\r\n");
+    check(!uut.chunked_transfer_encoding());
+  }
+  SECTION("Connection") {
+    uut.parse("GET /foo HTTP/1.1\r\n\r\n");
+    check(uut.keep_alive());
+    uut.parse("GET /foo HTTP/1.1\r\nConnection: Upgrade, Close\r\n\r\n");
+    check(uut.has_connection_option("upgrade"));
+    check(!uut.keep_alive());
+    uut.parse("GET /foo HTTP/1.0\r\n\r\n");
+    check(!uut.keep_alive());
+    uut.parse("GET /foo HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+    check(uut.keep_alive());
+  }
+}
+
 } // namespace
@@ -57,6 +57,12 @@ response_header& response_header::operator=(const response_header& other) {
   return *this;
 }
 
+bool response_header::keep_alive() const noexcept {
+  if (version_ == "HTTP/1.1")
+    return !has_connection_option("close");
+  return has_connection_option("keep-alive");
+}
+
 std::pair<status, std::string_view>
 response_header::parse(std::string_view raw) {
   auto lg = log::net::trace("raw = {}", raw);
@@ -64,22 +70,21 @@ response_header::parse(std::string_view raw) {
   clear();
   if (raw.empty())
     return {status::bad_request, "Empty header."};
-  raw_.assign(raw.begin(), raw.end());
+  assign_raw(raw, true);
   // Parse the first line, i.e., "VERSION STATUS STATUS-TEXT".
-  auto [first_line, remainder]
-    = split_by(std::string_view{raw_.data(), raw_.size()}, eol);
+  auto [first_line, remainder] = split_by(raw_, eol);
   auto [version_str, first_line_remainder] = split_by(first_line, " ");
   auto [status_str, status_text] = split_by(first_line_remainder, " ");
   if (!validate_http_version(version_str)) {
     log::net::debug("Invalid http version.");
-    raw_.clear();
+    clear();
     return {status::bad_request, "Invalid HTTP version."};
   }
   version_ = version_str;
   // Parse the status from the string.
   if (auto res = get_as<uint16_t>(config_value{status_str}); !res) {
     log::net::debug("Invalid status");
-    raw_.clear();
+    clear();
     return {status::bad_request, "Invalid HTTP status."};
   } else {
     status_ = *res;
@@ -87,7 +92,7 @@ response_header::parse(std::string_view raw) {
   status_text_ = trim(status_text);
   if (status_text_.empty()) {
     log::net::debug("Empty status text.");
-    raw_.clear();
+    clear();
     return {status::bad_request, "Invalid HTTP status text."};
   }
   auto remaining_text = parse_fields(remainder);
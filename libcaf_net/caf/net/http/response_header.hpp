@@ -58,6 +58,12 @@ public:
     return status_text_;
   }
 
+  /// Checks whether the server keeps the connection open after sending this
+  /// response. HTTP/1.1 connections are persistent unless the server sends
+  /// `Connection: close`, whereas HTTP/1.0 servers must opt in by sending
+  /// `Connection: keep-alive`.
+  bool keep_alive() const noexcept;
+
   /// Parses a raw response header string and returns a pair containing the
   /// status and a description for the status.
   /// @returns `status::bad_request` on error with a human-readable description
@@ -48,15 +48,18 @@ request router::lift(responder&& res) {
                      down_->add_header_field(key, val);
                    std::ignore = down_->end_header();
                    down_->send_payload(res.body());
-                   pending_.erase(request_id);
+                   response_sent(request_id);
                  },
                  [this, request_id](const error& err) {
                    auto description = to_string(err);
                    down_->send_response(status::internal_server_error,
                                         "text/plain", description);
-                   pending_.erase(request_id);
+                   response_sent(request_id);
                  });
   pending_.emplace(request_id, std::move(hdl));
+  // Stop processing pipelined requests until we have sent this response.
+  // Otherwise, responses could arrive at the client out of order.
+  down_->suspend_reading();
   return lifted;
 }
 
@@ -88,11 +91,31 @@ error router::start(lower_layer::server* down) {
 }
 
 ptrdiff_t router::consume(const request_header& hdr, const_byte_span payload) {
-  for (auto& ptr : routes_)
-    if (ptr->exec(hdr, payload, this))
-      return static_cast<ptrdiff_t>(payload.size());
-  down_->send_response(http::status::not_found, "text/plain", "Not found.");
+  auto dispatch = [&] {
+    for (auto& ptr : routes_)
+      if (ptr->exec(hdr, payload, this))
+        return;
+    down_->send_response(http::status::not_found, "text/plain", "Not found.");
+  };
+  dispatch();
+  if (!hdr.keep_alive()) {
+    // Close the connection after sending all responses.
+    if (pending_.empty())
+      down_->shutdown();
+    else
+      close_when_done_ = true;
+  }
   return static_cast<ptrdiff_t>(payload.size());
 }
 
+void router::response_sent(size_t request_id) {
+  pending_.erase(request_id);
+  if (!pending_.empty())
+    return;
+  if (close_when_done_)
+    down_->shutdown();
+  else
+    down_->request_messages();
+}
+
 } // namespace caf::net::http
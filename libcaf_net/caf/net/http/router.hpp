@@ -75,6 +75,10 @@ public:
   void abort(const error& reason) override;
 
 private:
+  /// Removes a lifted request from `pending_` after sending its response and
+  /// resumes processing of pipelined requests once all responses are out.
+  void response_sent(size_t request_id);
+
   /// Handle to the underlying HTTP layer.
   lower_layer::server* down_ = nullptr;
 
@@ -87,6 +91,9 @@ private:
   /// Keeps track of pending HTTP requests when lifting @ref responder objects.
   std::unordered_map<size_t, disposable> pending_;
 
+  /// Stores whether the client asked us to close the connection.
+  bool close_when_done_ = false;
+
   /// Lazily initialized for allowing a @ref route to interact with actors.
   actor_shell_ptr shell_;
 };
@@ -150,6 +150,11 @@ public:
   ptrdiff_t consume(byte_span input, byte_span) override {
     auto lg = log::net::trace("bytes = {}", input.size());
     ptrdiff_t consumed = 0;
+    // Clients may send multiple requests at once (pipelining). We process them
+    // one by one until either running out of data or until the upper layer
+    // suspends reading, e.g., to finish an asynchronous response first. Since
+    // the transport keeps unconsumed data in its buffer, we pick up where we
+    // left off once the upper layer calls `request_messages` again.
     for (;;) {
       switch (mode_) {
         case mode::read_header: {
@@ -183,6 +188,11 @@ public:
                                "Payload exceeds maximum size.");
                 return -1;
               }
+              // The header refers to the buffer of the transport, which
+              // discards the consumed bytes before calling us again. Hence, we
+              // must copy the header if we need to wait for the payload.
+              if (input.size() < *len)
+                hdr_ = request_header{hdr_};
               // Transition to read_payload mode and continue.
               payload_len_ = *len;
               mode_ = mode::read_payload;
@@ -192,6 +202,8 @@ public:
               //       after the payload.
               if (!invoke_upper_layer(const_byte_span{}))
                 return -1;
+              if (!continue_reading())
+                return consumed;
             }
           }
           break;
@@ -201,7 +213,10 @@ public:
             if (!invoke_upper_layer(input.subspan(0, payload_len_)))
               return -1;
             consumed += static_cast<ptrdiff_t>(payload_len_);
+            input = input.subspan(payload_len_);
             mode_ = mode::read_header;
+            if (!continue_reading())
+              return consumed;
           } else {
             // Wait for more data.
             return consumed;
@@ -231,9 +246,20 @@ private:
     return up_->consume(hdr_, payload) >= 0;
   }
 
+  // Checks whether we may process the next request after passing one to the
+  // upper layer. Stops reading if the client asked us to close the connection.
+  bool continue_reading() {
+    if (!hdr_.keep_alive()) {
+      log::net::debug("client requested to close the connection");
+      down_->configure_read(receive_policy::stop());
+      return false;
+    }
+    return down_->is_reading();
+  }
+
   bool handle_header(std::string_view http) {
     // Parse the header and reject invalid inputs.
-    auto [code, msg] = hdr_.parse(http);
+    auto [code, msg] = hdr_.parse_in_place(http);
     if (code != status::ok) {
       log::net::debug("received malformed header");
       up_->abort(make_error(sec::protocol_error, "received malformed header"));
@@ -248,7 +274,8 @@ private:
 
   upper_layer_ptr up_;
 
-  /// Buffer for re-using memory.
+  /// Stores the header of the current request. Usually refers to the buffer of
+  /// the transport to avoid copying the header fields.
   request_header hdr_;
 
   /// Stores whether we are currently waiting for the payload.
@@ -232,6 +232,58 @@ SCENARIO("the client receives a chunked HTTP response") {
   }
 }
 
+SCENARIO("the server processes pipelined requests in order") {
+  GIVEN("multiple HTTP requests with payload in a single write") {
+    std::string_view requests = "POST /foo HTTP/1.1\r\n"
+                                "Content-Length: 5\r\n\r\n"
+                                "first"
+                                "POST /bar HTTP/1.1\r\n"
+                                "Content-Length: 6\r\n\r\n"
+                                "second"
+                                "GET /baz HTTP/1.1\r\n"
+                                "Connection: close\r\n\r\n"
+                                "GET /ignored HTTP/1.1\r\n\r\n";
+    std::string_view responses = "HTTP/1.1 200 OK\r\n"
+                                 "Content-Type: text/plain\r\n"
+                                 "Content-Length: 10\r\n"
+                                 "\r\n"
+                                 "/foo:first"
+                                 "HTTP/1.1 200 OK\r\n"
+                                 "Content-Type: text/plain\r\n"
+                                 "Content-Length: 11\r\n"
+                                 "\r\n"
+                                 "/bar:second"
+                                 "HTTP/1.1 200 OK\r\n"
+                                 "Content-Type: text/plain\r\n"
+                                 "Content-Length: 5\r\n"
+                                 "\r\n"
+                                 "/baz:";
+    WHEN("sending them to an HTTP server") {
+      run_server([](auto* down, const net::http::request_header& request_hdr,
+                    const_byte_span body) mutable {
+        auto str = std::string{request_hdr.path()};
+        str += ':';
+        str.insert(str.end(), reinterpret_cast<const char*>(body.data()),
+                   reinterpret_cast<const char*>(body.data() + body.size()));
+        down->send_response(net::http::status::ok, "text/plain", str);
+      });
+      net::write(fd1, as_bytes(make_span(requests)));
+      THEN("the server responds to each request in order") {
+        byte_buffer buf;
+        buf.resize(responses.size());
+        auto pos = size_t{0};
+        while (pos < buf.size()) {
+          auto n = net::read(fd1, make_span(buf).subspan(pos));
+          if (n <= 0)
+            break;
+          pos += static_cast<size_t>(n);
+        }
+        check_eq(to_str(buf), responses);
+      }
+    }
+  }
+}
+
 } // WITH_FIXTURE(fixture)
 
 } // namespace
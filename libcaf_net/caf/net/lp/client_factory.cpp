@@ -18,7 +18,7 @@ expected<disposable> do_start_impl(Config& cfg, Conn conn,
                                    async::consumer_resource<frame> pull,
                                    async::producer_resource<frame> push) {
   auto bridge = internal::make_lp_flow_bridge(std::move(pull), std::move(push));
-  auto impl = framing::make(std::move(bridge));
+  auto impl = framing::make(std::move(bridge), cfg.write_cfg);
   auto transport = internal::make_transport(std::move(conn), std::move(impl));
   transport->active_policy().connect();
   auto ptr = socket_manager::make(cfg.mpx, std::move(transport));
@@ -33,6 +33,9 @@ public:
   using super = dsl::client_config_value;
 
   using super::super;
+
+  /// Configures how the framing writes messages to the transport.
+  write_config write_cfg;
 };
 
 client_factory::client_factory(client_factory&& other) noexcept {
@@ -49,6 +52,13 @@ client_factory::~client_factory() {
     config_->deref();
 }
 
+client_factory& client_factory::coalesce_writes(timespan max_delay,
+                                                size_t max_bytes) {
+  config_->write_cfg.max_delay = max_delay;
+  config_->write_cfg.max_bytes = max_bytes;
+  return *this;
+}
+
 dsl::client_config_value& client_factory::base_config() {
   return *config_;
 }
@@ -14,6 +14,7 @@
 #include "caf/net/tcp_stream_socket.hpp"
 
 #include "caf/async/spsc_buffer.hpp"
+#include "caf/defaults.hpp"
 #include "caf/detail/net_export.hpp"
 #include "caf/disposable.hpp"
 #include "caf/timespan.hpp"
@@ -42,6 +43,14 @@ public:
 
   ~client_factory() override;
 
+  /// Delays outgoing messages for up to `max_delay` in order to send multiple
+  /// small messages with a single system call. Flushes the messages early once
+  /// they reach `max_bytes`.
+  client_factory&
+  coalesce_writes(timespan max_delay,
+                  size_t max_bytes
+                  = defaults::net::lp_write_coalescing_max_bytes);
+
   /// Starts a connection with the length-prefixing protocol.
   template <class OnStart>
   [[nodiscard]] expected<disposable> start(OnStart on_start) {
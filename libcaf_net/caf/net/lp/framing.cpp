@@ -6,8 +6,10 @@
 #include "caf/net/receive_policy.hpp"
 #include "caf/net/socket_manager.hpp"
 
+#include "caf/action.hpp"
 #include "caf/async/spsc_buffer.hpp"
 #include "caf/byte_span.hpp"
+#include "caf/chunk.hpp"
 #include "caf/detail/assert.hpp"
 #include "caf/detail/network_order.hpp"
 #include "caf/error.hpp"
@@ -16,6 +18,7 @@
 #include "caf/log/net.hpp"
 #include "caf/sec.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -46,10 +49,15 @@ public:
 
   // -- constructors, destructors, and assignment operators --------------------
 
-  explicit framing_impl(upper_layer_ptr up) : up_(std::move(up)) {
+  framing_impl(upper_layer_ptr up, const write_config& cfg)
+    : up_(std::move(up)), cfg_(cfg) {
     // nop
   }
 
+  ~framing_impl() override {
+    flush_timer_.dispose();
+  }
+
   // -- implementation of octet_stream::upper_layer ----------------------------
 
   error start(octet_stream::lower_layer* down) override {
@@ -58,6 +66,7 @@ public:
   }
 
   void abort(const error& reason) override {
+    flush_timer_.dispose();
     up_->abort(reason);
   }
 
@@ -144,26 +153,32 @@ public:
   }
 
   void begin_message() override {
-    down_->begin_output();
-    auto& buf = down_->output_buffer();
+    if (!coalescing())
+      down_->begin_output();
+    auto& buf = message_buffer();
     message_offset_ = buf.size();
     buf.insert(buf.end(), 4, std::byte{0});
   }
 
   byte_buffer& message_buffer() override {
-    return down_->output_buffer();
+    return coalescing() ? pending_ : down_->output_buffer();
   }
 
   bool end_message() override {
     using detail::to_network_order;
-    auto& buf = down_->output_buffer();
+    auto& buf = message_buffer();
     CAF_ASSERT(message_offset_ < buf.size());
     auto msg_begin = buf.begin() + static_cast<ptrdiff_t>(message_offset_);
     auto msg_size = std::distance(msg_begin + 4, buf.end());
     if (msg_size > 0 && static_cast<size_t>(msg_size) < max_message_length) {
       auto u32_size = to_network_order(static_cast<uint32_t>(msg_size));
       memcpy(std::addressof(*msg_begin), &u32_size, 4);
-      down_->end_output();
+      if (!coalescing())
+        down_->end_output();
+      else if (pending_.size() >= cfg_.max_bytes)
+        flush();
+      else if (!flush_timer_)
+        start_flush_timer();
       return true;
     } else {
       if (msg_size == 0)
@@ -174,11 +189,66 @@ public:
     }
   }
 
+  bool write_message(const chunk& payload) override {
+    using detail::to_network_order;
+    auto msg_size = payload.size();
+    if (msg_size < cfg_.zero_copy_threshold || msg_size == 0)
+      return lp::lower_layer::write_message(payload);
+    if (msg_size >= max_message_length) {
+      log::net::debug("maximum message size exceeded");
+      return false;
+    }
+    // Make sure that previous messages go out first.
+    flush();
+    down_->begin_output();
+    auto& buf = down_->output_buffer();
+    auto u32_size = to_network_order(static_cast<uint32_t>(msg_size));
+    auto hdr = reinterpret_cast<const std::byte*>(&u32_size);
+    buf.insert(buf.end(), hdr, hdr + hdr_size);
+    down_->write_chunk(payload);
+    down_->end_output();
+    return true;
+  }
+
   void shutdown() override {
+    flush();
     down_->shutdown();
   }
 
 private:
+  // -- utility functions ------------------------------------------------------
+
+  /// Checks whether we delay small messages for sending them in batches.
+  bool coalescing() const noexcept {
+    return cfg_.max_delay.count() > 0;
+  }
+
+  /// Moves all coalesced messages to the output buffer of the transport.
+  void flush() {
+    if (flush_timer_) {
+      flush_timer_.dispose();
+      flush_timer_ = disposable{};
+    }
+    if (pending_.empty())
+      return;
+    down_->begin_output();
+    auto& buf = down_->output_buffer();
+    if (buf.empty())
+      buf.swap(pending_);
+    else
+      buf.insert(buf.end(), pending_.begin(), pending_.end());
+    pending_.clear();
+    down_->end_output();
+  }
+
+  /// Flushes coalesced messages after reaching the maximum delay.
+  void start_flush_timer() {
+    auto now = std::chrono::steady_clock::now();
+    auto fn = make_action([this] { flush(); });
+    flush_timer_ = down_->manager()->delay_until(now + cfg_.max_delay,
+                                                 std::move(fn));
+  }
+
   // -- member variables -------------------------------------------------------
 
   octet_stream::lower_layer* down_;
@@ -186,6 +256,15 @@ private:
   upper_layer_ptr up_;
 
   size_t message_offset_ = 0;
+
+  /// Configures how we write messages to the transport.
+  write_config cfg_;
+
+  /// Stores coalesced messages until flushing them to the transport.
+  byte_buffer pending_;
+
+  /// Flushes `pending_` after reaching the maximum delay.
+  disposable flush_timer_;
 };
 
 } // namespace
@@ -193,7 +272,12 @@ private:
 // -- factories ----------------------------------------------------------------
 
 std::unique_ptr<framing> framing::make(upper_layer_ptr up) {
-  return std::make_unique<framing_impl>(std::move(up));
+  return make(std::move(up), write_config{});
+}
+
+std::unique_ptr<framing> framing::make(upper_layer_ptr up,
+                                       const write_config& cfg) {
+  return std::make_unique<framing_impl>(std::move(up), cfg);
 }
 
 namespace {
@@ -7,6 +7,7 @@
 #include "caf/net/fwd.hpp"
 #include "caf/net/lp/lower_layer.hpp"
 #include "caf/net/lp/upper_layer.hpp"
+#include "caf/net/lp/write_config.hpp"
 #include "caf/net/octet_stream/upper_layer.hpp"
 
 #include "caf/detail/net_export.hpp"
@@ -31,6 +32,9 @@ public:
 
   static std::unique_ptr<framing> make(upper_layer_ptr up);
 
+  static std::unique_ptr<framing> make(upper_layer_ptr up,
+                                       const write_config& cfg);
+
   static disposable run(multiplexer& mpx, stream_socket fd,
                         async::consumer_resource<chunk> pull,
                         async::producer_resource<chunk> push);
@@ -151,9 +151,10 @@ struct fixture {
   }
 
   template <class Callback>
-  void run_app(Callback cb, buffer_ptr buf) {
+  void run_app(Callback cb, buffer_ptr buf,
+               const net::lp::write_config& cfg = {}) {
     auto app = app_t::make(mpx, std::move(cb), std::move(buf));
-    auto client = net::lp::framing::make(std::move(app));
+    auto client = net::lp::framing::make(std::move(app), cfg);
     auto transport = net::octet_stream::transport::make(fd2, std::move(client));
     auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
     mpx->start(mgr);
@@ -201,6 +202,48 @@ SCENARIO("length-prefix framing reads data with 32-bit size headers") {
   }
 }
 
+SCENARIO("length-prefix framing may coalesce writes") {
+  GIVEN("a framing object with write coalescing enabled") {
+    auto cfg = net::lp::write_config{};
+    cfg.max_delay = 10ms;
+    cfg.zero_copy_threshold = 1024;
+    auto large = std::string(64 * 1024, 'x');
+    auto to_chunk = [](std::string_view str) {
+      return chunk{as_bytes(make_span(str))};
+    };
+    WHEN("the app sends small and large messages") {
+      auto buf = std::make_shared<buffer>();
+      run_app(
+        [&](net::lp::lower_layer* down) {
+          down->write_message(to_chunk("first"));
+          down->write_message(to_chunk("second"));
+          down->write_message(to_chunk(large));
+          down->write_message(to_chunk("third"));
+        },
+        buf, cfg);
+      THEN("the peer receives all messages in order") {
+        byte_buffer expected;
+        for (auto str : {"first"sv, "second"sv, std::string_view{large},
+                         "third"sv}) {
+          auto bytes = encode(str);
+          expected.insert(expected.end(), bytes.begin(), bytes.end());
+        }
+        byte_buffer received;
+        byte_buffer rd_buf;
+        rd_buf.resize(4096);
+        while (received.size() < expected.size()) {
+          auto res = net::read(fd1, rd_buf);
+          if (res <= 0)
+            fail("failed to read from the socket");
+          received.insert(received.end(), rd_buf.begin(),
+                          rd_buf.begin() + res);
+        }
+        check_eq(received, expected);
+      }
+    }
+  }
+}
+
 } // WITH_FIXTURE(fixture)
 
 void run_writer(net::stream_socket fd) {
@@ -4,10 +4,21 @@
 
 #include "caf/net/lp/lower_layer.hpp"
 
+#include "caf/byte_buffer.hpp"
+#include "caf/chunk.hpp"
+
 namespace caf::net::lp {
 
 lower_layer::~lower_layer() {
   // nop
 }
 
+bool lower_layer::write_message(const chunk& payload) {
+  begin_message();
+  auto& buf = message_buffer();
+  auto bytes = payload.bytes();
+  buf.insert(buf.end(), bytes.begin(), bytes.end());
+  return end_message();
+}
+
 } // namespace caf::net::lp
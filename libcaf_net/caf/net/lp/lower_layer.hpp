@@ -40,6 +40,12 @@ public:
   /// @note When returning `false`, clients must also call
   ///       `down.set_read_error(...)` with an appropriate error code.
   virtual bool end_message() = 0;
+
+  /// Sends `payload` as a single message. Other than assembling the message
+  /// with `begin_message()` and `end_message()`, this function allows the
+  /// lower layers to avoid copying large payloads. The default implementation
+  /// copies `payload` into the message buffer.
+  virtual bool write_message(const chunk& payload);
 };
 
 } // namespace caf::net::lp
@@ -23,9 +23,11 @@ public:
   using event_type = net::accept_event<frame>;
 
   connection_acceptor_impl(Acceptor acceptor, size_t max_consecutive_reads,
+                           const write_config& write_cfg,
                            async::producer_resource<event_type> events)
     : acceptor_(std::move(acceptor)),
       max_consecutive_reads_(max_consecutive_reads),
+      write_cfg_(write_cfg),
       events_(std::move(events)) {
     // nop
   }
@@ -64,8 +66,8 @@ public:
     auto bridge = internal::make_lp_flow_bridge(std::move(a2s_pull),
                                                 std::move(s2a_push));
     // Create the socket manager.
-    auto transport = internal::make_transport(std::move(*conn),
-                                              framing::make(std::move(bridge)));
+    auto transport = internal::make_transport(
+      std::move(*conn), framing::make(std::move(bridge), write_cfg_));
     transport->active_policy().accept();
     return net::socket_manager::make(parent_->mpx_ptr(), std::move(transport));
   }
@@ -77,6 +79,8 @@ private:
 
   size_t max_consecutive_reads_;
 
+  write_config write_cfg_;
+
   intrusive_ptr<flow::op::mcast<event_type>> mcast_;
 
   async::producer_resource<event_type> events_;
@@ -89,7 +93,7 @@ do_start_impl(Config& cfg, Acceptor acc,
   using impl_t = connection_acceptor_impl<Acceptor>;
   auto conn_acc = std::make_unique<impl_t>(std::move(acc),
                                            cfg.max_consecutive_reads,
-                                           std::move(push));
+                                           cfg.write_cfg, std::move(push));
   auto handler = internal::make_accept_handler(std::move(conn_acc),
                                                cfg.max_connections);
   auto ptr = net::socket_manager::make(cfg.mpx, std::move(handler));
@@ -105,6 +109,9 @@ public:
   using super = dsl::server_config_value;
 
   using super::super;
+
+  /// Configures how the framing writes messages to the transport.
+  write_config write_cfg;
 };
 
 server_factory::server_factory(server_factory&& other) noexcept {
@@ -121,6 +128,13 @@ server_factory::~server_factory() {
     config_->deref();
 }
 
+server_factory&& server_factory::coalesce_writes(timespan max_delay,
+                                                 size_t max_bytes) && {
+  config_->write_cfg.max_delay = max_delay;
+  config_->write_cfg.max_bytes = max_bytes;
+  return std::move(*this);
+}
+
 dsl::server_config_value& server_factory::base_config() {
   return *config_;
 }
@@ -22,6 +22,7 @@
 #include "caf/detail/net_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/none.hpp"
+#include "caf/timespan.hpp"
 
 namespace caf::net::lp {
 
@@ -41,6 +42,14 @@ public:
 
   ~server_factory() override;
 
+  /// Delays outgoing messages for up to `max_delay` in order to send multiple
+  /// small messages with a single system call. Flushes the messages early once
+  /// they reach `max_bytes`.
+  server_factory&&
+  coalesce_writes(timespan max_delay,
+                  size_t max_bytes
+                  = defaults::net::lp_write_coalescing_max_bytes) &&;
+
   /// Starts a server that accepts incoming connections with the
   /// length-prefixing protocol.
   template <class OnStart>
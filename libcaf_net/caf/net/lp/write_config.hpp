@@ -0,0 +1,29 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/defaults.hpp"
+#include "caf/timespan.hpp"
+
+#include <cstddef>
+
+namespace caf::net::lp {
+
+/// Configures how the length-prefix framing writes messages to the transport.
+struct write_config {
+  /// Delays small messages for up to this amount of time in order to send
+  /// multiple messages with a single system call. A value of zero disables
+  /// coalescing.
+  timespan max_delay = timespan{0};
+
+  /// Flushes coalesced messages as soon as they reach this size.
+  size_t max_bytes = defaults::net::lp_write_coalescing_max_bytes;
+
+  /// Passes messages of at least this size to the transport without copying
+  /// them into the output buffer.
+  size_t zero_copy_threshold = defaults::net::lp_zero_copy_threshold;
+};
+
+} // namespace caf::net::lp
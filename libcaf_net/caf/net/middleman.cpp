@@ -4,6 +4,7 @@
 
 #include "caf/net/middleman.hpp"
 
+#include "caf/net/http/connection_pool.hpp"
 #include "caf/net/http/with.hpp"
 #include "caf/net/prometheus.hpp"
 #include "caf/net/ssl/startup.hpp"
@@ -130,6 +131,7 @@ void middleman::init(actor_system_config&) {
     log::system::error("failed to initialize multiplexer: {}", err);
     CAF_RAISE_ERROR("mpx_->init() failed");
   }
+  http_client_pool_ = std::make_unique<http::connection_pool>(sys_);
 }
 
 middleman::actor_system_module::id_t middleman::id() const {
@@ -147,6 +149,13 @@ void middleman::add_module_options(actor_system_config& cfg) {
   config_option_adder{cfg.custom_options(), "caf.net.prometheus-http.tls"}
     .add<std::string>("key-file", "path to the Promehteus private key file")
     .add<std::string>("cert-file", "path to the Promehteus private cert file");
+  config_option_adder{cfg.custom_options(), "caf.net.http-client"}
+    .add<size_t>("max-pipelined-requests",
+                 "maximum number of requests per pooled connection")
+    .add<timespan>("max-idle-time",
+                   "closes pooled connections after being idle for this long")
+    .add<size_t>("max-idle-connections",
+                 "maximum number of idle connections per endpoint");
 }
 
 actor_system_module* middleman::make(actor_system& sys) {
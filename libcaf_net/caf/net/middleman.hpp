@@ -14,6 +14,7 @@
 #include "caf/type_list.hpp"
 #include "caf/version.hpp"
 
+#include <memory>
 #include <thread>
 
 namespace caf::net {
@@ -91,6 +92,11 @@ public:
     return mpx_.get();
   }
 
+  /// Returns the pool for re-using connections of HTTP clients.
+  http::connection_pool& http_client_pool() noexcept {
+    return *http_client_pool_;
+  }
+
 private:
   // -- member variables -------------------------------------------------------
 
@@ -102,6 +108,9 @@ private:
 
   /// Runs the multiplexer's event loop
   std::thread mpx_thread_;
+
+  /// Keeps HTTP client connections open for re-use.
+  std::unique_ptr<http::connection_pool> http_client_pool_;
 };
 
 } // namespace caf::net
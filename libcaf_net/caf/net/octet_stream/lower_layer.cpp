@@ -4,10 +4,19 @@
 
 #include "caf/net/octet_stream/lower_layer.hpp"
 
+#include "caf/byte_buffer.hpp"
+#include "caf/chunk.hpp"
+
 namespace caf::net::octet_stream {
 
 lower_layer::~lower_layer() {
   // nop
 }
 
+void lower_layer::write_chunk(chunk data) {
+  auto bytes = data.bytes();
+  auto& buf = output_buffer();
+  buf.insert(buf.end(), bytes.begin(), bytes.end());
+}
+
 } // namespace caf::net::octet_stream
@@ -40,6 +40,12 @@ public:
   /// registering sockets for write events.
   virtual bool end_output() = 0;
 
+  /// Appends `data` to the output without copying it into the output buffer
+  /// if the transport supports it. Users may only call this function between
+  /// calling `begin_output()` and `end_output()`. The default implementation
+  /// copies `data` into the output buffer.
+  virtual void write_chunk(chunk data);
+
   /// Asks the stream to swap the current upper layer with `next` after
   /// returning from `consume()`.
   /// @note may only be called from the upper layer in `consume`.
@@ -3,10 +3,19 @@
 #include "caf/net/octet_stream/errc.hpp"
 #include "caf/net/stream_socket.hpp"
 
+#include "caf/span.hpp"
+
 namespace caf::net::octet_stream {
 
 policy::~policy() {
   // nop
 }
 
+ptrdiff_t policy::writev(span<const const_byte_span> bufs) {
+  for (const auto& buf : bufs)
+    if (!buf.empty())
+      return write(buf);
+  return 0;
+}
+
 } // namespace caf::net::octet_stream
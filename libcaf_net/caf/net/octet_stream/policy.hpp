@@ -28,6 +28,11 @@ public:
   /// Writes data from the buffer to the socket.
   virtual ptrdiff_t write(const_byte_span buf) = 0;
 
+  /// Writes data from multiple buffers to the socket in a single operation if
+  /// possible. The default implementation calls `write` with the first
+  /// non-empty buffer.
+  virtual ptrdiff_t writev(span<const const_byte_span> bufs);
+
   /// Returns the last socket error on this thread.
   virtual errc last_error(ptrdiff_t) = 0;
 
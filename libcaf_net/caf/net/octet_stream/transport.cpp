@@ -8,10 +8,15 @@
 #include "caf/net/receive_policy.hpp"
 #include "caf/net/socket_manager.hpp"
 
+#include "caf/chunk.hpp"
 #include "caf/defaults.hpp"
 #include "caf/detail/assert.hpp"
 #include "caf/expected.hpp"
 #include "caf/log/net.hpp"
+#include "caf/span.hpp"
+
+#include <array>
+#include <deque>
 
 namespace caf::net::octet_stream {
 
@@ -35,6 +40,10 @@ public:
     return net::write(fd, buf);
   }
 
+  ptrdiff_t writev(span<const const_byte_span> bufs) override {
+    return net::write(fd, bufs);
+  }
+
   errc last_error(ptrdiff_t) override {
     return last_socket_error_is_temporary() ? errc::temporary : errc::permanent;
   }
@@ -97,7 +106,7 @@ public:
   }
 
   bool can_send_more() const noexcept override {
-    return write_buf_.size() < max_write_buf_size_;
+    return write_buf_.size() + chunk_bytes_ < max_write_buf_size_;
   }
 
   void configure_read(receive_policy rd) override {
@@ -124,7 +133,7 @@ public:
   }
 
   void begin_output() override {
-    if (write_buf_.empty())
+    if (output_empty())
       parent_->register_writing();
   }
 
@@ -136,6 +145,13 @@ public:
     return true;
   }
 
+  void write_chunk(chunk data) override {
+    if (data.empty())
+      return;
+    chunk_bytes_ += data.size();
+    chunks_.push_back(pending_chunk{write_buf_.size(), std::move(data), 0});
+  }
+
   bool is_reading() const noexcept override {
     return max_read_size_ > 0;
   }
@@ -145,7 +161,7 @@ public:
   }
 
   void shutdown() override {
-    if (write_buf_.empty()) {
+    if (output_empty()) {
       parent_->shutdown();
     } else {
       configure_read(receive_policy::stop());
@@ -277,7 +293,7 @@ public:
     }
     // When shutting down, we flush our buffer and then shut down the manager.
     if (flags_.shutting_down) {
-      if (write_buf_.empty()) {
+      if (output_empty()) {
         parent_->shutdown();
         return;
       }
@@ -285,11 +301,17 @@ public:
       // Allow the upper layer to add extra data to the write buffer.
       up_->prepare_send();
     }
-    auto write_res = policy_->write(write_buf_);
+    // The upper layer may hold back its data, e.g., to send it in batches.
+    if (output_empty()) {
+      if (up_->done_sending())
+        parent_->deregister_writing();
+      return;
+    }
+    auto write_res = write_output();
     if (write_res > 0) {
-      write_buf_.erase(write_buf_.begin(), write_buf_.begin() + write_res);
+      drop_output(static_cast<size_t>(write_res));
       up_->written(static_cast<size_t>(write_res));
-      if (write_buf_.empty() && up_->done_sending()) {
+      if (output_empty() && up_->done_sending()) {
         if (!flags_.shutting_down) {
           parent_->deregister_writing();
         } else {
@@ -324,12 +346,77 @@ public:
   }
 
   bool finalized() const noexcept override {
-    return write_buf_.empty();
+    return output_empty();
   }
 
 protected:
+  // -- member types -----------------------------------------------------------
+
+  /// A chunk that the upper layer passed to `write_chunk`.
+  struct pending_chunk {
+    /// Position in `write_buf_` where the chunk starts in the output.
+    size_t offset;
+
+    /// The payload of the chunk.
+    chunk data;
+
+    /// Number of bytes from `data` that we have already written.
+    size_t written;
+  };
+
   // -- utility functions ------------------------------------------------------
 
+  /// Checks whether the transport has no more pending output.
+  bool output_empty() const noexcept {
+    return write_buf_.empty() && chunks_.empty();
+  }
+
+  /// Writes as much pending output to the socket as possible, interleaving
+  /// the write buffer with pending chunks.
+  ptrdiff_t write_output() {
+    if (chunks_.empty())
+      return policy_->write(write_buf_);
+    std::array<const_byte_span, net::max_write_buffers> bufs;
+    auto num_bufs = size_t{0};
+    auto pos = size_t{0};
+    for (const auto& entry : chunks_) {
+      if (num_bufs + 2 > bufs.size())
+        break;
+      bufs[num_bufs++] = make_span(write_buf_.data() + pos,
+                                   entry.offset - pos);
+      bufs[num_bufs++] = entry.data.bytes().subspan(entry.written);
+      pos = entry.offset;
+    }
+    if (num_bufs < bufs.size())
+      bufs[num_bufs++] = make_span(write_buf_.data() + pos,
+                                   write_buf_.size() - pos);
+    return policy_->writev(make_span(bufs.data(), num_bufs));
+  }
+
+  /// Drops `n` bytes from the pending output after writing them.
+  void drop_output(size_t n) {
+    auto pos = size_t{0};
+    while (n > 0 && !chunks_.empty()) {
+      auto& front = chunks_.front();
+      auto head = std::min(n, front.offset - pos);
+      pos += head;
+      n -= head;
+      auto remainder = front.data.size() - front.written;
+      auto consumed = std::min(n, remainder);
+      front.written += consumed;
+      chunk_bytes_ -= consumed;
+      n -= consumed;
+      if (consumed < remainder)
+        break;
+      chunks_.pop_front();
+    }
+    pos += n;
+    write_buf_.erase(write_buf_.begin(),
+                     write_buf_.begin() + static_cast<ptrdiff_t>(pos));
+    for (auto& entry : chunks_)
+      entry.offset -= pos;
+  }
+
   /// Consumes as much data from the buffer as possible.
   void handle_buffered_data() {
     auto lg = log::net::trace("buffered_ = {}", buffered_);
@@ -435,6 +522,12 @@ protected:
   /// Caches outgoing data.
   byte_buffer write_buf_;
 
+  /// Stores chunks that we write without copying them into `write_buf_`.
+  std::deque<pending_chunk> chunks_;
+
+  /// Stores how many bytes from `chunks_` are still pending.
+  size_t chunk_bytes_ = 0;
+
   /// Processes incoming data and generates outgoing data.
   upper_layer_ptr up_;
 
@@ -15,6 +15,7 @@
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/byte_buffer.hpp"
+#include "caf/chunk.hpp"
 #include "caf/detail/scope_guard.hpp"
 #include "caf/log/test.hpp"
 #include "caf/make_actor.hpp"
@@ -115,6 +116,63 @@ private:
   consume_impl_t consume_impl_;
 };
 
+/// Writes a short header into the output buffer followed by a large chunk for
+/// each frame.
+class chunk_writer : public os::upper_layer {
+public:
+  static constexpr size_t num_frames = 24;
+
+  static constexpr size_t frame_size = 64 * 1024;
+
+  /// Returns the bytes that the peer should receive.
+  static byte_buffer expected_output() {
+    byte_buffer result;
+    for (size_t i = 0; i < num_frames; ++i) {
+      result.push_back(static_cast<std::byte>(0xF0));
+      result.push_back(static_cast<std::byte>(i));
+      result.insert(result.end(), frame_size, static_cast<std::byte>(i));
+    }
+    return result;
+  }
+
+  error start(os::lower_layer* down_ptr) override {
+    down = down_ptr;
+    down->configure_read(net::receive_policy::stop());
+    return none;
+  }
+
+  void abort(const error&) override {
+    CAF_RAISE_ERROR("abort called");
+  }
+
+  ptrdiff_t consume(byte_span, byte_span) override {
+    return -1;
+  }
+
+  void prepare_send() override {
+    if (done)
+      return;
+    done = true;
+    down->begin_output();
+    for (size_t i = 0; i < num_frames; ++i) {
+      auto& buf = down->output_buffer();
+      buf.push_back(static_cast<std::byte>(0xF0));
+      buf.push_back(static_cast<std::byte>(i));
+      down->write_chunk(
+        chunk{byte_buffer(frame_size, static_cast<std::byte>(i))});
+    }
+    down->end_output();
+  }
+
+  bool done_sending() override {
+    return done;
+  }
+
+  os::lower_layer* down = nullptr;
+
+  bool done = false;
+};
+
 WITH_FIXTURE(fixture) {
 
 TEST("receive") {
@@ -161,6 +219,32 @@ TEST("send") {
            hello_manager);
 }
 
+TEST("the transport writes more chunks than fit into a single writev") {
+  auto transport = os::transport::make(recv_socket_guard.release(),
+                                       std::make_unique<chunk_writer>());
+  auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+  check_eq(mgr->start(), none);
+  mpx->apply_updates();
+  mgr->register_writing();
+  mpx->apply_updates();
+  auto want = chunk_writer::expected_output();
+  auto received = byte_buffer{};
+  auto fd = send_socket_guard.socket();
+  if (auto err = nonblocking(fd, true))
+    CAF_RAISE_ERROR("failed to set socket to nonblocking");
+  byte_buffer buf(64 * 1024);
+  while (received.size() < want.size()) {
+    handle_io_event();
+    auto res = read(fd, buf);
+    if (res > 0)
+      received.insert(received.end(), buf.begin(), buf.begin() + res);
+    else if (res == 0 || !net::last_socket_error_is_temporary())
+      break;
+  }
+  require_eq(received.size(), want.size());
+  check(received == want);
+}
+
 TEST("consuming a non-negative byte count resets the delta") {
   std::vector<std::pair<size_t, size_t>> byte_span_sizes;
   auto mock = mock_application::make(
@@ -114,4 +114,20 @@ stream_socket connection::fd() const noexcept {
   return stream_socket{invalid_socket_id};
 }
 
+bool connection::ktls_send_enabled() const noexcept {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  if (pimpl_ != nullptr)
+    return BIO_get_ktls_send(SSL_get_wbio(native(pimpl_))) != 0;
+#endif
+  return false;
+}
+
+bool connection::ktls_recv_enabled() const noexcept {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  if (pimpl_ != nullptr)
+    return BIO_get_ktls_recv(SSL_get_rbio(native(pimpl_))) != 0;
+#endif
+  return false;
+}
+
 } // namespace caf::net::ssl
@@ -86,6 +86,14 @@ public:
   /// Returns the file descriptor for this connection.
   stream_socket fd() const noexcept;
 
+  /// Checks whether the kernel encrypts outgoing records for this connection.
+  /// @note Requires calling `context::enable_ktls` before the handshake.
+  bool ktls_send_enabled() const noexcept;
+
+  /// Checks whether the kernel decrypts incoming records for this connection.
+  /// @note Requires calling `context::enable_ktls` before the handshake.
+  bool ktls_recv_enabled() const noexcept;
+
   bool valid() const noexcept {
     return pimpl_ != nullptr;
   }
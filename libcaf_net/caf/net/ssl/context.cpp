@@ -8,6 +8,13 @@
 
 #include "caf/config.hpp"
 #include "caf/expected.hpp"
+#include "caf/ipv6_address.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 CAF_PUSH_WARNINGS
 #include <openssl/err.h>
@@ -22,11 +29,107 @@ auto native(context::impl* ptr) {
   return reinterpret_cast<SSL_CTX*>(ptr);
 }
 
+/// Caches client sessions per host and port. The cache belongs to the
+/// `SSL_CTX`, because OpenSSL may call the new-session callback as long as any
+/// connection refers to the native context, i.e., possibly after destroying
+/// the `context` object that created the connection.
+struct session_cache {
+  ~session_cache() {
+    for (auto& kvp : sessions)
+      SSL_SESSION_free(kvp.second);
+  }
+
+  /// Stores `sess` as the most recent session for `key`.
+  /// @returns `true` if the cache took ownership of `sess`.
+  bool store(const std::string& key, SSL_SESSION* sess) {
+    std::lock_guard guard{mtx};
+    if (max_sessions == 0)
+      return false;
+    if (auto i = sessions.find(key); i != sessions.end()) {
+      SSL_SESSION_free(i->second);
+      i->second = sess;
+      return true;
+    }
+    if (sessions.size() >= max_sessions) {
+      // Make room for the new session by dropping an arbitrary one.
+      auto i = sessions.begin();
+      SSL_SESSION_free(i->second);
+      sessions.erase(i);
+    }
+    sessions.emplace(key, sess);
+    return true;
+  }
+
+  /// Offers the most recent session for `key` to `ssl`.
+  void resume(SSL* ssl, const std::string& key) {
+    std::lock_guard guard{mtx};
+    auto i = sessions.find(key);
+    if (i == sessions.end())
+      return;
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    // OpenSSL marks sessions as non-resumable, e.g., after an unclean shutdown
+    // of the connection.
+    if (SSL_SESSION_is_resumable(i->second) == 0) {
+      SSL_SESSION_free(i->second);
+      sessions.erase(i);
+      return;
+    }
+#endif
+    SSL_set_session(ssl, i->second);
+  }
+
+  /// Guards all member variables, because multiple threads may use the same
+  /// native context.
+  std::mutex mtx;
+
+  /// Configures how many client sessions we store at most.
+  size_t max_sessions = 0;
+
+  /// Maps host and port to the most recent client session.
+  std::unordered_map<std::string, SSL_SESSION*> sessions;
+};
+
+void free_session_cache(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+  delete static_cast<session_cache*>(ptr);
+}
+
+void free_session_key(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+  delete static_cast<std::string*>(ptr);
+}
+
+/// Returns the index for storing the @ref session_cache of an `SSL_CTX`.
+int session_cache_index() {
+  static int result = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr,
+                                               free_session_cache);
+  return result;
+}
+
+/// Returns the index for storing the session key of an `SSL` object.
+int session_key_index() {
+  static int result = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr,
+                                           free_session_key);
+  return result;
+}
+
+session_cache* get_session_cache(SSL_CTX* ctx) {
+  return static_cast<session_cache*>(
+    SSL_CTX_get_ex_data(ctx, session_cache_index()));
+}
+
+// Returns whether `host` is an IPv4 or IPv6 address.
+bool is_ip_address(std::string_view host) {
+  ipv6_address addr;
+  if (host.size() > 2 && host.front() == '[' && host.back() == ']')
+    host = host.substr(1, host.size() - 2);
+  return !parse(host, addr);
+}
+
 } // namespace
 
 // -- member types -------------------------------------------------------------
 
 struct context::user_data {
+  /// Callback for reading the password of encrypted PEM files.
   password::callback_ptr pw_callback;
 };
 
@@ -171,6 +274,15 @@ expected<context> context::make_client(dtls vmin, dtls vmax) {
 
 // -- properties ---------------------------------------------------------------
 
+bool context::enable_ktls() noexcept {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+  SSL_CTX_set_options(native(pimpl_), SSL_OP_ENABLE_KTLS);
+  return true;
+#else
+  return false;
+#endif
+}
+
 void context::verify_mode(verify_t flags) {
   auto ptr = native(pimpl_);
   SSL_CTX_set_verify(ptr, to_integer(flags), SSL_CTX_get_verify_callback(ptr));
@@ -197,6 +309,67 @@ void context::password_callback_impl(password::callback_ptr callback) {
   SSL_CTX_set_default_passwd_cb_userdata(ptr, data_->pw_callback.get());
 }
 
+// -- session resumption -------------------------------------------------------
+
+bool context::enable_session_cache(size_t max_sessions, timespan timeout) {
+  ERR_clear_error();
+  auto ptr = native(pimpl_);
+  auto* cache = get_session_cache(ptr);
+  if (cache == nullptr) {
+    auto index = session_cache_index();
+    if (index < 0)
+      return false;
+    cache = new session_cache;
+    if (SSL_CTX_set_ex_data(ptr, index, cache) != 1) {
+      delete cache;
+      return false;
+    }
+  }
+  {
+    std::lock_guard guard{cache->mtx};
+    cache->max_sessions = max_sessions;
+  }
+  // Clients manage their sessions in a `session_cache`, since OpenSSL cannot
+  // know which session to offer for a new connection.
+  auto mode = SSL_SESS_CACHE_BOTH;
+  if (auto method = SSL_CTX_get_ssl_method(ptr);
+      method == CAF_TLS_METHOD(_client_) || method == DTLS_client_method())
+    mode = SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE;
+  SSL_CTX_set_session_cache_mode(ptr, mode);
+  SSL_CTX_sess_set_cache_size(ptr, static_cast<long>(max_sessions));
+  using std::chrono::seconds;
+  auto secs = std::max(std::chrono::duration_cast<seconds>(timeout),
+                       seconds{1});
+  SSL_CTX_set_timeout(ptr, static_cast<long>(secs.count()));
+  SSL_CTX_sess_set_new_cb(ptr, [](SSL* ssl, SSL_SESSION* sess) -> int {
+    if (SSL_is_server(ssl))
+      return 0;
+    auto* key = static_cast<std::string*>(
+      SSL_get_ex_data(ssl, session_key_index()));
+    auto* cache = get_session_cache(SSL_get_SSL_CTX(ssl));
+    return key != nullptr && cache != nullptr && cache->store(*key, sess) ? 1
+                                                                          : 0;
+  });
+  // Servers only resume sessions of clients with the same ID context.
+  static constexpr std::string_view sid_ctx = "caf.net.ssl";
+  return SSL_CTX_set_session_id_context(
+           ptr, reinterpret_cast<const unsigned char*>(sid_ctx.data()),
+           static_cast<unsigned>(sid_ctx.size()))
+         == 1;
+}
+
+size_t context::session_cache_hits() const noexcept {
+  return static_cast<size_t>(SSL_CTX_sess_hits(native(pimpl_)));
+}
+
+size_t context::session_cache_misses() const noexcept {
+  auto ptr = native(pimpl_);
+  auto handshakes = SSL_CTX_sess_connect_good(ptr)
+                    + SSL_CTX_sess_accept_good(ptr);
+  auto hits = SSL_CTX_sess_hits(ptr);
+  return handshakes > hits ? static_cast<size_t>(handshakes - hits) : 0;
+}
+
 // -- native handles -----------------------------------------------------------
 
 context context::from_native(void* native_handle) {
@@ -278,7 +451,6 @@ expected<connection> context::new_connection(stream_socket fd) {
     auto conn = connection::from_native(ptr);
     if (auto bio_ptr = BIO_new_socket(fd.id, BIO_NOCLOSE)) {
       SSL_set_bio(ptr, bio_ptr, bio_ptr);
-
       return {std::move(conn)};
     } else {
       return {make_error(sec::logic_error, "BIO_new_socket failed")};
@@ -292,16 +464,43 @@ expected<connection> context::new_connection(stream_socket fd,
                                              close_on_shutdown_t) {
   if (auto ptr = SSL_new(native(pimpl_))) {
     auto conn = connection::from_native(ptr);
-    if (SSL_set_fd(ptr, fd.id) == 1)
+    if (SSL_set_fd(ptr, fd.id) == 1) {
       return {std::move(conn)};
-    else
+    } else {
       return {make_error(sec::logic_error, "SSL_set_fd failed")};
-
+    }
   } else {
     return {make_error(sec::logic_error, "SSL_new returned null")};
   }
 }
 
+expected<connection> context::new_connection(stream_socket fd,
+                                             std::string_view host,
+                                             uint16_t port) {
+  auto conn = new_connection(fd);
+  if (!conn)
+    return conn;
+  // Only clients resume sessions. Hence, the SSL object must not default to
+  // server mode for contexts that support both roles.
+  auto ptr = static_cast<SSL*>(conn->native_handle());
+  SSL_set_connect_state(ptr);
+  if (!host.empty() && !is_ip_address(host)) {
+    std::string sni{host};
+    if (SSL_set_tlsext_host_name(ptr, sni.c_str()) != 1)
+      return {make_error(sec::logic_error, "SSL_set_tlsext_host_name failed")};
+  }
+  auto* cache = get_session_cache(native(pimpl_));
+  if (cache == nullptr)
+    return conn;
+  auto key = std::make_unique<std::string>(host);
+  *key += ':';
+  *key += std::to_string(port);
+  cache->resume(ptr, *key);
+  if (SSL_set_ex_data(ptr, session_key_index(), key.get()) == 1)
+    key.release();
+  return conn;
+}
+
 // -- certificates and keys ----------------------------------------------------
 
 bool context::enable_default_verify_paths() {
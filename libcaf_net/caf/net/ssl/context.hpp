@@ -15,11 +15,15 @@
 #include "caf/net/ssl/verify.hpp"
 #include "caf/net/stream_socket.hpp"
 
+#include "caf/defaults.hpp"
 #include "caf/detail/net_export.hpp"
 #include "caf/expected.hpp"
+#include "caf/timespan.hpp"
 
+#include <cstdint>
 #include <cstring>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 namespace caf::net::ssl {
@@ -96,6 +100,16 @@ public:
   /// @note calls @c SSL_CTX_set_verify
   void verify_mode(verify_t flags);
 
+  /// Asks OpenSSL to hand record encryption over to the kernel (kTLS) after
+  /// completing the handshake. Connections silently fall back to encrypting in
+  /// user space if the kernel lacks the `tls` module or does not support the
+  /// negotiated cipher. See `connection::ktls_send_enabled` and
+  /// `connection::ktls_recv_enabled` for checking the result.
+  /// @returns `true` if OpenSSL supports kTLS on this platform, `false`
+  ///          otherwise.
+  /// @note calls @c SSL_CTX_set_options with @c SSL_OP_ENABLE_KTLS
+  bool enable_ktls() noexcept;
+
   /// Overrides the callback to obtain the password for encrypted PEM files.
   /// @note calls @c SSL_CTX_set_default_passwd_cb
   template <typename PasswordCallback>
@@ -116,6 +130,28 @@ public:
     password_callback(std::move(cb));
   }
 
+  // -- session resumption -----------------------------------------------------
+
+  /// Enables caching of SSL sessions for abbreviated handshakes. Servers keep
+  /// up to `max_sessions` sessions in memory and issue session tickets to
+  /// clients. Clients store the most recent session per host and port and
+  /// offer it when connecting to the same server again (see the overload of
+  /// `new_connection` that takes a host name). This works for TLS 1.2 session
+  /// IDs as well as TLS 1.3 session tickets.
+  /// @param max_sessions The maximum number of sessions in the cache.
+  /// @param timeout The time until a session can no longer be resumed.
+  /// @returns `true` on success, `false` otherwise and `last_error` can be used
+  ///          to retrieve a human-readable error representation.
+  [[nodiscard]] bool enable_session_cache(size_t max_sessions,
+                                          timespan timeout);
+
+  /// Returns the number of handshakes that resumed a previous session.
+  size_t session_cache_hits() const noexcept;
+
+  /// Returns the number of completed handshakes that did not resume a previous
+  /// session.
+  size_t session_cache_misses() const noexcept;
+
   // -- native handles ---------------------------------------------------------
 
   /// Reinterprets `native_handle` as the native implementation type and takes
@@ -171,6 +207,13 @@ public:
   /// the socket, i.e., closes the socket when the SSL session ends.
   expected<connection> new_connection(stream_socket fd, close_on_shutdown_t);
 
+  /// Creates a new SSL client connection on `fd` to `host` at `port`. Sets the
+  /// server name indication (SNI) unless `host` is an IP address and offers
+  /// the most recent session for `host` and `port` when the session cache is
+  /// enabled. The connection does not take ownership of the socket.
+  expected<connection> new_connection(stream_socket fd, std::string_view host,
+                                      uint16_t port);
+
   // -- certificates and keys --------------------------------------------------
 
   /// Configure the context to use the default locations for loading CA
@@ -411,6 +454,29 @@ inline auto load_verify_file_if(dsl::arg::cstring path) {
   };
 }
 
+/// Enables caching of SSL sessions for abbreviated handshakes.
+/// @param max_sessions The maximum number of sessions in the cache.
+/// @param timeout The time until a session can no longer be resumed.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto enable_session_cache(
+  size_t max_sessions = defaults::net::ssl_session_cache_size,
+  timespan timeout = defaults::net::ssl_session_timeout) {
+  return [max_sessions, timeout](context ctx) {
+    return detail::ssl_ctx_chain(ctx, "enable_session_cache failed",
+                                 ctx.enable_session_cache(max_sessions,
+                                                          timeout));
+  };
+}
+
+/// Enables kernel TLS offloading if available. Otherwise, does nothing.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto enable_ktls() {
+  return [](context ctx) -> expected<context> {
+    ctx.enable_ktls();
+    return ctx;
+  };
+}
+
 /// @param password the stream socket for adding encryption.
 /// @returns a function object for chaining `expected<T>::and_then()`.
 inline auto use_password(dsl::arg::cstring password) {
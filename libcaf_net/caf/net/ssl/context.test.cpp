@@ -0,0 +1,163 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/ssl/context.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/net/socket_guard.hpp"
+#include "caf/net/ssl/connection.hpp"
+#include "caf/net/tcp_accept_socket.hpp"
+#include "caf/net/tcp_stream_socket.hpp"
+
+#include "caf/config.hpp"
+#include "caf/raise_error.hpp"
+
+#include <string_view>
+#include <thread>
+
+CAF_PUSH_WARNINGS
+#include <openssl/ssl.h>
+CAF_POP_WARNINGS
+
+using namespace caf;
+
+namespace {
+
+// Uses anonymous cipher suites to avoid the need for certificates. This limits
+// the test to TLS 1.2, since TLS 1.3 always requires authentication.
+net::ssl::context make_ctx(bool server) {
+  auto ctx = server ? net::ssl::context::make_server(net::ssl::tls::v1_2,
+                                                     net::ssl::tls::v1_2)
+                    : net::ssl::context::make_client(net::ssl::tls::v1_2,
+                                                     net::ssl::tls::v1_2);
+  if (!ctx)
+    CAF_RAISE_ERROR("failed to create an SSL context");
+  auto native = static_cast<SSL_CTX*>(ctx->native_handle());
+  if (SSL_CTX_set_cipher_list(native, "aNULL:@SECLEVEL=0") != 1)
+    CAF_RAISE_ERROR("failed to select anonymous cipher suites");
+  return std::move(*ctx);
+}
+
+struct fixture {
+  fixture()
+    : server_ctx(make_ctx(true)), client_ctx(make_ctx(false)), port(0) {
+    auto acceptor = net::make_tcp_accept_socket(0, "127.0.0.1");
+    if (!acceptor)
+      CAF_RAISE_ERROR("failed to open an accept socket");
+    fd = *acceptor;
+    auto maybe_port = net::local_port(fd);
+    if (!maybe_port)
+      CAF_RAISE_ERROR("failed to retrieve the port of the accept socket");
+    port = *maybe_port;
+  }
+
+  ~fixture() {
+    net::close(fd);
+  }
+
+  // Connects to the server, performs the SSL handshake and exchanges a single
+  // byte before closing the connection gracefully. Returns whether the client
+  // has resumed a previous session.
+  bool round_trip(std::string_view host = "localhost") {
+    return round_trip_with([this, host](net::stream_socket fd) {
+      return client_ctx.new_connection(fd, host, port);
+    });
+  }
+
+  // Like `round_trip`, but uses `make_conn` for creating the client connection.
+  template <class MakeConnection>
+  bool round_trip_with(MakeConnection make_conn) {
+    auto server = std::thread{[this] {
+      auto conn = net::accept(fd);
+      if (!conn)
+        return;
+      auto guard = net::make_socket_guard(*conn);
+      auto ssl_conn = server_ctx.new_connection(*conn);
+      if (!ssl_conn || ssl_conn->accept() <= 0)
+        return;
+      auto buf = std::byte{42};
+      std::ignore = ssl_conn->write(make_span(&buf, 1));
+      std::ignore = ssl_conn->close();
+    }};
+    auto resumed = false;
+    if (auto conn = net::make_connected_tcp_stream_socket("127.0.0.1", port)) {
+      auto guard = net::make_socket_guard(*conn);
+      auto ssl_conn = make_conn(*conn);
+      if (ssl_conn && ssl_conn->connect() > 0) {
+        auto buf = std::byte{0};
+        std::ignore = ssl_conn->read(make_span(&buf, 1));
+        auto native = static_cast<SSL*>(ssl_conn->native_handle());
+        resumed = SSL_session_reused(native) == 1;
+        std::ignore = ssl_conn->close();
+      }
+    }
+    server.join();
+    return resumed;
+  }
+
+  net::ssl::context server_ctx;
+  net::ssl::context client_ctx;
+  net::tcp_accept_socket fd;
+  uint16_t port;
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("clients resume sessions when enabling the session cache") {
+  require(server_ctx.enable_session_cache(16, std::chrono::seconds{60}));
+  require(client_ctx.enable_session_cache(16, std::chrono::seconds{60}));
+  check(!round_trip());
+  check(round_trip());
+  check(round_trip());
+  check_eq(client_ctx.session_cache_hits(), 2u);
+  check_eq(client_ctx.session_cache_misses(), 1u);
+  check_eq(server_ctx.session_cache_hits(), 2u);
+  check_eq(server_ctx.session_cache_misses(), 1u);
+}
+
+TEST("clients perform full handshakes without a session cache") {
+  check(!round_trip());
+  check(!round_trip());
+  check_eq(client_ctx.session_cache_hits(), 0u);
+  check_eq(client_ctx.session_cache_misses(), 2u);
+}
+
+TEST("clients resume sessions only for the same host and port") {
+  require(server_ctx.enable_session_cache(16, std::chrono::seconds{60}));
+  require(client_ctx.enable_session_cache(16, std::chrono::seconds{60}));
+  check(!round_trip("localhost"));
+  check(!round_trip("127.0.0.1"));
+  check(round_trip("localhost"));
+  check(round_trip("127.0.0.1"));
+}
+
+TEST("clients resume sessions only when passing a host name") {
+  require(server_ctx.enable_session_cache(16, std::chrono::seconds{60}));
+  require(client_ctx.enable_session_cache(16, std::chrono::seconds{60}));
+  auto without_host = [this](net::stream_socket fd) {
+    return client_ctx.new_connection(fd);
+  };
+  check(!round_trip());
+  check(!round_trip_with(without_host));
+  check(round_trip());
+}
+
+TEST("the session cache may outlive the context") {
+  require(server_ctx.enable_session_cache(16, std::chrono::seconds{60}));
+  // OpenSSL stores new sessions after the handshake, i.e., after destroying
+  // the context that created the connection.
+  auto make_conn = [this](net::stream_socket fd) {
+    auto ctx = make_ctx(false);
+    if (!ctx.enable_session_cache(16, std::chrono::seconds{60}))
+      CAF_RAISE_ERROR("failed to enable the session cache");
+    return ctx.new_connection(fd, "localhost", port);
+  };
+  check(!round_trip_with(make_conn));
+  check(!round_trip_with(make_conn));
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
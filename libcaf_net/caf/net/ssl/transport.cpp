@@ -7,6 +7,7 @@
 #include "caf/net/octet_stream/errc.hpp"
 #include "caf/net/socket_manager.hpp"
 #include "caf/net/ssl/connection.hpp"
+#include "caf/net/stream_socket.hpp"
 
 #include "caf/error.hpp"
 
@@ -19,10 +20,16 @@ namespace caf::net::ssl {
 
 namespace {
 
+/// Reads and writes through OpenSSL. Once the handshake has completed and
+/// OpenSSL has handed the send direction to the kernel (kTLS), the policy
+/// writes directly to the socket, because the kernel already takes care of
+/// encrypting the records. Reading always goes through OpenSSL, since the
+/// kernel passes non-data records such as TLS 1.3 session tickets to user
+/// space as control messages.
 class policy_impl : public octet_stream::policy {
 public:
   explicit policy_impl(connection conn) : conn(std::move(conn)) {
-    // nop
+    update_send_mode();
   }
 
   stream_socket handle() const override {
@@ -30,14 +37,35 @@ public:
   }
 
   ptrdiff_t read(byte_span buf) override {
-    return conn.read(buf);
+    writing_ = false;
+    auto res = conn.read(buf);
+    // Reading may complete a pending handshake.
+    update_send_mode();
+    return res;
   }
 
   ptrdiff_t write(const_byte_span buf) override {
-    return conn.write(buf);
+    writing_ = true;
+    if (send_mode_ == send_mode::kernel)
+      return net::write(conn.fd(), buf);
+    auto res = conn.write(buf);
+    update_send_mode();
+    return res;
+  }
+
+  ptrdiff_t writev(span<const const_byte_span> bufs) override {
+    writing_ = true;
+    if (send_mode_ == send_mode::kernel)
+      return net::write(conn.fd(), bufs);
+    return policy::writev(bufs);
   }
 
   octet_stream::errc last_error(ptrdiff_t ret) override {
+    // OpenSSL knows nothing about writes that bypass it, so we need to consult
+    // errno in this case.
+    if (writing_ && send_mode_ == send_mode::kernel)
+      return last_socket_error_is_temporary() ? octet_stream::errc::temporary
+                                              : octet_stream::errc::permanent;
     switch (conn.last_error(ret)) {
       case errc::none:
       case errc::want_accept:
@@ -60,11 +88,17 @@ public:
   }
 
   ptrdiff_t connect() override {
-    return conn.connect();
+    writing_ = false;
+    auto res = conn.connect();
+    update_send_mode();
+    return res;
   }
 
   ptrdiff_t accept() override {
-    return conn.accept();
+    writing_ = false;
+    auto res = conn.accept();
+    update_send_mode();
+    return res;
   }
 
   size_t buffered() const noexcept override {
@@ -72,6 +106,35 @@ public:
   }
 
   connection conn;
+
+private:
+  enum class send_mode {
+    /// The handshake is still in progress.
+    pending,
+    /// OpenSSL encrypts outgoing data.
+    user_space,
+    /// The kernel encrypts outgoing data.
+    kernel,
+  };
+
+  /// Selects how to send data once the handshake has completed, because
+  /// OpenSSL can only enable kTLS after negotiating the keys. The transport
+  /// usually completes the handshake lazily as part of reading or writing.
+  void update_send_mode() {
+    if (send_mode_ != send_mode::pending)
+      return;
+    auto* ssl = static_cast<SSL*>(conn.native_handle());
+    if (ssl == nullptr || SSL_is_init_finished(ssl) == 0)
+      return;
+    send_mode_ = conn.ktls_send_enabled() ? send_mode::kernel
+                                          : send_mode::user_space;
+  }
+
+  /// Stores how the policy sends data.
+  send_mode send_mode_ = send_mode::pending;
+
+  /// Stores whether the last operation was a write.
+  bool writing_ = false;
 };
 
 /// Calls `connect` or `accept` until it succeeds or fails. On success, the
@@ -0,0 +1,164 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/ssl/transport.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/octet_stream/with.hpp"
+#include "caf/net/ssl/context.hpp"
+#include "caf/net/tcp_accept_socket.hpp"
+#include "caf/net/tcp_stream_socket.hpp"
+
+#include "caf/config.hpp"
+#include "caf/detail/latch.hpp"
+#include "caf/flow/observable_builder.hpp"
+#include "caf/flow/scoped_coordinator.hpp"
+#include "caf/raise_error.hpp"
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+CAF_PUSH_WARNINGS
+#include <openssl/ssl.h>
+CAF_POP_WARNINGS
+
+using namespace caf;
+
+namespace {
+
+constexpr size_t num_bytes = 256 * 1024;
+
+// Uses anonymous cipher suites to avoid the need for certificates. This limits
+// the test to TLS 1.2, since TLS 1.3 always requires authentication.
+net::ssl::context make_ctx(bool server) {
+  auto ctx = server ? net::ssl::context::make_server(net::ssl::tls::v1_2,
+                                                     net::ssl::tls::v1_2)
+                    : net::ssl::context::make_client(net::ssl::tls::v1_2,
+                                                     net::ssl::tls::v1_2);
+  if (!ctx)
+    CAF_RAISE_ERROR("failed to create an SSL context");
+  auto native = static_cast<SSL_CTX*>(ctx->native_handle());
+  if (SSL_CTX_set_cipher_list(native, "aNULL:@SECLEVEL=0") != 1)
+    CAF_RAISE_ERROR("failed to select anonymous cipher suites");
+  // Falls back to encrypting in user space if the platform lacks kTLS.
+  std::ignore = ctx->enable_ktls();
+  return std::move(*ctx);
+}
+
+// Returns how many sockets used kTLS with software encryption for sending or
+// -1 if the kernel does not support kTLS.
+int64_t ktls_tx_sockets() {
+  std::ifstream in{"/proc/net/tls_stat"};
+  std::string key;
+  int64_t value = 0;
+  while (in >> key >> value)
+    if (key == "TlsTxSw")
+      return value;
+  return -1;
+}
+
+struct fixture {
+  fixture() {
+    mpx = net::multiplexer::make(nullptr);
+    std::ignore = mpx->init();
+    mpx_thread = std::thread{[mpx = mpx] {
+      mpx->set_thread_id();
+      mpx->run();
+    }};
+  }
+
+  ~fixture() {
+    mpx->shutdown();
+    mpx_thread.join();
+  }
+
+  net::multiplexer_ptr mpx;
+  std::thread mpx_thread;
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("the SSL transport transfers data with kTLS enabled") {
+  auto tx_before = ktls_tx_sockets();
+  // Start an echo server with the server factory.
+  auto acceptor = net::make_tcp_accept_socket(0, "127.0.0.1");
+  require(acceptor.has_value());
+  auto port = net::local_port(*acceptor);
+  require(port.has_value());
+  auto server_worker = std::thread{};
+  auto server
+    = net::octet_stream::with(mpx.get())
+        .context(make_ctx(true))
+        .accept(*acceptor)
+        .start([&server_worker](net::acceptor_resource<std::byte> events) {
+          server_worker = std::thread{[events] {
+            auto self = flow::scoped_coordinator::make();
+            events.observe_on(self.get()).take(1).for_each(
+              [ptr = self.get()](const net::accept_event<std::byte>& ev) {
+                auto [pull, push] = ev.data();
+                pull.observe_on(ptr).subscribe(push);
+              });
+            self->run();
+          }};
+        });
+  require(server.has_value());
+  // Connect to the server with the client factory and send the payload.
+  auto fd = net::make_connected_tcp_stream_socket("127.0.0.1", *port);
+  require(fd.has_value());
+  auto received = std::make_shared<std::vector<std::byte>>();
+  auto rendezvous = std::make_shared<detail::latch>(2);
+  auto client_worker = std::thread{};
+  auto client
+    = net::octet_stream::with(mpx.get())
+        .context(make_ctx(false))
+        .connect(*fd)
+        .start([received, rendezvous, &client_worker](auto pull, auto push) {
+          client_worker = std::thread{[pull, push, received, rendezvous] {
+            auto self = flow::scoped_coordinator::make();
+            self->make_observable()
+              .iota(size_t{0}) //
+              .take(num_bytes)
+              .map([](size_t x) { return static_cast<std::byte>(x % 251); })
+              .subscribe(push);
+            // Note: the flow may call on_complete before delivering the last
+            //       item to for_each. Hence, we count down after receiving the
+            //       last item or on error.
+            pull.observe_on(self.get())
+              .take(num_bytes)
+              .for_each(
+                [received, rendezvous](std::byte x) {
+                  received->push_back(x);
+                  if (received->size() == num_bytes)
+                    rendezvous->count_down();
+                },
+                [rendezvous](const error&) { rendezvous->count_down(); });
+            self->run();
+          }};
+        });
+  require(client.has_value());
+  // Check the results.
+  rendezvous->count_down_and_wait();
+  require_eq(received->size(), num_bytes);
+  auto corrupted = size_t{0};
+  for (size_t i = 0; i < num_bytes; ++i)
+    if ((*received)[i] != static_cast<std::byte>(i % 251))
+      ++corrupted;
+  check_eq(corrupted, 0u);
+  // If the kernel supports kTLS, OpenSSL must have handed over the send
+  // direction of both connections after the handshake.
+  if (tx_before >= 0)
+    check_ge(ktls_tx_sockets(), tx_before + 2);
+  // Cleanup.
+  server->dispose();
+  client_worker.join();
+  server_worker.join();
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
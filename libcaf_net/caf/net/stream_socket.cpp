@@ -15,7 +15,10 @@
 #include "caf/log/net.hpp"
 #include "caf/span.hpp"
 
+#include <algorithm>
+#include <climits>
 #include <cstddef>
+#include <cstring>
 
 #ifdef CAF_POSIX
 #  include <sys/uio.h>
@@ -169,33 +172,48 @@ ptrdiff_t write(stream_socket x, const_byte_span buf) {
 
 #ifdef CAF_WINDOWS
 
-ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
-  CAF_ASSERT(bufs.size() < 10);
-  WSABUF buf_array[10];
+ptrdiff_t write(stream_socket x, span<const const_byte_span> bufs) {
+  WSABUF buf_array[max_write_buffers];
   auto convert = [](const_byte_span buf) {
     auto data = const_cast<std::byte*>(buf.data());
     return WSABUF{static_cast<ULONG>(buf.size()),
                   reinterpret_cast<CHAR*>(data)};
   };
-  std::transform(bufs.begin(), bufs.end(), std::begin(buf_array), convert);
+  auto num_bufs = std::min(bufs.size(), max_write_buffers);
+  std::transform(bufs.begin(), bufs.begin() + num_bufs, std::begin(buf_array),
+                 convert);
   DWORD bytes_sent = 0;
-  auto res = WSASend(x.id, buf_array, static_cast<DWORD>(bufs.size()),
+  auto res = WSASend(x.id, buf_array, static_cast<DWORD>(num_bufs),
                      &bytes_sent, 0, nullptr, nullptr);
   return (res == 0) ? bytes_sent : -1;
 }
 
 #else // CAF_WINDOWS
 
-ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
-  CAF_ASSERT(bufs.size() < 10);
-  iovec buf_array[10];
+#  ifdef IOV_MAX
+static_assert(max_write_buffers <= IOV_MAX);
+#  endif
+
+ptrdiff_t write(stream_socket x, span<const const_byte_span> bufs) {
+  iovec buf_array[max_write_buffers];
   auto convert = [](const_byte_span buf) {
     return iovec{const_cast<std::byte*>(buf.data()), buf.size()};
   };
-  std::transform(bufs.begin(), bufs.end(), std::begin(buf_array), convert);
-  return writev(x.id, buf_array, static_cast<int>(bufs.size()));
+  auto num_bufs = std::min(bufs.size(), max_write_buffers);
+  std::transform(bufs.begin(), bufs.begin() + num_bufs, std::begin(buf_array),
+                 convert);
+  // Use sendmsg instead of writev to suppress SIGPIPE on Linux.
+  msghdr msg;
+  memset(&msg, 0, sizeof(msghdr));
+  msg.msg_iov = buf_array;
+  msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(num_bufs);
+  return ::sendmsg(x.id, &msg, no_sigpipe_io_flag);
 }
 
 #endif // CAF_WINDOWS
 
+ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
+  return write(x, make_span(bufs.begin(), bufs.size()));
+}
+
 } // namespace caf::net
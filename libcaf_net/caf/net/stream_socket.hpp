@@ -68,15 +68,30 @@ ptrdiff_t CAF_NET_EXPORT read(stream_socket x, byte_span buf);
 /// @post either the result is a `sec` or a positive (non-zero) integer
 ptrdiff_t CAF_NET_EXPORT write(stream_socket x, const_byte_span buf);
 
+/// The maximum number of buffers that a single call to `write` passes to the
+/// operating system. Passing more buffers has the same effect as a partial
+/// write, i.e., the caller needs to write the remaining data later.
+/// @relates stream_socket
+constexpr size_t max_write_buffers = 16;
+
 /// Transmits data from `x` to its peer.
 /// @param x A connected endpoint.
-/// @param bufs Points to the message to send, scattered across up to 10
-///             buffers.
+/// @param bufs Points to the message to send, scattered across multiple
+///             buffers. Writes at most the first `max_write_buffers` buffers.
 /// @returns The number of written bytes on success, otherwise an error code.
 /// @relates stream_socket
 /// @post either the result is a `sec` or a positive (non-zero) integer
-/// @pre `bufs.size() < 10`
 ptrdiff_t CAF_NET_EXPORT write(stream_socket x,
                                std::initializer_list<const_byte_span> bufs);
 
+/// Transmits data from `x` to its peer.
+/// @param x A connected endpoint.
+/// @param bufs Points to the message to send, scattered across multiple
+///             buffers. Writes at most the first `max_write_buffers` buffers.
+/// @returns The number of written bytes on success, otherwise an error code.
+/// @relates stream_socket
+/// @post either the result is a `sec` or a positive (non-zero) integer
+ptrdiff_t CAF_NET_EXPORT write(stream_socket x,
+                               span<const const_byte_span> bufs);
+
 } // namespace caf::net
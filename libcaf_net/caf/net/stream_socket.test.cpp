@@ -10,6 +10,8 @@
 #include "caf/log/test.hpp"
 #include "caf/span.hpp"
 
+#include <vector>
+
 using namespace caf;
 using namespace caf::net;
 
@@ -102,6 +104,20 @@ TEST("transfer data using multiple buffers") {
   check(std::equal(full_buf.begin(), full_buf.end(), rd_buf.begin()));
 }
 
+TEST("writing more than max_write_buffers buffers writes a prefix") {
+  auto num_bufs = max_write_buffers + 4;
+  std::vector<byte_buffer> wr_bufs;
+  std::vector<const_byte_span> bufs;
+  for (size_t i = 0; i < num_bufs; ++i)
+    wr_bufs.emplace_back(1, static_cast<std::byte>(i));
+  for (auto& buf : wr_bufs)
+    bufs.emplace_back(buf);
+  check_eq(static_cast<size_t>(write(second, bufs)), max_write_buffers);
+  check_eq(static_cast<size_t>(read(first, rd_buf)), max_write_buffers);
+  for (size_t i = 0; i < max_write_buffers; ++i)
+    check_eq(rd_buf[i], static_cast<std::byte>(i));
+}
+
 } // WITH_FIXTURE(fixture)
 
 } // namespace
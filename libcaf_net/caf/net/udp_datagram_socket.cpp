@@ -15,6 +15,9 @@
 #include "caf/log/net.hpp"
 #include "caf/span.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace {
 
 #if defined(CAF_WINDOWS) || defined(CAF_MACOS) || defined(CAF_IOS)             \
@@ -111,4 +114,215 @@ ptrdiff_t write(udp_datagram_socket x, const_byte_span buf, ip_endpoint ep) {
                   static_cast<socklen_t>(len));
 }
 
+// -- udp_datagram_batch -------------------------------------------------------
+
+struct udp_datagram_batch::impl {
+  impl(size_t capacity, size_t max_datagram_size)
+    : capacity(capacity),
+      max_datagram_size(max_datagram_size),
+      storage(capacity * max_datagram_size),
+      sizes(capacity),
+      endpoints(capacity),
+      addrs(capacity) {
+#ifdef CAF_LINUX
+    hdrs.resize(capacity);
+    iovs.resize(capacity);
+#endif
+  }
+
+  /// Maps a position in the batch to the index of its slot.
+  size_t slot_index(size_t pos) const noexcept {
+    return (head + pos) % capacity;
+  }
+
+  /// Returns the buffer of the slot at `index`.
+  std::byte* slot_data(size_t index) noexcept {
+    return storage.data() + index * max_datagram_size;
+  }
+
+  /// Returns the length of the socket address for `ep`.
+  static socklen_t addr_len(const ip_endpoint& ep) noexcept {
+    return ep.address().embeds_v4() ? sizeof(sockaddr_in)
+                                    : sizeof(sockaddr_in6);
+  }
+
+  size_t capacity;
+
+  size_t max_datagram_size;
+
+  /// Points to the slot of the first datagram in the batch.
+  size_t head = 0;
+
+  /// Stores the number of datagrams in the batch.
+  size_t size = 0;
+
+  /// Stores the payload of all slots in a single, contiguous buffer.
+  byte_buffer storage;
+
+  /// Stores the payload size for each slot.
+  std::vector<size_t> sizes;
+
+  /// Stores the sender or receiver for each slot.
+  std::vector<ip_endpoint> endpoints;
+
+  /// Stores the socket address for each slot.
+  std::vector<sockaddr_storage> addrs;
+
+#ifdef CAF_LINUX
+  /// Stores the message headers for `recvmmsg` and `sendmmsg`.
+  std::vector<mmsghdr> hdrs;
+
+  /// Stores the I/O vectors for the message headers.
+  std::vector<iovec> iovs;
+#endif
+};
+
+udp_datagram_batch::udp_datagram_batch(size_t capacity,
+                                       size_t max_datagram_size)
+  : impl_(std::make_unique<impl>(capacity, max_datagram_size)) {
+  // nop
+}
+
+udp_datagram_batch::udp_datagram_batch(udp_datagram_batch&&) noexcept
+  = default;
+
+udp_datagram_batch&
+udp_datagram_batch::operator=(udp_datagram_batch&&) noexcept = default;
+
+udp_datagram_batch::~udp_datagram_batch() {
+  // nop
+}
+
+size_t udp_datagram_batch::size() const noexcept {
+  return impl_->size;
+}
+
+size_t udp_datagram_batch::capacity() const noexcept {
+  return impl_->capacity;
+}
+
+size_t udp_datagram_batch::max_datagram_size() const noexcept {
+  return impl_->max_datagram_size;
+}
+
+const_byte_span udp_datagram_batch::payload(size_t index) const noexcept {
+  auto slot = impl_->slot_index(index);
+  return {impl_->slot_data(slot), impl_->sizes[slot]};
+}
+
+const ip_endpoint& udp_datagram_batch::endpoint(size_t index) const noexcept {
+  return impl_->endpoints[impl_->slot_index(index)];
+}
+
+bool udp_datagram_batch::push_back(const_byte_span payload,
+                                   const ip_endpoint& ep) {
+  if (full() || payload.size() > impl_->max_datagram_size)
+    return false;
+  auto slot = impl_->slot_index(impl_->size++);
+  if (!payload.empty())
+    memcpy(impl_->slot_data(slot), payload.data(), payload.size());
+  impl_->sizes[slot] = payload.size();
+  impl_->endpoints[slot] = ep;
+  convert(ep, impl_->addrs[slot]);
+  return true;
+}
+
+void udp_datagram_batch::pop_front(size_t n) noexcept {
+  n = std::min(n, impl_->size);
+  impl_->head = impl_->slot_index(n);
+  impl_->size -= n;
+}
+
+void udp_datagram_batch::clear() noexcept {
+  impl_->head = 0;
+  impl_->size = 0;
+}
+
+ptrdiff_t read(udp_datagram_socket x, udp_datagram_batch& batch) {
+  auto& st = *batch.impl_;
+  auto num = st.capacity - st.size;
+  if (num == 0)
+    return 0;
+#ifdef CAF_LINUX
+  for (size_t i = 0; i < num; ++i) {
+    auto slot = st.slot_index(st.size + i);
+    st.iovs[i].iov_base = st.slot_data(slot);
+    st.iovs[i].iov_len = st.max_datagram_size;
+    auto& hdr = st.hdrs[i];
+    memset(&hdr, 0, sizeof(mmsghdr));
+    hdr.msg_hdr.msg_name = &st.addrs[slot];
+    hdr.msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_hdr.msg_iov = &st.iovs[i];
+    hdr.msg_hdr.msg_iovlen = 1;
+  }
+  auto res = ::recvmmsg(x.id, st.hdrs.data(), static_cast<unsigned>(num), 0,
+                        nullptr);
+  if (res <= 0)
+    return res;
+  for (int i = 0; i < res; ++i) {
+    auto slot = st.slot_index(st.size + static_cast<size_t>(i));
+    st.sizes[slot] = st.hdrs[i].msg_len;
+    std::ignore = convert(st.addrs[slot], st.endpoints[slot]);
+  }
+  st.size += static_cast<size_t>(res);
+  return res;
+#else
+  auto received = ptrdiff_t{0};
+  while (st.size < st.capacity) {
+    auto slot = st.slot_index(st.size);
+    socklen_t len = sizeof(sockaddr_storage);
+    auto res = ::recvfrom(x.id,
+                          reinterpret_cast<socket_recv_ptr>(st.slot_data(slot)),
+                          st.max_datagram_size, no_sigpipe_io_flag,
+                          reinterpret_cast<sockaddr*>(&st.addrs[slot]), &len);
+    if (res < 0)
+      return received > 0 ? received : res;
+    st.sizes[slot] = std::min(static_cast<size_t>(res), st.max_datagram_size);
+    std::ignore = convert(st.addrs[slot], st.endpoints[slot]);
+    ++st.size;
+    ++received;
+  }
+  return received;
+#endif
+}
+
+ptrdiff_t write(udp_datagram_socket x, udp_datagram_batch& batch) {
+  auto& st = *batch.impl_;
+  if (st.size == 0)
+    return 0;
+#ifdef CAF_LINUX
+  for (size_t i = 0; i < st.size; ++i) {
+    auto slot = st.slot_index(i);
+    st.iovs[i].iov_base = st.slot_data(slot);
+    st.iovs[i].iov_len = st.sizes[slot];
+    auto& hdr = st.hdrs[i];
+    memset(&hdr, 0, sizeof(mmsghdr));
+    hdr.msg_hdr.msg_name = &st.addrs[slot];
+    hdr.msg_hdr.msg_namelen = st.addr_len(st.endpoints[slot]);
+    hdr.msg_hdr.msg_iov = &st.iovs[i];
+    hdr.msg_hdr.msg_iovlen = 1;
+  }
+  auto res = ::sendmmsg(x.id, st.hdrs.data(), static_cast<unsigned>(st.size),
+                        0);
+  if (res > 0)
+    batch.pop_front(static_cast<size_t>(res));
+  return res;
+#else
+  auto sent = ptrdiff_t{0};
+  while (st.size > 0) {
+    auto slot = st.slot_index(0);
+    auto res = ::sendto(x.id,
+                        reinterpret_cast<socket_send_ptr>(st.slot_data(slot)),
+                        st.sizes[slot], 0,
+                        reinterpret_cast<sockaddr*>(&st.addrs[slot]),
+                        st.addr_len(st.endpoints[slot]));
+    if (res < 0)
+      return sent > 0 ? sent : res;
+    batch.pop_front();
+    ++sent;
+  }
+  return sent;
+#endif
+}
+
 } // namespace caf::net
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "caf/net/fwd.hpp"
 #include "caf/net/network_socket.hpp"
 
 #include "caf//net/datagram_socket.hpp"
@@ -11,6 +12,8 @@
 #include "caf/detail/net_export.hpp"
 #include "caf/fwd.hpp"
 
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 namespace caf::net {
@@ -55,4 +58,92 @@ ptrdiff_t CAF_NET_EXPORT read(udp_datagram_socket x, byte_span buf,
 ptrdiff_t CAF_NET_EXPORT write(udp_datagram_socket x, const_byte_span buf,
                                ip_endpoint ep);
 
+/// Receives multiple datagrams on socket `x` with a single system call if the
+/// platform supports it and appends them to `batch`.
+/// @param x The UDP socket for receiving datagrams.
+/// @param batch Stores the received datagrams. Datagrams that exceed the
+///              maximum datagram size of the batch are truncated.
+/// @returns The number of received datagrams on success, 0 if `batch` is full,
+///          or -1 in case of an error.
+/// @relates udp_datagram_socket
+ptrdiff_t CAF_NET_EXPORT read(udp_datagram_socket x,
+                              udp_datagram_batch& batch);
+
+/// Sends the datagrams in `batch` on socket `x` with a single system call if
+/// the platform supports it and removes all sent datagrams from `batch`.
+/// @param x The UDP socket for sending datagrams.
+/// @param batch Stores the datagrams for sending.
+/// @returns The number of sent datagrams on success, 0 if `batch` is empty,
+///          or -1 in case of an error.
+/// @relates udp_datagram_socket
+ptrdiff_t CAF_NET_EXPORT write(udp_datagram_socket x,
+                               udp_datagram_batch& batch);
+
+/// A ring of pre-allocated buffers for receiving or sending multiple datagrams
+/// with a single system call.
+class CAF_NET_EXPORT udp_datagram_batch {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a batch for up to `capacity` datagrams with up to
+  /// `max_datagram_size` bytes each.
+  udp_datagram_batch(size_t capacity, size_t max_datagram_size);
+
+  udp_datagram_batch(udp_datagram_batch&&) noexcept;
+
+  udp_datagram_batch& operator=(udp_datagram_batch&&) noexcept;
+
+  ~udp_datagram_batch();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of datagrams in the batch.
+  size_t size() const noexcept;
+
+  /// Returns the maximum number of datagrams in the batch.
+  size_t capacity() const noexcept;
+
+  /// Returns the maximum size of a single datagram.
+  size_t max_datagram_size() const noexcept;
+
+  /// Returns whether the batch contains no datagrams.
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /// Returns whether the batch has no free slots left.
+  bool full() const noexcept {
+    return size() == capacity();
+  }
+
+  /// Returns the payload of the datagram at position `index`.
+  const_byte_span payload(size_t index) const noexcept;
+
+  /// Returns the endpoint of the datagram at position `index`, i.e., the
+  /// sender of a received datagram or the receiver of an outgoing datagram.
+  const ip_endpoint& endpoint(size_t index) const noexcept;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Copies `payload` into the next free slot for sending it to `ep`.
+  /// @returns `false` if the batch is full or if `payload` exceeds the maximum
+  ///          datagram size, `true` otherwise.
+  bool push_back(const_byte_span payload, const ip_endpoint& ep);
+
+  /// Removes the first `n` datagrams from the batch.
+  void pop_front(size_t n = 1) noexcept;
+
+  /// Removes all datagrams from the batch.
+  void clear() noexcept;
+
+private:
+  friend ptrdiff_t read(udp_datagram_socket x, udp_datagram_batch& batch);
+
+  friend ptrdiff_t write(udp_datagram_socket x, udp_datagram_batch& batch);
+
+  struct impl;
+
+  std::unique_ptr<impl> impl_;
+};
+
 } // namespace caf::net
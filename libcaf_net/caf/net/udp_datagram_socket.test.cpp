@@ -92,6 +92,57 @@ TEST("read and write") {
   check_eq(received, hello_test);
 }
 
+TEST("batched read and write") {
+  if (auto err = nonblocking(socket_cast<net::socket>(receive_socket), true))
+    fail("setting socket to nonblocking failed: {}", err);
+  udp_datagram_batch out{4, 64};
+  udp_datagram_batch in{4, 64};
+  // Our first read must fail (nothing to receive yet).
+  check(read(receive_socket, in) < 0);
+  check(last_socket_error_is_temporary());
+  std::vector<std::string> inputs{"one", "two", "three"};
+  for (const auto& str : inputs)
+    require(out.push_back(as_bytes(make_span(str)), ep));
+  check(!out.push_back(byte_buffer(65), ep));
+  check_eq(write(send_socket, out), 3);
+  check(out.empty());
+  auto receive_attempts = 0;
+  while (in.size() < inputs.size() && receive_attempts++ < 100) {
+    if (read(receive_socket, in) < 0 && !last_socket_error_is_temporary())
+      fail("read failed: {}", last_socket_error_as_string());
+  }
+  require_eq(in.size(), inputs.size());
+  auto sender = unbox(local_port(send_socket));
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    auto bytes = in.payload(i);
+    std::string_view received{reinterpret_cast<const char*>(bytes.data()),
+                              bytes.size()};
+    check_eq(received, inputs[i]);
+    check_eq(in.endpoint(i).port(), sender);
+  }
+  SECTION("batches re-use their slots as a ring buffer") {
+    in.pop_front(2);
+    check_eq(in.size(), 1u);
+    for (int i = 0; i < 3; ++i)
+      require(out.push_back(as_bytes(make_span(hello_test)), ep));
+    check_eq(write(send_socket, out), 3);
+    receive_attempts = 0;
+    while (in.size() < 4 && receive_attempts++ < 100)
+      std::ignore = read(receive_socket, in);
+    require_eq(in.size(), 4u);
+    check(in.full());
+    check_eq(read(receive_socket, in), 0);
+    auto to_str = [](const_byte_span bytes) {
+      return std::string{reinterpret_cast<const char*>(bytes.data()),
+                         bytes.size()};
+    };
+    check_eq(to_str(in.payload(0)), "three");
+    check_eq(to_str(in.payload(1)), hello_test);
+    check_eq(to_str(in.payload(2)), hello_test);
+    check_eq(to_str(in.payload(3)), hello_test);
+  }
+}
+
 } // WITH_FIXTURE(fixture)
 
 } // namespace
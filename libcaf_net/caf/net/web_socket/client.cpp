@@ -5,17 +5,23 @@
 #include "caf/net/web_socket/client.hpp"
 
 #include "caf/net/fwd.hpp"
+#include "caf/net/http/response_header.hpp"
+#include "caf/net/http/status.hpp"
 #include "caf/net/http/v1.hpp"
 #include "caf/net/octet_stream/lower_layer.hpp"
 #include "caf/net/receive_policy.hpp"
+#include "caf/net/web_socket/deflate_config.hpp"
 #include "caf/net/web_socket/framing.hpp"
 #include "caf/net/web_socket/handshake.hpp"
 
 #include "caf/byte_span.hpp"
 #include "caf/detail/assert.hpp"
+#include "caf/detail/rfc7692.hpp"
 #include "caf/error.hpp"
 #include "caf/log/net.hpp"
 
+#include <optional>
+
 namespace caf::net::web_socket {
 
 namespace {
@@ -29,6 +35,9 @@ public:
     // nop
   }
 
+  /// Offers the permessage-deflate extension to the server when set.
+  std::optional<deflate_config> deflate_cfg;
+
   // -- implementation of octet_stream::upper_layer ----------------------------
 
   error start(octet_stream::lower_layer* down) override {
@@ -91,14 +100,42 @@ private:
     CAF_ASSERT(hs_ != nullptr);
     auto http_ok = hs_->is_valid_http_1_response(http);
     hs_.reset();
-    if (http_ok) {
-      down_->switch_protocol(framing::make_client(std::move(up_)));
-      return true;
+    if (!http_ok) {
+      log::net::debug("received an invalid WebSocket handshake");
+      up_->abort(make_error(sec::protocol_error,
+                            "received an invalid WebSocket handshake"));
+      return false;
+    }
+    if (deflate_cfg) {
+      auto deflate_params = negotiate_deflate(http);
+      if (!deflate_params) {
+        log::net::debug("failed to negotiate permessage-deflate: {}",
+                        deflate_params.error());
+        up_->abort(std::move(deflate_params.error()));
+        return false;
+      }
+      if (*deflate_params) {
+        down_->switch_protocol(framing::make_client(
+          std::move(up_), **deflate_params, *deflate_cfg));
+        return true;
+      }
     }
-    log::net::debug("received an invalid WebSocket handshake");
-    up_->abort(make_error(sec::protocol_error,
-                          "received an invalid WebSocket handshake"));
-    return false;
+    down_->switch_protocol(framing::make_client(std::move(up_)));
+    return true;
+  }
+
+  // Checks whether the server has accepted our offer for permessage-deflate.
+  expected<std::optional<detail::rfc7692::parameters>>
+  negotiate_deflate(std::string_view http) {
+    using result_t = std::optional<detail::rfc7692::parameters>;
+    http::response_header hdr;
+    if (auto [code, msg] = hdr.parse(http); code != http::status::ok)
+      return make_error(sec::protocol_error, std::string{msg});
+    auto field = hdr.field("Sec-WebSocket-Extensions");
+    if (field.empty())
+      return result_t{};
+    return detail::rfc7692::accept_response(field, *deflate_cfg)
+      .transform([](const auto& params) { return result_t{params}; });
   }
 
   // -- member variables -------------------------------------------------------
@@ -121,6 +158,17 @@ std::unique_ptr<client> client::make(handshake_ptr hs, upper_layer_ptr up_ptr) {
   return std::make_unique<client_impl>(std::move(hs), std::move(up_ptr));
 }
 
+std::unique_ptr<client> client::make(handshake_ptr hs, upper_layer_ptr up_ptr,
+                                     const deflate_config& cfg) {
+  auto offer = detail::rfc7692::make_offer(cfg);
+  if (offer.empty())
+    return make(std::move(hs), std::move(up_ptr));
+  hs->extensions(std::move(offer));
+  auto res = std::make_unique<client_impl>(std::move(hs), std::move(up_ptr));
+  res->deflate_cfg = cfg;
+  return res;
+}
+
 // -- constructors, destructors, and assignment operators --------------------
 
 client::~client() {
@@ -33,6 +33,11 @@ public:
   static std::unique_ptr<client> make(handshake&& hs, upper_layer_ptr up) {
     return make(std::make_unique<handshake>(std::move(hs)), std::move(up));
   }
+
+  /// Creates a client that offers the permessage-deflate extension to the
+  /// server.
+  static std::unique_ptr<client> make(handshake_ptr hs, upper_layer_ptr up,
+                                      const deflate_config& cfg);
 };
 
 } // namespace caf::net::web_socket
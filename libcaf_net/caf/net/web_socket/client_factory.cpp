@@ -11,6 +11,8 @@
 #include "caf/internal/make_transport.hpp"
 #include "caf/internal/ws_flow_bridge.hpp"
 
+#include <optional>
+
 namespace caf::net::web_socket {
 
 namespace {
@@ -20,8 +22,16 @@ expected<disposable> do_start_impl(Config& cfg, Conn conn,
                                    async::consumer_resource<frame> pull,
                                    async::producer_resource<frame> push) {
   // s2a: socket-to-application (and a2s is the inverse).
-  auto bridge = internal::make_ws_flow_bridge(std::move(pull), std::move(push));
-  auto impl = client::make(std::move(cfg.hs), std::move(bridge));
+  std::unique_ptr<upper_layer> bridge;
+  if (cfg.chunk_push)
+    bridge = internal::make_ws_chunk_flow_bridge(std::move(pull),
+                                                 std::move(cfg.chunk_push));
+  else
+    bridge = internal::make_ws_flow_bridge(std::move(pull), std::move(push));
+  auto hs = std::make_unique<handshake>(std::move(cfg.hs));
+  auto impl = cfg.deflate_cfg ? client::make(std::move(hs), std::move(bridge),
+                                             *cfg.deflate_cfg)
+                              : client::make(std::move(hs), std::move(bridge));
   auto transport = internal::make_transport(std::move(conn), std::move(impl));
   transport->active_policy().connect();
   auto ptr = socket_manager::make(cfg.mpx, std::move(transport));
@@ -40,6 +50,11 @@ public:
   }
 
   handshake hs;
+
+  std::optional<deflate_config> deflate_cfg;
+
+  /// Passes received messages to the application in chunks when set.
+  async::producer_resource<message_chunk> chunk_push;
 };
 
 client_factory::client_factory(client_factory&& other) noexcept {
@@ -56,6 +71,16 @@ client_factory::~client_factory() {
     config_->deref();
 }
 
+client_factory& client_factory::permessage_deflate(const deflate_config& cfg) {
+  config_->deflate_cfg = cfg;
+  return *this;
+}
+
+void client_factory::set_chunk_push(
+  async::producer_resource<message_chunk> push) {
+  config_->chunk_push = std::move(push);
+}
+
 dsl::client_config_value& client_factory::base_config() {
   return *config_;
 }
@@ -9,7 +9,9 @@
 #include "caf/net/dsl/generic_config.hpp"
 #include "caf/net/ssl/connection.hpp"
 #include "caf/net/tcp_stream_socket.hpp"
+#include "caf/net/web_socket/deflate_config.hpp"
 #include "caf/net/web_socket/framing.hpp"
+#include "caf/net/web_socket/message_chunk.hpp"
 
 #include "caf/async/spsc_buffer.hpp"
 #include "caf/detail/net_export.hpp"
@@ -40,6 +42,10 @@ public:
 
   ~client_factory() override;
 
+  /// Offers the permessage-deflate extension (cf. RFC 7692) to the server for
+  /// compressing messages.
+  client_factory& permessage_deflate(const deflate_config& cfg = {});
+
   /// Starts a connection with the length-prefixing protocol.
   template <class OnStart>
   [[nodiscard]] expected<disposable> start(OnStart on_start) {
@@ -58,6 +64,28 @@ public:
     return res;
   }
 
+  /// Starts a connection that passes received messages to the application in
+  /// chunks as they arrive instead of reassembling them first. The last chunk
+  /// of each message has the final flag set.
+  template <class OnStart>
+  [[nodiscard]] expected<disposable> start_chunked(OnStart on_start) {
+    static_assert(std::is_invocable_v<OnStart, chunk_pull_t, push_t>);
+    // Create socket-to-application and application-to-socket buffers.
+    auto [s2a_pull, s2a_push]
+      = async::make_spsc_buffer_resource<message_chunk>();
+    auto [a2s_pull, a2s_push] = async::make_spsc_buffer_resource<frame>();
+    set_chunk_push(std::move(s2a_push));
+    // Wrap the trait and the buffers that belong to the socket.
+    auto res = base_config().visit(
+      [this, pull = a2s_pull](auto& data) mutable {
+        return this->do_start(data, std::move(pull), push_t{});
+      });
+    if (res) {
+      on_start(std::move(s2a_pull), std::move(a2s_push));
+    }
+    return res;
+  }
+
 protected:
   dsl::client_config_value& base_config() override;
 
@@ -68,8 +96,12 @@ private:
 
   using push_t = async::producer_resource<frame>;
 
+  using chunk_pull_t = async::consumer_resource<message_chunk>;
+
   dsl::client_config_value& init_config(multiplexer* mpx);
 
+  void set_chunk_push(async::producer_resource<message_chunk> push);
+
   expected<void> sanity_check();
 
   expected<disposable> do_start(dsl::client_config::lazy& data,
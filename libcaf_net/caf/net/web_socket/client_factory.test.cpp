@@ -0,0 +1,176 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/web_socket/client_factory.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/net/http/request_header.hpp"
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/stream_socket.hpp"
+#include "caf/net/tcp_accept_socket.hpp"
+#include "caf/net/tcp_stream_socket.hpp"
+#include "caf/net/web_socket/handshake.hpp"
+#include "caf/net/web_socket/message_chunk.hpp"
+#include "caf/net/web_socket/with.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/latch.hpp"
+#include "caf/detail/rfc6455.hpp"
+#include "caf/detail/scope_guard.hpp"
+#include "caf/flow/observable_builder.hpp"
+#include "caf/flow/scoped_coordinator.hpp"
+#include "caf/uri.hpp"
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::rfc6455;
+
+namespace {
+
+/// Stores a message chunk as received by the application.
+struct chunk_info {
+  std::string payload;
+  bool is_text;
+  bool is_final;
+
+  friend bool operator==(const chunk_info& x, const chunk_info& y) {
+    return x.payload == y.payload && x.is_text == y.is_text
+           && x.is_final == y.is_final;
+  }
+};
+
+[[maybe_unused]] std::string to_string(const chunk_info& x) {
+  return detail::format("({}, {}, {})", x.payload,
+                        x.is_text ? "text" : "binary",
+                        x.is_final ? "final" : "partial");
+}
+
+void add_frame(byte_buffer& buf, uint8_t opcode, std::string_view payload,
+               bool fin) {
+  auto first = reinterpret_cast<const std::byte*>(payload.data());
+  rfc6455::assemble_frame(opcode, 0, const_byte_span{first, payload.size()},
+                          buf, fin ? rfc6455::fin_flag : uint8_t{0});
+}
+
+// Accepts a single WebSocket client, answers its handshake and then sends a
+// fragmented text message that ends with an empty frame, followed by a binary
+// message. Keeps the connection open until the client closes it.
+void run_server(net::tcp_accept_socket acceptor) {
+  auto fd = net::accept(acceptor);
+  net::close(acceptor);
+  if (!fd)
+    return;
+  auto guard = detail::scope_guard{[fd = *fd]() noexcept { net::close(fd); }};
+  std::string request;
+  char buf[1024];
+  while (request.find("\r\n\r\n") == std::string::npos) {
+    auto n = net::read(*fd, as_writable_bytes(make_span(buf)));
+    if (n <= 0)
+      return;
+    request.append(buf, static_cast<size_t>(n));
+  }
+  net::http::request_header hdr;
+  hdr.parse(request);
+  net::web_socket::handshake hs;
+  if (!hs.assign_key(hdr.field("Sec-WebSocket-Key")))
+    return;
+  byte_buffer out;
+  hs.write_http_1_response(out);
+  add_frame(out, rfc6455::text_frame, "hello", false);
+  add_frame(out, rfc6455::continuation_frame, " world", false);
+  add_frame(out, rfc6455::continuation_frame, "", true);
+  add_frame(out, rfc6455::binary_frame, "abc", true);
+  if (net::write(*fd, out) != static_cast<ptrdiff_t>(out.size()))
+    return;
+  while (net::read(*fd, as_writable_bytes(make_span(buf))) > 0)
+    ; // nop
+}
+
+struct fixture {
+  fixture() {
+    mpx = net::multiplexer::make(nullptr);
+    std::ignore = mpx->init();
+    mpx_thread = std::thread{[mpx = mpx] {
+      mpx->set_thread_id();
+      mpx->run();
+    }};
+  }
+
+  ~fixture() {
+    mpx->shutdown();
+    mpx_thread.join();
+  }
+
+  net::multiplexer_ptr mpx;
+  std::thread mpx_thread;
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("start_chunked passes the message type along with each chunk") {
+  auto acceptor = net::make_tcp_accept_socket(0, "127.0.0.1");
+  require(acceptor.has_value());
+  auto port = net::local_port(*acceptor);
+  require(port.has_value());
+  auto server_thread = std::thread{run_server, *acceptor};
+  auto received = std::make_shared<std::vector<chunk_info>>();
+  auto rendezvous = std::make_shared<detail::latch>(2);
+  auto worker = std::thread{};
+  auto conn
+    = net::web_socket::with(mpx.get())
+        .connect(make_uri(detail::format("ws://127.0.0.1:{}", *port)))
+        .start_chunked([received, rendezvous, &worker](auto pull, auto push) {
+          worker = std::thread{[pull, push, received, rendezvous] {
+            auto self = flow::scoped_coordinator::make();
+            auto messages = std::make_shared<size_t>(0);
+            pull.observe_on(self.get())
+              .for_each(
+                [received, rendezvous,
+                 messages](const net::web_socket::message_chunk& item) {
+                  auto text = item.is_text()
+                                ? std::string{item.as_text()}
+                                : std::string{reinterpret_cast<const char*>(
+                                                item.as_binary().data()),
+                                              item.size()};
+                  received->push_back(
+                    {std::move(text), item.is_text(), item.is_final()});
+                  if (item.is_final() && ++*messages == 2)
+                    rendezvous->count_down();
+                },
+                [rendezvous](const error&) { rendezvous->count_down(); });
+            self->run();
+          }};
+        });
+  require(conn.has_value());
+  rendezvous->count_down_and_wait();
+  // Merges the chunks of the fragmented message, because the transport may
+  // split or merge frames. The empty chunk at the end must remain a text
+  // chunk.
+  auto merged = std::vector<chunk_info>{};
+  for (auto& item : *received) {
+    if (!merged.empty() && !merged.back().is_final
+        && merged.back().is_text == item.is_text && !item.payload.empty()) {
+      merged.back().payload += item.payload;
+      merged.back().is_final = item.is_final;
+    } else {
+      merged.push_back(item);
+    }
+  }
+  check_eq(merged, std::vector<chunk_info>{{"hello world", true, false},
+                                           {"", true, true},
+                                           {"abc", false, true}});
+  conn->dispose();
+  worker.join();
+  server_thread.join();
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
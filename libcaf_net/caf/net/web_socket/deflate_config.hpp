@@ -0,0 +1,43 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/defaults.hpp"
+
+#include <cstddef>
+
+namespace caf::net::web_socket {
+
+/// Configures the permessage-deflate extension for compressing WebSocket
+/// messages as defined in RFC 7692.
+struct deflate_config {
+  /// The zlib compression level, ranging from 1 (fastest) to 9 (smallest
+  /// output). The default value -1 selects the zlib default.
+  int level = -1;
+
+  /// Allows the server to re-use its compression context for subsequent
+  /// messages. Disabling the context takeover reduces the compression ratio
+  /// but allows the server to compress each message independently.
+  bool server_context_takeover = true;
+
+  /// Allows the client to re-use its compression context for subsequent
+  /// messages.
+  bool client_context_takeover = true;
+
+  /// Restricts how much memory zlib may allocate per connection. Reduces the
+  /// window size if necessary. The WebSocket connection falls back to
+  /// uncompressed messages if even the smallest window size exceeds this
+  /// limit.
+  size_t max_memory = defaults::net::web_socket_deflate_max_memory;
+
+  /// Sends messages below this size without compressing them.
+  size_t min_message_size = defaults::net::web_socket_deflate_min_message_size;
+
+  /// Closes the connection if a compressed message exceeds this size after
+  /// decompressing it.
+  size_t max_message_size = defaults::net::web_socket_deflate_max_message_size;
+};
+
+} // namespace caf::net::web_socket
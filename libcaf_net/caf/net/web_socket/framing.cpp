@@ -5,8 +5,11 @@
 #include "caf/net/web_socket/framing.hpp"
 
 #include "caf/net/fwd.hpp"
+#include "caf/net/multiplexer.hpp"
 #include "caf/net/octet_stream/lower_layer.hpp"
 #include "caf/net/receive_policy.hpp"
+#include "caf/net/socket_manager.hpp"
+#include "caf/net/web_socket/deflate_config.hpp"
 #include "caf/net/web_socket/lower_layer.hpp"
 #include "caf/net/web_socket/status.hpp"
 #include "caf/net/web_socket/upper_layer.hpp"
@@ -14,13 +17,19 @@
 #include "caf/byte_span.hpp"
 #include "caf/detail/rfc3629.hpp"
 #include "caf/detail/rfc6455.hpp"
+#include "caf/actor_system.hpp"
 #include "caf/log/net.hpp"
 #include "caf/sec.hpp"
 #include "caf/span.hpp"
+#include "caf/telemetry/histogram.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <random>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace caf::net::web_socket {
@@ -38,6 +47,15 @@ bool payload_valid(const_byte_span payload, size_t& offset) noexcept {
   return offset == payload.size() || incomplete;
 }
 
+/// Returns the masking key for payload data that starts at `offset` in the
+/// payload of a frame.
+uint32_t rotate_mask_key(uint32_t key, size_t offset) noexcept {
+  auto shift = (offset % 4) * 8;
+  if (shift == 0)
+    return key;
+  return (key << shift) | (key >> (32 - shift));
+}
+
 /// Checks whether the payload of a closing frame contains a valid status code
 /// and an UTF-8 formatted message.
 /// @returns A default constructed `error` if the payload is valid, error kind
@@ -93,6 +111,10 @@ public:
   /// Default receive policy for a new frame.
   static constexpr auto default_receive_policy = receive_policy::up_to(2048);
 
+  /// Restricts the size of chunks for upper layers that consume messages in
+  /// chunks.
+  static constexpr uint64_t max_chunk_size = 64 * 1024;
+
   // -- constructors, destructors, and assignment operators --------------------
 
   explicit framing_impl(upper_layer_ptr up) : up_(std::move(up)) {
@@ -105,12 +127,39 @@ public:
   /// the standard.
   bool mask_outgoing_frames = true;
 
+  /// Enables the permessage-deflate extension (cf. RFC 7692) when set.
+  std::optional<detail::rfc7692::parameters> deflate_params;
+
+  /// Configures the permessage-deflate extension.
+  deflate_config deflate_cfg;
+
   // -- octet_stream::upper_layer implementation -------------------------------
 
   error start(octet_stream::lower_layer* down) override {
     std::random_device rd;
     rng_.seed(rd());
     down_ = down;
+    if (deflate_params) {
+      codec_ = std::make_unique<detail::rfc7692::codec>();
+      if (!codec_->init(*deflate_params, !mask_outgoing_frames, deflate_cfg))
+        return make_error(sec::runtime_error,
+                          "failed to initialize permessage-deflate");
+      if (auto* mgr = down->manager()) {
+        static constexpr double ratio_buckets[] = {0.1, 0.2, 0.3, 0.4, 0.5,
+                                                   0.6, 0.7, 0.8, 0.9, 1.0};
+        auto& reg = mgr->mpx().system().metrics();
+        auto ratio = [&reg](std::string_view direction) {
+          return reg.histogram_instance<double>(
+            "caf.net", "web-socket-compression-ratio",
+            {{"direction", direction}}, make_span(ratio_buckets),
+            "Size of compressed WebSocket messages relative to their "
+            "original size.");
+        };
+        inbound_ratio_ = ratio("in");
+        outbound_ratio_ = ratio("out");
+      }
+    }
+    consumes_chunks_ = up_->consumes_chunks();
     return up_->start(this);
   }
 
@@ -169,7 +218,13 @@ public:
   }
 
   void request_messages() override {
-    if (!down_->is_reading())
+    if (down_->is_reading())
+      return;
+    // Resume in the middle of a frame if the upper layer suspended reading
+    // while consuming a chunk.
+    if (consuming_chunks())
+      down_->configure_read(chunk_receive_policy());
+    else
       down_->configure_read(default_receive_policy);
   }
 
@@ -208,6 +263,11 @@ private:
       log::net::debug(message);
       return make_error(sec::protocol_error, message);
     };
+    // The RSV1 bit marks the first frame of a compressed message.
+    if (hdr_.rsv1
+        && (!codec_ || detail::rfc6455::is_control_frame(hdr_.opcode)
+            || hdr_.opcode == detail::rfc6455::continuation_frame))
+      return make_error_with_log("Unexpected RSV1 bit in WebSocket frame");
     if (detail::rfc6455::is_control_frame(hdr_.opcode)) {
       // Control frames can have a payload up to 125 bytes and can't be
       // fragmented.
@@ -255,12 +315,23 @@ private:
       abort_and_shutdown(err);
       return -1;
     }
+    if (hdr_.rsv1)
+      compressed_ = true;
+    // Reject compressed messages that cannot possibly decompress to a message
+    // within the size limit before reading their payload.
+    if (compressed_ && !detail::rfc6455::is_control_frame(hdr_.opcode)
+        && compressed_payload_too_big(hdr_.payload_len))
+      return -1;
     // Configure the buffer for the next call to consume_payload. In case of
     // text messages, we validate the UTF-8 encoding on the go, hence the use of
-    // up_to.
-    if (hdr_.opcode == detail::rfc6455::text_frame
-        || (hdr_.opcode == detail::rfc6455::continuation_frame
-            && opcode_ == detail::rfc6455::text_frame))
+    // up_to. Compressed messages can only be validated after decompressing
+    // them.
+    if (consuming_chunks())
+      down_->configure_read(chunk_receive_policy());
+    else if (!compressed_
+        && (hdr_.opcode == detail::rfc6455::text_frame
+            || (hdr_.opcode == detail::rfc6455::continuation_frame
+                && opcode_ == detail::rfc6455::text_frame)))
       down_->configure_read(receive_policy::up_to(hdr_.payload_len));
     else
       down_->configure_read(receive_policy::exactly(hdr_.payload_len));
@@ -270,6 +341,8 @@ private:
   // Consume the payload for the currently parsing frame. Returns the number of
   // consumed bytes.
   ptrdiff_t consume_payload(byte_span buffer, byte_span delta) {
+    if (consuming_chunks())
+      return consume_chunk(buffer);
     // Calculate at what point of the received buffer the delta payload begins.
     auto offset = static_cast<ptrdiff_t>(buffer.size() - delta.size());
     // Unmask the arrived data.
@@ -279,6 +352,8 @@ private:
     // message fragments.
     if (detail::rfc6455::is_control_frame(hdr_.opcode))
       return handle(hdr_.opcode, buffer, hdr_.payload_len);
+    if (compressed_)
+      return consume_compressed_payload(buffer);
     // Handle the fragmentation logic of text and binary messages.
     if (hdr_.opcode == detail::rfc6455::text_frame
         || opcode_ == detail::rfc6455::text_frame) {
@@ -336,6 +411,175 @@ private:
     return static_cast<ptrdiff_t>(hdr_.payload_len);
   }
 
+  // Checks whether we pass the payload of the current frame to the upper layer
+  // in chunks. Compressed messages can only be decompressed as a whole.
+  bool consuming_chunks() const noexcept {
+    return consumes_chunks_ && hdr_.valid() && !compressed_
+           && !detail::rfc6455::is_control_frame(hdr_.opcode);
+  }
+
+  // Returns the receive policy for the next chunk of the current frame.
+  receive_policy chunk_receive_policy() const noexcept {
+    auto remaining = hdr_.payload_len - chunk_offset_;
+    return receive_policy::up_to(
+      static_cast<uint32_t>(std::min(remaining, max_chunk_size)));
+  }
+
+  // Passes the payload of the current frame to the upper layer as it arrives.
+  // Returns the number of consumed bytes.
+  ptrdiff_t consume_chunk(byte_span buffer) {
+    // The buffer starts at `chunk_offset_` in the payload of the frame and
+    // contains `chunk_unmasked_` bytes from the previous call.
+    if (hdr_.mask_key != 0)
+      detail::rfc6455::mask_data(rotate_mask_key(hdr_.mask_key, chunk_offset_),
+                                 buffer, chunk_unmasked_);
+    chunk_unmasked_ = buffer.size();
+    auto last = chunk_offset_ + buffer.size() == hdr_.payload_len;
+    auto final = last && hdr_.fin;
+    if (hdr_.opcode == detail::rfc6455::binary_frame
+        || opcode_ == detail::rfc6455::binary_frame) {
+      next_chunk(buffer.size());
+      if (!buffer.empty() || final) {
+        if (up_->consume_binary_chunk(buffer, final) < 0)
+          return -1;
+      }
+      return static_cast<ptrdiff_t>(buffer.size());
+    }
+    // For text messages, we only pass complete code points to the upper layer.
+    // A code point that spans two frames goes to `utf8_tail_`.
+    size_t consumed = 0;
+    auto tail_complete = false;
+    if (!utf8_tail_.empty()) {
+      while (!tail_complete && consumed < buffer.size()) {
+        utf8_tail_.push_back(buffer[consumed++]);
+        auto [index, incomplete] = detail::rfc3629::validate(utf8_tail_);
+        if (!incomplete && index != utf8_tail_.size())
+          return invalid_utf8();
+        tail_complete = !incomplete;
+      }
+      if (!tail_complete) {
+        if (final)
+          return invalid_utf8();
+        next_chunk(consumed);
+        return static_cast<ptrdiff_t>(consumed);
+      }
+    }
+    auto rest = buffer.subspan(consumed);
+    auto [index, incomplete] = detail::rfc3629::validate(rest);
+    if (index != rest.size() && (!incomplete || final))
+      return invalid_utf8();
+    // Keep an incomplete code point in the buffer until the next call or move
+    // it to `utf8_tail_` at the end of the frame.
+    if (index == rest.size() || last)
+      consumed = buffer.size();
+    else
+      consumed += index;
+    auto as_text = [](const_byte_span bytes) {
+      return std::string_view{reinterpret_cast<const char*>(bytes.data()),
+                              bytes.size()};
+    };
+    next_chunk(consumed);
+    if (tail_complete) {
+      if (up_->consume_text_chunk(as_text(utf8_tail_), final && index == 0)
+          < 0)
+        return -1;
+      utf8_tail_.clear();
+    }
+    if (index > 0 || (final && !tail_complete)) {
+      if (up_->consume_text_chunk(as_text(rest.first(index)), final) < 0)
+        return -1;
+    }
+    if (index != rest.size() && last)
+      utf8_tail_.assign(rest.begin() + index, rest.end());
+    return static_cast<ptrdiff_t>(consumed);
+  }
+
+  // Updates the state after consuming `n` bytes of the current frame.
+  void next_chunk(size_t n) {
+    chunk_offset_ += n;
+    chunk_unmasked_ -= n;
+    if (chunk_offset_ < hdr_.payload_len) {
+      down_->configure_read(chunk_receive_policy());
+      return;
+    }
+    if (hdr_.fin)
+      opcode_ = detail::rfc6455::invalid_frame;
+    else if (opcode_ == detail::rfc6455::invalid_frame)
+      opcode_ = hdr_.opcode;
+    chunk_offset_ = 0;
+    chunk_unmasked_ = 0;
+    down_->configure_read(default_receive_policy);
+    hdr_.opcode = detail::rfc6455::invalid_frame;
+  }
+
+  ptrdiff_t invalid_utf8() {
+    abort_and_shutdown(sec::malformed_message, "Invalid UTF-8 sequence");
+    return -1;
+  }
+
+  // Collects the payload of a compressed message and decompresses it after
+  // receiving the last frame. Returns the number of consumed bytes.
+  ptrdiff_t consume_compressed_payload(byte_span buffer) {
+    using namespace std::literals;
+    if (compressed_payload_too_big(buffer.size()))
+      return -1;
+    payload_buf_.insert(payload_buf_.end(), buffer.begin(), buffer.end());
+    if (!hdr_.fin) {
+      if (opcode_ == detail::rfc6455::invalid_frame)
+        opcode_ = hdr_.opcode;
+      down_->configure_read(default_receive_policy);
+      hdr_.opcode = detail::rfc6455::invalid_frame;
+      return static_cast<ptrdiff_t>(hdr_.payload_len);
+    }
+    auto opcode = opcode_ == detail::rfc6455::invalid_frame ? hdr_.opcode
+                                                            : opcode_;
+    deflate_buf_.clear();
+    if (!codec_->decompress(payload_buf_, deflate_buf_,
+                            deflate_cfg.max_message_size)) {
+      abort_and_shutdown(sec::protocol_error,
+                         "Invalid compressed WebSocket message");
+      return -1;
+    }
+    if (deflate_buf_.size() > deflate_cfg.max_message_size) {
+      auto msg = "Decompressed WebSocket message exceeds maximum size"sv;
+      up_->abort(make_error(sec::protocol_error, msg));
+      shutdown(status::message_too_big, msg);
+      return -1;
+    }
+    if (opcode == detail::rfc6455::text_frame
+        && !detail::rfc3629::valid(deflate_buf_)) {
+      abort_and_shutdown(sec::malformed_message, "Invalid UTF-8 sequence");
+      return -1;
+    }
+    observe_ratio(inbound_ratio_, payload_buf_.size(), deflate_buf_.size());
+    opcode_ = detail::rfc6455::invalid_frame;
+    payload_buf_.clear();
+    compressed_ = false;
+    return handle(opcode, deflate_buf_, hdr_.payload_len);
+  }
+
+  // Checks whether adding `n` bytes to the payload of the current compressed
+  // message would exceed the largest input that can decompress to at most
+  // `max_message_size` bytes. Aborts and closes the connection if so.
+  bool compressed_payload_too_big(size_t n) {
+    using namespace std::literals;
+    auto limit
+      = detail::rfc7692::max_compressed_size(deflate_cfg.max_message_size);
+    if (payload_buf_.size() <= limit && n <= limit - payload_buf_.size())
+      return false;
+    auto msg = "Compressed WebSocket message exceeds maximum size"sv;
+    up_->abort(make_error(sec::protocol_error, msg));
+    shutdown(status::message_too_big, msg);
+    return true;
+  }
+
+  static void observe_ratio(telemetry::dbl_histogram* hist, size_t compressed,
+                            size_t original) {
+    if (hist != nullptr && original > 0)
+      hist->observe(static_cast<double>(compressed)
+                    / static_cast<double>(original));
+  }
+
   // Returns `frame_size` on success and -1 on error.
   ptrdiff_t handle(uint8_t opcode, byte_span payload, size_t frame_size) {
     // opcodes are checked for validity when decoding the header
@@ -350,14 +594,19 @@ private:
       case detail::rfc6455::text_frame: {
         std::string_view text{reinterpret_cast<const char*>(payload.data()),
                               payload.size()};
-        if (up_->consume_text(text) < 0)
+        auto res = consumes_chunks_ ? up_->consume_text_chunk(text, true)
+                                    : up_->consume_text(text);
+        if (res < 0)
           return -1;
         break;
       }
-      case detail::rfc6455::binary_frame:
-        if (up_->consume_binary(payload) < 0)
+      case detail::rfc6455::binary_frame: {
+        auto res = consumes_chunks_ ? up_->consume_binary_chunk(payload, true)
+                                    : up_->consume_binary(payload);
+        if (res < 0)
           return -1;
         break;
+      }
       case detail::rfc6455::ping_frame:
         ship_pong(payload);
         break;
@@ -385,6 +634,19 @@ private:
 
   template <class T>
   void ship_frame(std::vector<T>& buf) {
+    if (codec_ && buf.size() >= deflate_cfg.min_message_size) {
+      deflate_buf_.clear();
+      if (codec_->compress(as_bytes(make_span(buf)), deflate_buf_)) {
+        observe_ratio(outbound_ratio_, deflate_buf_.size(), buf.size());
+        constexpr auto opcode = std::is_same_v<T, char>
+                                  ? detail::rfc6455::text_frame
+                                  : detail::rfc6455::binary_frame;
+        ship_compressed_frame(opcode);
+        buf.clear();
+        return;
+      }
+      log::net::warning("failed to compress WebSocket message");
+    }
     uint32_t mask_key = 0;
     if (mask_outgoing_frames) {
       mask_key = static_cast<uint32_t>(rng_());
@@ -396,6 +658,21 @@ private:
     buf.clear();
   }
 
+  // Sends the content of `deflate_buf_` as a single, compressed frame.
+  void ship_compressed_frame(uint8_t opcode) {
+    uint32_t mask_key = 0;
+    if (mask_outgoing_frames) {
+      mask_key = static_cast<uint32_t>(rng_());
+      detail::rfc6455::mask_data(mask_key, deflate_buf_);
+    }
+    down_->begin_output();
+    detail::rfc6455::assemble_frame(opcode, mask_key, deflate_buf_,
+                                    down_->output_buffer(),
+                                    detail::rfc6455::fin_flag
+                                      | detail::rfc6455::rsv1_flag);
+    down_->end_output();
+  }
+
   // Sends closing message, can be error status, or closing handshake
   void ship_closing_message(status code, std::string_view msg) {
     auto code_val = static_cast<uint16_t>(code);
@@ -454,6 +731,35 @@ private:
   /// Stores where to resume the UTF-8 input validation.
   size_t validation_offset_ = 0;
 
+  /// Stores whether the upper layer consumes messages in chunks.
+  bool consumes_chunks_ = false;
+
+  /// Stores how many bytes of the current frame the upper layer has consumed
+  /// in chunks.
+  size_t chunk_offset_ = 0;
+
+  /// Stores how many bytes at the front of the next chunk we have unmasked
+  /// already.
+  size_t chunk_unmasked_ = 0;
+
+  /// Stores an incomplete code point at the end of a text frame.
+  binary_buffer utf8_tail_;
+
+  /// Compresses and decompresses messages when using permessage-deflate.
+  std::unique_ptr<detail::rfc7692::codec> codec_;
+
+  /// Stores whether the current message is compressed.
+  bool compressed_ = false;
+
+  /// Stores the compressed or decompressed version of a message.
+  binary_buffer deflate_buf_;
+
+  /// Tracks the compression ratio of received messages.
+  telemetry::dbl_histogram* inbound_ratio_ = nullptr;
+
+  /// Tracks the compression ratio of sent messages.
+  telemetry::dbl_histogram* outbound_ratio_ = nullptr;
+
   /// Next layer in the processing chain.
   upper_layer_ptr up_;
 };
@@ -474,6 +780,27 @@ std::unique_ptr<framing> framing::make_server(upper_layer_ptr up) {
   return res;
 }
 
+std::unique_ptr<framing>
+framing::make_client(upper_layer_ptr up,
+                     const detail::rfc7692::parameters& params,
+                     const deflate_config& cfg) {
+  auto res = std::make_unique<framing_impl>(std::move(up));
+  res->deflate_params = params;
+  res->deflate_cfg = cfg;
+  return res;
+}
+
+std::unique_ptr<framing>
+framing::make_server(upper_layer_ptr up,
+                     const detail::rfc7692::parameters& params,
+                     const deflate_config& cfg) {
+  auto res = std::make_unique<framing_impl>(std::move(up));
+  res->mask_outgoing_frames = false;
+  res->deflate_params = params;
+  res->deflate_cfg = cfg;
+  return res;
+}
+
 // -- constructors, destructors, and assignment operators --------------------
 
 framing::~framing() {
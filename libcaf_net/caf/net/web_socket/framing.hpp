@@ -9,6 +9,8 @@
 #include "caf/net/web_socket/lower_layer.hpp"
 #include "caf/net/web_socket/upper_layer.hpp"
 
+#include "caf/detail/rfc7692.hpp"
+
 #include <memory>
 
 namespace caf::net::web_socket {
@@ -32,6 +34,18 @@ public:
 
   /// Creates a new framing protocol for server mode.
   static std::unique_ptr<framing> make_server(upper_layer_ptr up);
+
+  /// Creates a new framing protocol for client mode that compresses messages
+  /// with the negotiated permessage-deflate parameters.
+  static std::unique_ptr<framing>
+  make_client(upper_layer_ptr up, const detail::rfc7692::parameters& params,
+              const deflate_config& cfg);
+
+  /// Creates a new framing protocol for server mode that compresses messages
+  /// with the negotiated permessage-deflate parameters.
+  static std::unique_ptr<framing>
+  make_server(upper_layer_ptr up, const detail::rfc7692::parameters& params,
+              const deflate_config& cfg);
 };
 
 } // namespace caf::net::web_socket
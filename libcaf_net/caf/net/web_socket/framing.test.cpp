@@ -0,0 +1,347 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#include "caf/net/web_socket/framing.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/net/octet_stream/lower_layer.hpp"
+#include "caf/net/receive_policy.hpp"
+#include "caf/net/web_socket/deflate_config.hpp"
+#include "caf/net/web_socket/upper_layer.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/detail/rfc6455.hpp"
+#include "caf/detail/rfc7692.hpp"
+#include "caf/span.hpp"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+using detail::rfc6455;
+
+namespace {
+
+constexpr uint32_t mask_key = 0xdeadbeef;
+
+/// Feeds bytes to the framing layer, imitating the octet stream transport.
+class mock_transport : public net::octet_stream::lower_layer {
+public:
+  net::socket_manager* manager() noexcept override {
+    return nullptr;
+  }
+
+  bool can_send_more() const noexcept override {
+    return true;
+  }
+
+  bool is_reading() const noexcept override {
+    return policy.max_size > 0;
+  }
+
+  void write_later() override {
+    // nop
+  }
+
+  void shutdown() override {
+    closed = true;
+  }
+
+  void configure_read(net::receive_policy rd) override {
+    policy = rd;
+  }
+
+  void begin_output() override {
+    // nop
+  }
+
+  byte_buffer& output_buffer() override {
+    return output;
+  }
+
+  bool end_output() override {
+    return true;
+  }
+
+  void
+  switch_protocol(std::unique_ptr<net::octet_stream::upper_layer>) override {
+    // nop
+  }
+
+  bool switching_protocol() const noexcept override {
+    return false;
+  }
+
+  void push(const_byte_span bytes) {
+    input.insert(input.end(), bytes.begin(), bytes.end());
+    while (!closed && policy.max_size > 0 && !input.empty()
+           && input.size() >= policy.min_size) {
+      auto n = std::min(input.size(), size_t{policy.max_size});
+      auto buf = make_span(input.data(), n);
+      auto consumed = up->consume(buf, buf.subspan(delta_offset));
+      if (consumed < 0) {
+        closed = true;
+        return;
+      }
+      if (consumed == 0) {
+        delta_offset = n;
+        if (n == std::min(input.size(), size_t{policy.max_size}))
+          return;
+        continue;
+      }
+      input.erase(input.begin(), input.begin() + consumed);
+      delta_offset = 0;
+    }
+  }
+
+  net::web_socket::framing* up = nullptr;
+  net::receive_policy policy = net::receive_policy::stop();
+  byte_buffer input;
+  size_t delta_offset = 0;
+  byte_buffer output;
+  bool closed = false;
+};
+
+/// Records all messages and chunks received from the framing layer.
+class mock_app : public net::web_socket::upper_layer {
+public:
+  explicit mock_app(bool chunked) : chunked(chunked) {
+    // nop
+  }
+
+  error start(net::web_socket::lower_layer* down) override {
+    down->request_messages();
+    return none;
+  }
+
+  void prepare_send() override {
+    // nop
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+  void abort(const error& reason) override {
+    err = reason;
+  }
+
+  ptrdiff_t consume_binary(byte_span buf) override {
+    messages.emplace_back(reinterpret_cast<const char*>(buf.data()),
+                          buf.size());
+    return static_cast<ptrdiff_t>(buf.size());
+  }
+
+  ptrdiff_t consume_text(std::string_view buf) override {
+    messages.emplace_back(buf);
+    return static_cast<ptrdiff_t>(buf.size());
+  }
+
+  bool consumes_chunks() const noexcept override {
+    return chunked;
+  }
+
+  ptrdiff_t consume_binary_chunk(byte_span buf, bool final) override {
+    chunks.emplace_back(reinterpret_cast<const char*>(buf.data()), buf.size());
+    finals.push_back(final);
+    return static_cast<ptrdiff_t>(buf.size());
+  }
+
+  ptrdiff_t consume_text_chunk(std::string_view buf, bool final) override {
+    chunks.emplace_back(buf);
+    finals.push_back(final);
+    return static_cast<ptrdiff_t>(buf.size());
+  }
+
+  bool chunked;
+  std::vector<std::string> messages;
+  std::vector<std::string> chunks;
+  std::vector<bool> finals;
+  error err;
+};
+
+struct fixture {
+  void init(bool chunked) {
+    auto ptr = std::make_unique<mock_app>(chunked);
+    app = ptr.get();
+    uut = net::web_socket::framing::make_server(std::move(ptr));
+    start();
+  }
+
+  // Initializes a server with permessage-deflate enabled.
+  void init(const net::web_socket::deflate_config& cfg) {
+    auto ptr = std::make_unique<mock_app>(false);
+    app = ptr.get();
+    uut = net::web_socket::framing::make_server(std::move(ptr),
+                                                detail::rfc7692::parameters{},
+                                                cfg);
+    start();
+  }
+
+  void start() {
+    transport.up = uut.get();
+    if (auto err = uut->start(&transport))
+      test::runnable::current().fail("failed to start the framing: {}", err);
+  }
+
+  // Generates a masked frame as a client would send it.
+  static byte_buffer make_frame(uint8_t opcode, std::string_view payload,
+                                bool fin = true) {
+    auto first = reinterpret_cast<const std::byte*>(payload.data());
+    return make_frame(opcode, byte_buffer{first, first + payload.size()},
+                      fin ? rfc6455::fin_flag : uint8_t{0});
+  }
+
+  static byte_buffer make_frame(uint8_t opcode, byte_buffer data,
+                                uint8_t flags) {
+    byte_buffer result;
+    rfc6455::mask_data(mask_key, data);
+    rfc6455::assemble_frame(opcode, mask_key, data, result, flags);
+    return result;
+  }
+
+  void push(const byte_buffer& bytes) {
+    transport.push(bytes);
+  }
+
+  mock_transport transport;
+  std::unique_ptr<net::web_socket::framing> uut;
+  mock_app* app = nullptr;
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("upper layers that consume chunks receive each fragment") {
+  init(true);
+  push(make_frame(rfc6455::binary_frame, "hello", false));
+  push(make_frame(rfc6455::continuation_frame, " ", false));
+  check_eq(app->chunks, std::vector{"hello"s, " "s});
+  check_eq(app->finals, std::vector{false, false});
+  push(make_frame(rfc6455::continuation_frame, "world"));
+  check_eq(app->chunks, std::vector{"hello"s, " "s, "world"s});
+  check_eq(app->finals, std::vector{false, false, true});
+  check(app->messages.empty());
+  SECTION("an empty frame may terminate the message") {
+    push(make_frame(rfc6455::binary_frame, "foo", false));
+    push(make_frame(rfc6455::continuation_frame, ""));
+    check_eq(app->chunks, std::vector{"hello"s, " "s, "world"s, "foo"s, ""s});
+    check_eq(app->finals, std::vector{false, false, true, false, true});
+  }
+}
+
+TEST("upper layers that consume chunks receive partial frames") {
+  init(true);
+  auto frame = make_frame(rfc6455::binary_frame, "0123456789");
+  // The masked header has 6 bytes.
+  auto bytes = make_span(frame);
+  push(byte_buffer{bytes.begin(), bytes.begin() + 9});
+  check_eq(app->chunks, std::vector{"012"s});
+  check_eq(app->finals, std::vector{false});
+  push(byte_buffer{bytes.begin() + 9, bytes.begin() + 14});
+  check_eq(app->chunks, std::vector{"012"s, "34567"s});
+  check_eq(app->finals, std::vector{false, false});
+  push(byte_buffer{bytes.begin() + 14, bytes.end()});
+  check_eq(app->chunks, std::vector{"012"s, "34567"s, "89"s});
+  check_eq(app->finals, std::vector{false, false, true});
+  check(!app->err);
+}
+
+TEST("text chunks never split UTF-8 code points") {
+  init(true);
+  // "\xc3\xa4" is a two-byte and "\xe2\x82\xac" is a three-byte code point.
+  SECTION("code points may span two reads") {
+    auto frame = make_frame(rfc6455::text_frame, "a\xc3\xa4\xe2\x82\xac");
+    auto bytes = make_span(frame);
+    push(byte_buffer{bytes.begin(), bytes.begin() + 8});
+    check_eq(app->chunks, std::vector{"a"s});
+    push(byte_buffer{bytes.begin() + 8, bytes.begin() + 11});
+    check_eq(app->chunks, std::vector{"a"s, "\xc3\xa4"s});
+    push(byte_buffer{bytes.begin() + 11, bytes.end()});
+    check_eq(app->chunks, std::vector{"a"s, "\xc3\xa4"s, "\xe2\x82\xac"s});
+    check_eq(app->finals, std::vector{false, false, true});
+  }
+  SECTION("code points may span two frames") {
+    push(make_frame(rfc6455::text_frame, "a\xe2", false));
+    push(make_frame(rfc6455::continuation_frame, "\x82", false));
+    push(make_frame(rfc6455::continuation_frame, "\xac!"));
+    check_eq(app->chunks, std::vector{"a"s, "\xe2\x82\xac"s, "!"s});
+    check_eq(app->finals, std::vector{false, false, true});
+  }
+  check(!app->err);
+}
+
+TEST("upper layers that consume chunks reject invalid UTF-8") {
+  init(true);
+  SECTION("invalid bytes") {
+    push(make_frame(rfc6455::text_frame, "a\xff"));
+  }
+  SECTION("incomplete code points at the end of a message") {
+    push(make_frame(rfc6455::text_frame, "a\xe2", false));
+    push(make_frame(rfc6455::continuation_frame, "\x82"));
+  }
+  check(transport.closed);
+  check_eq(app->err, sec::malformed_message);
+}
+
+TEST("upper layers that consume messages receive reassembled fragments") {
+  init(false);
+  push(make_frame(rfc6455::text_frame, "hello", false));
+  push(make_frame(rfc6455::continuation_frame, " world"));
+  check_eq(app->messages, std::vector{"hello world"s});
+  check(app->chunks.empty());
+}
+
+#ifdef CAF_ENABLE_ZLIB
+
+TEST("compressed messages may not exceed the maximum compressed size") {
+  net::web_socket::deflate_config cfg;
+  cfg.max_message_size = 1024;
+  init(cfg);
+  auto limit = detail::rfc7692::max_compressed_size(cfg.max_message_size);
+  auto compressed_flags = rfc6455::fin_flag | rfc6455::rsv1_flag;
+  auto check_rejected = [this] {
+    check(transport.closed);
+    check_eq(app->err, sec::protocol_error);
+    // The server responds with a close frame with status code 1009, i.e.,
+    // message too big.
+    require_ge(transport.output.size(), 4u);
+    check_eq(transport.output[0], std::byte{0x88});
+    check_eq(transport.output[2], std::byte{0x03});
+    check_eq(transport.output[3], std::byte{0xF1});
+  };
+  SECTION("a small compressed message passes") {
+    detail::rfc7692::codec client;
+    require(client.init(detail::rfc7692::parameters{}, false, cfg));
+    byte_buffer compressed;
+    require(client.compress(byte_buffer(1024, std::byte{'a'}), compressed));
+    push(make_frame(rfc6455::binary_frame, std::move(compressed),
+                    compressed_flags));
+    check(!transport.closed);
+    check_eq(app->messages, std::vector{std::string(1024, 'a')});
+  }
+  SECTION("a single frame above the limit fails") {
+    push(make_frame(rfc6455::binary_frame, byte_buffer(limit + 1),
+                    compressed_flags));
+    check_rejected();
+  }
+  SECTION("several frames above the limit fail") {
+    push(make_frame(rfc6455::binary_frame, byte_buffer(limit / 2),
+                    rfc6455::rsv1_flag));
+    check(!transport.closed);
+    push(make_frame(rfc6455::continuation_frame, byte_buffer(limit / 2 + 2),
+                    rfc6455::fin_flag));
+    check_rejected();
+  }
+}
+
+#endif // CAF_ENABLE_ZLIB
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
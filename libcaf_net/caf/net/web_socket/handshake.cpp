@@ -119,7 +119,11 @@ void handshake::write_http_1_response(byte_buffer& buf) const {
          "Upgrade: websocket\r\n"
          "Connection: Upgrade\r\n"
          "Sec-WebSocket-Accept: "
-      << response_key() << "\r\n\r\n";
+      << response_key() << "\r\n";
+  for (auto& [key, val] : fields_)
+    if (key[0] != '_')
+      out << key << ": " << val << "\r\n";
+  out << "\r\n";
 }
 
 void handshake::write_response(http::lower_layer::server* down) const {
@@ -127,6 +131,9 @@ void handshake::write_response(http::lower_layer::server* down) const {
   down->add_header_field("Upgrade", "websocket");
   down->add_header_field("Connection", "Upgrade");
   down->add_header_field("Sec-WebSocket-Accept", response_key());
+  for (auto& [key, val] : fields_)
+    if (key[0] != '_')
+      down->add_header_field(key, val);
   down->end_header();
   down->send_payload({});
 }
@@ -134,11 +134,13 @@ public:
   /// @pre `has_mandatory_fields()`
   void write_http_1_request(byte_buffer& buf) const;
 
-  /// Writes the HTTP 1.1 response message to `buf`.
+  /// Writes the HTTP 1.1 response message to `buf`, including all configured
+  /// header fields such as `Sec-WebSocket-Extensions`.
   /// @pre `has_valid_key()`
   void write_http_1_response(byte_buffer& buf) const;
 
-  /// Writes the HTTP response message to `down`.
+  /// Writes the HTTP response message to `down`, including all configured
+  /// header fields.
   /// @pre `has_valid_key()`
   void write_response(http::lower_layer::server* down) const;
 
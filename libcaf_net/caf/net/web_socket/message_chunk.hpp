@@ -0,0 +1,79 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/main/LICENSE.
+
+#pragma once
+
+#include "caf/net/web_socket/frame.hpp"
+
+#include "caf/byte_span.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace caf::net::web_socket {
+
+/// A piece of a WebSocket message for applications that consume messages in
+/// chunks. Each chunk knows whether it belongs to a text or a binary message.
+/// The last chunk of a message has the final flag set and may be empty.
+class message_chunk {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  message_chunk() = default;
+
+  message_chunk(frame payload, bool is_final) noexcept
+    : payload_(std::move(payload)), final_(is_final) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the payload of this chunk.
+  [[nodiscard]] const frame& payload() const noexcept {
+    return payload_;
+  }
+
+  /// Returns the number of bytes stored in this chunk.
+  [[nodiscard]] size_t size() const noexcept {
+    return payload_.size();
+  }
+
+  /// Returns whether `size() == 0`.
+  [[nodiscard]] bool empty() const noexcept {
+    return payload_.empty();
+  }
+
+  /// Checks whether this chunk belongs to a binary message.
+  [[nodiscard]] bool is_binary() const noexcept {
+    return payload_.is_binary();
+  }
+
+  /// Checks whether this chunk belongs to a text message.
+  [[nodiscard]] bool is_text() const noexcept {
+    return payload_.is_text();
+  }
+
+  /// Checks whether this chunk is the last chunk of its message.
+  [[nodiscard]] bool is_final() const noexcept {
+    return final_;
+  }
+
+  // -- conversions ------------------------------------------------------------
+
+  /// Returns the bytes stored in this chunk.
+  [[nodiscard]] const_byte_span as_binary() const noexcept {
+    return payload_.as_binary();
+  }
+
+  /// Returns the characters stored in this chunk.
+  [[nodiscard]] std::string_view as_text() const noexcept {
+    return payload_.as_text();
+  }
+
+private:
+  frame payload_;
+  bool final_ = false;
+};
+
+} // namespace caf::net::web_socket
@@ -11,15 +11,19 @@
 #include "caf/net/http/v1.hpp"
 #include "caf/net/octet_stream/lower_layer.hpp"
 #include "caf/net/receive_policy.hpp"
+#include "caf/net/web_socket/deflate_config.hpp"
 #include "caf/net/web_socket/framing.hpp"
 #include "caf/net/web_socket/handshake.hpp"
 #include "caf/net/web_socket/upper_layer.hpp"
 
 #include "caf/byte_span.hpp"
 #include "caf/detail/net_export.hpp"
+#include "caf/detail/rfc7692.hpp"
 #include "caf/error.hpp"
 #include "caf/log/net.hpp"
 
+#include <optional>
+
 namespace caf::net::web_socket {
 
 namespace {
@@ -32,6 +36,9 @@ public:
     // nop
   }
 
+  /// Enables the permessage-deflate extension when set.
+  std::optional<deflate_config> deflate_cfg;
+
   // -- octet_stream::upper_layer implementation -------------------------------
 
   error start(octet_stream::lower_layer* down) override {
@@ -91,7 +98,7 @@ private:
     using namespace std::literals;
     // Parse the header and reject invalid inputs.
     http::request_header hdr;
-    auto [code, msg] = hdr.parse(http);
+    auto [code, msg] = hdr.parse_in_place(http);
     if (code != http::status::ok) {
       write_response(code, msg);
       return false;
@@ -117,12 +124,24 @@ private:
     // Finalize the WebSocket handshake.
     handshake hs;
     hs.assign_key(sec_key);
+    std::optional<detail::rfc7692::parameters> deflate_params;
+    if (deflate_cfg) {
+      std::string response;
+      deflate_params = detail::rfc7692::accept_offer(
+        hdr.field("Sec-WebSocket-Extensions"), *deflate_cfg, response);
+      if (deflate_params)
+        hs.extensions(std::move(response));
+    }
     down_->begin_output();
     hs.write_http_1_response(down_->output_buffer());
     down_->end_output();
     // All done. Switch to the framing protocol.
     log::net::debug("completed WebSocket handshake");
-    down_->switch_protocol(framing::make_server(std::move(up_)));
+    if (deflate_params)
+      down_->switch_protocol(
+        framing::make_server(std::move(up_), *deflate_params, *deflate_cfg));
+    else
+      down_->switch_protocol(framing::make_server(std::move(up_)));
     return true;
   }
 
@@ -141,6 +160,13 @@ std::unique_ptr<server> server::make(upper_layer_ptr up) {
   return std::make_unique<server_impl>(std::move(up));
 }
 
+std::unique_ptr<server> server::make(upper_layer_ptr up,
+                                     const deflate_config& cfg) {
+  auto res = std::make_unique<server_impl>(std::move(up));
+  res->deflate_cfg = cfg;
+  return res;
+}
+
 // -- constructors, destructors, and assignment operators --------------------
 
 server::~server() {
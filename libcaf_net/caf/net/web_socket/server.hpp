@@ -29,6 +29,11 @@ public:
   // -- factories --------------------------------------------------------------
 
   static std::unique_ptr<server> make(upper_layer_ptr up);
+
+  /// Creates a server that accepts offers for the permessage-deflate
+  /// extension from clients.
+  static std::unique_ptr<server> make(upper_layer_ptr up,
+                                      const deflate_config& cfg);
 };
 
 } // namespace caf::net::web_socket
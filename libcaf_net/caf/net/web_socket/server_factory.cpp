@@ -19,6 +19,7 @@
 #include "caf/internal/ws_flow_bridge.hpp"
 
 #include <cstdint>
+#include <optional>
 
 namespace caf::net::web_socket {
 
@@ -28,10 +29,12 @@ template <class Acceptor>
 class connection_acceptor_impl : public detail::connection_acceptor {
 public:
   connection_acceptor_impl(Acceptor acceptor, detail::ws_conn_acceptor_ptr wca,
-                           size_t max_consecutive_reads)
+                           size_t max_consecutive_reads,
+                           std::optional<deflate_config> deflate_cfg)
     : acceptor_(std::move(acceptor)),
       wca_(std::move(wca)),
-      max_consecutive_reads_(max_consecutive_reads) {
+      max_consecutive_reads_(max_consecutive_reads),
+      deflate_cfg_(std::move(deflate_cfg)) {
     // nop
   }
 
@@ -54,7 +57,8 @@ public:
       return conn.error();
     }
     auto app = internal::make_ws_flow_bridge(wca_);
-    auto ws = net::web_socket::server::make(std::move(app));
+    auto ws = deflate_cfg_ ? server::make(std::move(app), *deflate_cfg_)
+                           : server::make(std::move(app));
     auto transport = internal::make_transport(std::move(*conn), std::move(ws));
     transport->max_consecutive_reads(max_consecutive_reads_);
     transport->active_policy().accept();
@@ -70,13 +74,15 @@ private:
   net::socket_manager* parent_ = nullptr;
   detail::ws_conn_acceptor_ptr wca_;
   size_t max_consecutive_reads_;
+  std::optional<deflate_config> deflate_cfg_;
 };
 
 template <class Config, class Acceptor>
 expected<disposable> do_start_impl(Config& cfg, Acceptor acc) {
   using impl_t = connection_acceptor_impl<Acceptor>;
   auto conn_acc = std::make_unique<impl_t>(std::move(acc), cfg.wca,
-                                           cfg.max_consecutive_reads);
+                                           cfg.max_consecutive_reads,
+                                           cfg.deflate_cfg);
   auto handler = internal::make_accept_handler(std::move(conn_acc),
                                                cfg.max_connections);
   auto ptr = net::socket_manager::make(cfg.mpx, std::move(handler));
@@ -94,6 +100,8 @@ public:
   using super::super;
 
   detail::ws_conn_acceptor_ptr wca;
+
+  std::optional<deflate_config> deflate_cfg;
 };
 
 server_factory_base::server_factory_base(config_impl* config,
@@ -131,6 +139,10 @@ void server_factory_base::release(config_impl* ptr) {
   ptr->deref();
 }
 
+void server_factory_base::do_permessage_deflate(const deflate_config& cfg) {
+  config_->deflate_cfg = cfg;
+}
+
 expected<disposable>
 server_factory_base::do_start(dsl::server_config::socket& data) {
   return checked_socket(data.take_fd())
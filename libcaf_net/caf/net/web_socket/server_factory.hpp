@@ -8,6 +8,7 @@
 #include "caf/net/dsl/server_factory_base.hpp"
 #include "caf/net/ssl/transport.hpp"
 #include "caf/net/web_socket/acceptor.hpp"
+#include "caf/net/web_socket/deflate_config.hpp"
 
 #include "caf/async/spsc_buffer.hpp"
 #include "caf/detail/connection_factory.hpp"
@@ -41,6 +42,8 @@ protected:
 
   static void release(config_impl* ptr);
 
+  void do_permessage_deflate(const deflate_config& cfg);
+
   expected<disposable> do_start(dsl::server_config::socket& data);
 
   expected<disposable> do_start(dsl::server_config::lazy& data);
@@ -76,6 +79,13 @@ public:
 
   server_factory& operator=(const server_factory&) = delete;
 
+  /// Accepts offers for the permessage-deflate extension (cf. RFC 7692) from
+  /// clients for compressing messages.
+  server_factory&& permessage_deflate(const deflate_config& cfg = {}) && {
+    this->do_permessage_deflate(cfg);
+    return std::move(*this);
+  }
+
   /// Starts a server that accepts incoming connections with the WebSocket
   /// protocol.
   template <class OnStart>
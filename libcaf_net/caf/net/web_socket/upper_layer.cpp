@@ -10,6 +10,18 @@ upper_layer::~upper_layer() {
   // nop
 }
 
+bool upper_layer::consumes_chunks() const noexcept {
+  return false;
+}
+
+ptrdiff_t upper_layer::consume_binary_chunk(byte_span, bool) {
+  return -1;
+}
+
+ptrdiff_t upper_layer::consume_text_chunk(std::string_view, bool) {
+  return -1;
+}
+
 upper_layer::server::~server() {
   // nop
 }
@@ -27,6 +27,24 @@ public:
 
   virtual ptrdiff_t consume_text(std::string_view buf) = 0;
 
+  /// Queries whether this layer consumes messages in chunks as they arrive.
+  /// If `true`, the lower layer calls `consume_binary_chunk` and
+  /// `consume_text_chunk` instead of reassembling fragmented messages before
+  /// calling `consume_binary` and `consume_text`. The default implementation
+  /// returns `false`.
+  virtual bool consumes_chunks() const noexcept;
+
+  /// Consumes the next chunk of a binary message. The lower layer sets `final`
+  /// on the last chunk of each message. The last chunk may be empty.
+  /// @note The default implementation returns -1.
+  virtual ptrdiff_t consume_binary_chunk(byte_span buf, bool final);
+
+  /// Consumes the next chunk of a text message. The lower layer sets `final`
+  /// on the last chunk of each message. The last chunk may be empty. Chunks
+  /// never split a UTF-8 code point.
+  /// @note The default implementation returns -1.
+  virtual ptrdiff_t consume_text_chunk(std::string_view buf, bool final);
+
   virtual error start(lower_layer* down) = 0;
 };
 